@@ -25,6 +25,7 @@
 #include <src/Scene/Scene.h>
 #include <src/Scene/Entity.h>
 #include <src/Scene/Components.h>
+#include <src/Scene/Prefab.h>
 #include <src/Scene/Script.h>
 
 #include <src/Orbital/OrbitalPhysics.h>
@@ -43,6 +44,8 @@
 #include <src/Renderer/Shader.h>
 #include <src/Renderer/SubTexture.h>
 #include <src/Renderer/Texture.h>
+#include <src/Renderer/TextureAtlas.h>
+#include <src/Renderer/TextureLibrary.h>
 #include <src/Renderer/VertexArray.h>
 // ---------------------
 
@@ -5,6 +5,7 @@
 
 #include <Renderer/Renderer.h>
 #include <Renderer/Renderer2D.h>
+#include <Renderer/TextureLibrary.h>
 #include <Scripting/ScriptEngine.h>
 
 
@@ -30,6 +31,7 @@ namespace Limnova
         // TODO - build definition to select renderer ??? or leave initialisation up to user application ??
         Renderer::Init();
         Renderer2D::Init();
+        TextureLibrary::Init();
         ScriptEngine::Initialize();
 
         m_ImGuiLayer = new ImGuiLayer();
@@ -43,6 +45,7 @@ namespace Limnova
         LV_PROFILE_FUNCTION();
 
         ScriptEngine::Shutdown();
+        TextureLibrary::Shutdown();
         Renderer2D::Shutdown();
         Renderer::Shutdown();
     }
@@ -84,6 +87,8 @@ namespace Limnova
             }
             m_Time = newTime;
 
+            TextureLibrary::Update();
+
             // Update layers
             if (!m_Minimized)
             {
@@ -3,6 +3,8 @@
 #include <Math/Math.h>
 #include <Core/Timestep.h>
 
+#include <span>
+
 
 namespace Limnova
 {
@@ -20,6 +22,20 @@ namespace Limnova
         static constexpr double kGravitational = 6.6743e-11;
 
 
+        // Precision policy ////////////////////
+        /* Scalar type of State::Position, selected at compile time with LV_ORBITAL_DOUBLE_PRECISION.
+         * Single precision requires small integration steps of dynamic objects to be accumulated (see Dynamics::DeltaPosition and kMaxPositionStep)
+         * until they are large enough to be represented in the stored position; double precision applies every step directly. */
+#ifdef LV_ORBITAL_DOUBLE_PRECISION
+        using TPositionScalar = double;
+#else
+        using TPositionScalar = float;
+#endif
+        using TPosition = TVector3<TPositionScalar>;
+        static constexpr bool kDoublePrecisionPosition = ::std::is_same_v<TPositionScalar, double>;
+        ////////////////////////////////////////
+
+
         // Simulation tuning parameters ////////
         // TODO : choose numbers based on reasoning/testing
         static constexpr float kDefaultLSpaceRadius = 0.1f;
@@ -37,6 +53,7 @@ namespace Limnova
         static constexpr double kMaxPositionStepd = (double)kMaxPositionStep;
         static constexpr double kMaxVelocityStep = kMaxPositionStepd / 10.0;
         static constexpr double kMinUpdateTrueAnomaly = ::std::numeric_limits<double>::epsilon() * 1e3f; /* smallest delta true anomaly we can allow before precision error becomes unacceptable for long-term angular integration */
+        static constexpr uint32_t kMaxOrbitRecomputesPerFrame = 64; /* default limit on the number of stale orbits which GetOrbitBudgeted() may recompute between calls to ResetOrbitRecomputeBudget() */
         ////////////////////////////////////////
 
 
@@ -69,6 +86,14 @@ namespace Limnova
                 return GetEmpty();
             }
 
+            /// <summary> Reserves space for the given number of new items, in addition to the current items. </summary>
+            void Reserve(size_t numNew)
+            {
+                if (numNew > m_Empties.size()) {
+                    m_Items.reserve(m_Items.size() + numNew - m_Empties.size());
+                }
+            }
+
             T& Get(TId id)
             {
                 LV_CORE_ASSERT(Has(id), "Invalid ID!");
@@ -184,6 +209,12 @@ namespace Limnova
                 return nodeId;
             }
 
+            void Reserve(size_t numNew)
+            {
+                m_Nodes.Reserve(numNew);
+                m_Heights.reserve(m_Heights.size() + numNew);
+            }
+
             Node const& Get(TNodeId nodeId) const
             {
                 LV_CORE_ASSERT(Has(nodeId), "Invalid node ID!");
@@ -380,6 +411,12 @@ namespace Limnova
                 return m_NodeToAttr.contains(nodeId);
             }
 
+            void Reserve(size_t numNew)
+            {
+                m_Attributes.Reserve(numNew);
+                m_NodeToAttr.reserve(m_NodeToAttr.size() + numNew);
+            }
+
             TAttr& Add(TNodeId nodeId)
             {
                 LV_CORE_ASSERT(!Has(nodeId), "Node already has attribute!");
@@ -500,18 +537,39 @@ namespace Limnova
 
             // -------------------------------------------------------------------------------------------------------------------------
 
-            /// <summary> Computes or updates the Orbit and returns its first section. </summary>
+            /// <summary> Computes the Orbit if it does not exist or is stale (computed from an older State version) and returns its first section. </summary>
             OrbitalPhysics::OrbitSection const& GetOrbit(size_t maxSections = 1) const
             {
-                auto& state = m_Ctx->m_States[m_NodeId];
                 auto& motion = m_Ctx->m_Motions[m_NodeId];
-                if (motion.Orbit == IdNull) {
-                    motion.Orbit = NewOrbit(ParentLsp());
-                    ComputeOrbit(motion.Orbit, state.Position, state.Velocity, maxSections);
-                    motion.TrueAnomaly = Orbit().Elements.TrueAnomalyOf(state.Position.Normalized());
+                if (motion.Orbit == IdNull || Orbit().StateVersion != State().Version) {
+                    RecomputeOrbit(*this, maxSections);
                 }
-                else if (motion.Integration == Motion::Integration::Linear) {
-                    motion.TrueAnomaly = Orbit().Elements.TrueAnomalyOf(state.Position.Normalized());
+                else if (motion.NeedTrueAnomaly) {
+                    UpdateTrueAnomaly(*this);
+                }
+                return m_Ctx->m_OrbitSections[motion.Orbit];
+            }
+
+            /// <summary>
+            /// As GetOrbit(), but a stale Orbit is only recomputed if the context's orbit recompute budget is not yet spent - otherwise the last-computed section is returned.
+            /// Intended for per-frame consumers (e.g, rendering) which can tolerate orbits lagging the simulation by a few frames. An Orbit which does not yet exist,
+            /// or which was computed in a local space the object has since left, is always computed.
+            /// </summary>
+            OrbitalPhysics::OrbitSection const& GetOrbitBudgeted(size_t maxSections = 1) const
+            {
+                auto& motion = m_Ctx->m_Motions[m_NodeId];
+                if (motion.Orbit == IdNull || Orbit().LocalSpace != ParentLsp()) {
+                    RecomputeOrbit(*this, maxSections);
+                    if (m_Ctx->m_OrbitRecomputeBudget > 0) { m_Ctx->m_OrbitRecomputeBudget--; }
+                }
+                else if (Orbit().StateVersion != State().Version) {
+                    if (m_Ctx->m_OrbitRecomputeBudget > 0) {
+                        RecomputeOrbit(*this, maxSections);
+                        m_Ctx->m_OrbitRecomputeBudget--;
+                    }
+                }
+                else if (motion.NeedTrueAnomaly) {
+                    UpdateTrueAnomaly(*this);
                 }
                 return m_Ctx->m_OrbitSections[motion.Orbit];
             }
@@ -531,7 +589,7 @@ namespace Limnova
 
             Vector3 LocalPositionFromPrimary() const
             {
-                return m_Ctx->m_States[m_NodeId].Position +
+                return (Vector3)m_Ctx->m_States[m_NodeId].Position +
                     LSpaceNode(m_Ctx->m_Tree[m_NodeId].Parent).LocalOffsetFromPrimary();
             }
 
@@ -591,7 +649,7 @@ namespace Limnova
             {
                 LV_ASSERT(!IsNull() && !IsRoot(), "Cannot set position of root or null object!");
 
-                m_Ctx->m_States[m_NodeId].Position = position;
+                m_Ctx->m_States[m_NodeId].Position = (TPosition)position;
                 TryPrepareObject(*this);
                 TryPrepareSubtree(*this);
             }
@@ -616,7 +674,7 @@ namespace Limnova
             Vector3d CircularOrbitVelocity() const
             {
                 return OrbitalPhysics::CircularOrbitVelocity(
-                    LSpaceNode{ m_Ctx->m_Tree[m_NodeId].Parent }, m_Ctx->m_States[m_NodeId].Position);
+                    LSpaceNode{ m_Ctx->m_Tree[m_NodeId].Parent }, (Vector3)m_Ctx->m_States[m_NodeId].Position);
             }
 
             // -------------------------------------------------------------------------------------------------------------------------
@@ -647,12 +705,10 @@ namespace Limnova
                 LV_ASSERT(IsDynamic(), "Cannot set dynamic acceleration on non-dynamic objects!");
 
                 Dynamics().ContAcceleration = acceleration / ParentLsp().LSpace().MetersPerRadius;
+                State().Version++; /* any existing orbit was computed without the new acceleration */
                 if (acceleration.IsZero()) return;
 
-                auto& motion = Motion();
-                motion.Integration = Motion::Integration::Dynamic;
-                motion.PrevDT -= motion.UpdateTimer;
-                motion.UpdateTimer = 0.0;
+                BeginDynamicIntegration(*this);
             }
 
             // -------------------------------------------------------------------------------------------------------------------------
@@ -825,7 +881,7 @@ namespace Limnova
                 if (lspId == primaryLspId) return Vector3::Zero();
 
                 TNodeId lspParentObjId = m_Ctx->m_Tree[lspId].Parent;
-                return (m_Ctx->m_States[lspParentObjId].Position +
+                return ((Vector3)m_Ctx->m_States[lspParentObjId].Position +
                     LocalOffsetFromPrimary(m_Ctx->m_Tree[lspParentObjId].Parent, primaryLspId))
                     / m_Ctx->m_LSpaces[lspId].Radius;
             }
@@ -948,7 +1004,7 @@ namespace Limnova
                 nextHigherSpace.GetLocalObjects(childObjs);
                 bool nextHigherIsSibling = nextHigherSpace.m_NodeId == node.PrevSibling;
                 float radiusInPrev = lsp.Radius / nextHigherSpace.LSpace().Radius;
-                Vector3 const& lspPos = ParentObj().State().Position;
+                TPosition const& lspPos = ParentObj().State().Position;
                 for (auto objNode : childObjs)
                 {
                     if (objNode.m_NodeId == m_Ctx->m_Tree[m_NodeId].Parent) continue; /* skip parent object */
@@ -1026,9 +1082,15 @@ namespace Limnova
         struct State
         {
             double Mass = 0.0;
-            Vector3 Position = { 0.f };
+            TPosition Position = { 0.f };
             Vector3d Velocity = { 0.0 };
             Vector3d Acceleration = { 0.0 };
+
+            uint32_t GetVersion() const { return Version; }
+        private:
+            friend class OrbitalPhysics;
+
+            uint32_t Version = 0; /* Incremented whenever the state changes in a way which invalidates its orbit - orbit sections record the version they were computed from */
         };
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -1052,6 +1114,7 @@ namespace Limnova
             ObjectNode UpdateNext = {};
 
             TId Orbit = IdNull;
+            bool NeedTrueAnomaly = false; /* Position has moved along the orbit without updating TrueAnomaly (Linear and Dynamic integration) */
         };
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -1059,7 +1122,7 @@ namespace Limnova
         struct Dynamics
         {
             Vector3d ContAcceleration = { 0.0 }; /* Acceleration assumed to be constant between timesteps */
-            Vector3d DeltaPosition = { 0.0 };
+            Vector3d DeltaPosition = { 0.0 }; /* Integrated change in position not yet applied to State::Position (single-precision positions only) */
         };
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -1238,6 +1301,7 @@ namespace Limnova
             float TaEntry   = 0.f;      // True anomaly of orbit's point of entry into the local space (if the section escapes the local space, otherwise has value 0)
             float TaExit    = PI2f;     // True anomaly of orbit's point of escape from the local space (if the section escapes the local space, otherwise has value 2Pi)
             TId Next = NNull;           // Reference to next orbit section which will describe the object's motion after escaping this, or entering a new, local space (or NNull if neither of these events occur)
+            uint32_t StateVersion = 0;  // Version of the object's State from which this section was computed
 
         public:
             Vector3 LocalPositionAt(float trueAnomaly) const
@@ -1451,6 +1515,35 @@ namespace Limnova
 
         // -------------------------------------------------------------------------------------------------------------------------
 
+        /// <summary>
+        /// Recomputes the object's Orbit from its current State, reusing the existing orbit sections if they are still in the object's local space.
+        /// </summary>
+        static void RecomputeOrbit(ObjectNode objNode, size_t maxSections = 1)
+        {
+            auto& state = objNode.State();
+            auto& motion = objNode.Motion();
+            if (motion.Orbit != IdNull && m_Ctx->m_OrbitSections.Get(motion.Orbit).LocalSpace != objNode.ParentLsp()) {
+                DeleteOrbit(motion.Orbit); /* object has changed local space since the orbit was computed */
+            }
+            if (motion.Orbit == IdNull) {
+                motion.Orbit = NewOrbit(objNode.ParentLsp());
+            }
+            ComputeOrbit(motion.Orbit, (Vector3)state.Position, state.Velocity, maxSections);
+            m_Ctx->m_OrbitSections.Get(motion.Orbit).StateVersion = state.Version;
+            UpdateTrueAnomaly(objNode);
+        }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+
+        static void UpdateTrueAnomaly(ObjectNode objNode)
+        {
+            auto& motion = objNode.Motion();
+            motion.TrueAnomaly = m_Ctx->m_OrbitSections.Get(motion.Orbit).Elements.TrueAnomalyOf((Vector3)objNode.State().Position.Normalized());
+            motion.NeedTrueAnomaly = false;
+        }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+
         static void ComputeOrbit(TId firstSectionId, Vector3 const& localPosition, Vector3d const& localVelocity, size_t maxSections = 1)
         {
             TId sectionId = firstSectionId;
@@ -1629,6 +1722,8 @@ namespace Limnova
             AttributeStorage<LocalSpace> m_LSpaces;
 
             ObjectNode m_UpdateQueueFront = {};
+            std::vector<ObjectNode>* m_DeferredQueueInserts = nullptr; /* While set (by CreateMany()), prepared objects are collected here instead of being pushed to the queue front */
+            uint32_t m_OrbitRecomputeBudget = kMaxOrbitRecomputesPerFrame; /* Remaining number of stale orbits which GetOrbitBudgeted() may recompute */
         public:
             Context()
             {
@@ -1662,6 +1757,11 @@ namespace Limnova
         // -------------------------------------------------------------------------------------------------------------------------
 
         static void SetContext(Context* ctx) { m_Ctx = ctx; }
+
+        /// <summary>
+        /// Sets the number of stale orbits which may be recomputed by ObjectNode::GetOrbitBudgeted() until the next call to this function - call once per frame.
+        /// </summary>
+        static void ResetOrbitRecomputeBudget(uint32_t maxRecomputes = kMaxOrbitRecomputesPerFrame) { m_Ctx->m_OrbitRecomputeBudget = maxRecomputes; }
     private:
         inline static Context* m_Ctx = nullptr;
 
@@ -1857,11 +1957,72 @@ namespace Limnova
 
         // -------------------------------------------------------------------------------------------------------------------------
 
+        /// <summary>
+        /// Inserts the given objects into the update queue, keeping the queue sorted by update timer.
+        /// The objects must not already be in the queue. Sorts the given objects and merges them with the queue in O(n log n).
+        /// </summary>
+        static void UpdateQueueInsertMany(std::vector<ObjectNode>& objNodes)
+        {
+            std::stable_sort(objNodes.begin(), objNodes.end(), [](ObjectNode const& lhs, ObjectNode const& rhs) {
+                return lhs.Motion().UpdateTimer < rhs.Motion().UpdateTimer;
+            });
+
+            ObjectNode front = {}, back = {};
+            auto append = [&](ObjectNode objNode) {
+                if (back.IsNull()) { front = objNode; }
+                else { back.Motion().UpdateNext = objNode; }
+                back = objNode;
+            };
+
+            ObjectNode queueItem = m_Ctx->m_UpdateQueueFront;
+            size_t i = 0;
+            while (!queueItem.IsNull() || i < objNodes.size())
+            {
+                if (i < objNodes.size() &&
+                    (queueItem.IsNull() || objNodes[i].Motion().UpdateTimer < queueItem.Motion().UpdateTimer))
+                {
+                    append(objNodes[i++]);
+                }
+                else {
+                    ObjectNode queueNext = queueItem.Motion().UpdateNext;
+                    append(queueItem);
+                    queueItem = queueNext;
+                }
+            }
+            if (!back.IsNull()) {
+                back.Motion().UpdateNext = ObjectNode::NNull();
+            }
+            m_Ctx->m_UpdateQueueFront = front;
+        }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+
         static Validity TryPrepareObject(ObjectNode objNode)
         {
             UpdateQueueSafeRemove(objNode);
 
+            Validity validity = PrepareObject(objNode);
+            if (!objNode.IsRoot() && validity == Validity::Valid) {
+                // All tests passed: object can safely be simulated
+                if (m_Ctx->m_DeferredQueueInserts) {
+                    m_Ctx->m_DeferredQueueInserts->push_back(objNode);
+                }
+                else {
+                    UpdateQueuePushFront(objNode);
+                }
+            }
+            return validity;
+        }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+
+        /// <summary>
+        /// Validates the object and prepares its Motion and Influence, without adding it to the update queue.
+        /// </summary>
+        static Validity PrepareObject(ObjectNode objNode)
+        {
             auto& obj = objNode.Object();
+            objNode.State().Version++; /* any existing orbit was computed from the state (or local space) before it was changed */
 
             obj.Validity = Validity::Valid;
             if (!ValidParent(objNode)) {
@@ -1889,10 +2050,6 @@ namespace Limnova
             if (!ValidMotion(objNode)) {
                 obj.Validity = Validity::InvalidMotion;
             }
-            else {
-                // All tests passed: object can safely be simulated
-                UpdateQueuePushFront(objNode);
-            }
             return obj.Validity;
         }
 
@@ -2061,6 +2218,19 @@ namespace Limnova
 
         // -------------------------------------------------------------------------------------------------------------------------
 
+        /// <summary>
+        /// Switches a continuously accelerating object to dynamic integration, restarting its update timer from the current state.
+        /// </summary>
+        static void BeginDynamicIntegration(ObjectNode objNode)
+        {
+            auto& motion = objNode.Motion();
+            motion.Integration = Motion::Integration::Dynamic;
+            motion.PrevDT -= motion.UpdateTimer;
+            motion.UpdateTimer = 0.0;
+        }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+
         static void ComputeMotion(ObjectNode objNode)
         {
             LV_CORE_ASSERT(!objNode.IsRoot(), "Root object cannot have Motion!");
@@ -2068,10 +2238,6 @@ namespace Limnova
             auto& state = objNode.State();
             auto& motion = objNode.Motion();
 
-            if (motion.Orbit != IdNull) {
-                DeleteOrbit(motion.Orbit);
-            }
-
             motion.PrevDT = ComputeObjDT(sqrt(state.Velocity.SqrMagnitude()));
 
             double approxDTrueAnomaly;
@@ -2096,7 +2262,7 @@ namespace Limnova
             {
                 // Angular integration
                 motion.Integration = Motion::Integration::Angular;
-                auto& orbit = objNode.GetOrbit(); /* creates Orbit */
+                auto& orbit = objNode.GetOrbit(); /* creates or recomputes Orbit */
                 motion.TrueAnomaly = orbit.Elements.TrueAnomalyOf((Vector3)posDir);
                 motion.DeltaTrueAnomaly = (motion.PrevDT * orbit.Elements.H) / posMag2;
                 break;
@@ -2136,6 +2302,8 @@ namespace Limnova
 
         static void OnUpdate(Timestep dT)
         {
+            LV_PROFILE_FUNCTION();
+
 #ifdef LV_DEBUG // debug pre-update
             /*std::chrono::steady_clock::time_point updateStart = std::chrono::steady_clock::now();
             static std::vector<std::chrono::steady_clock::time_point> timesOfLastPeriapsePassage = { };
@@ -2196,11 +2364,11 @@ namespace Limnova
                     float r = elems.P / (1.f + elems.E * cosT); /* orbit equation: r = h^2 / mu * 1 / (1 + e * cos(trueAnomaly)) */
 
                     /* state according to elements (local distance scaling, relative to primary) */
-                    state.Position = r * (cosT * elems.PerifocalX + sinT * elems.PerifocalY);
+                    state.Position = (TPosition)(r * (cosT * elems.PerifocalX + sinT * elems.PerifocalY));
                     state.Velocity = elems.VConstant * (Vector3d)((elems.E + cosT) * elems.PerifocalY - sinT * elems.PerifocalX);
                     /* state relative to local space */
                     LSpaceNode parentLspNode = updateNode.ParentLsp();
-                    state.Position -= parentLspNode.LocalOffsetFromPrimary();
+                    state.Position -= (TPosition)parentLspNode.LocalOffsetFromPrimary();
                     state.Velocity -= parentLspNode.LocalVelocityFromPrimary();
 
                     objDT = ComputeObjDT(sqrt(state.Velocity.SqrMagnitude()), minObjDT);
@@ -2230,8 +2398,8 @@ namespace Limnova
                     * a1 = (-rDirection) * G * M / r^2 + dynamicAcceleration
                     * v1 = v0 + 0.5 * (a0 + a1) * dT
                     * */
-                    state.Position += (Vector3)(state.Velocity * objDT) + 0.5f * (Vector3)(state.Acceleration * objDT * objDT);
-                    Vector3d positionFromPrimary = (Vector3d)updateNode.LocalPositionFromPrimary();
+                    state.Position += (TPosition)((state.Velocity * objDT) + (0.5 * state.Acceleration * objDT * objDT));
+                    Vector3d positionFromPrimary = (Vector3d)state.Position + (Vector3d)lspNode.LocalOffsetFromPrimary();
                     double r2 = positionFromPrimary.SqrMagnitude();
                     double r = sqrt(r2);
 
@@ -2246,10 +2414,12 @@ namespace Limnova
 
                     objDT = ComputeObjDT(sqrt(state.Velocity.SqrMagnitude()), minObjDT);
 
-                    if (isDynamicallyAccelerating && motion.Orbit != IdNull) {
-                        // Dynamic acceleration invalidates orbit:
-                        // Orbit was requested by the user in the previous frame so we need to delete the stored (now invalid) data
-                        DeleteOrbit(motion.Orbit); /* We do not compute the orbit of a linearly integrated object until it is requested */
+                    if (isDynamicallyAccelerating) {
+                        // Dynamic acceleration invalidates orbit: we do not recompute the orbit of a linearly integrated object until it is requested
+                        state.Version++;
+                    }
+                    else {
+                        motion.NeedTrueAnomaly = true;
                     }
 
                     // Re-select integration method
@@ -2269,15 +2439,20 @@ namespace Limnova
                 {
                     auto& dynamics = updateNode.Dynamics();
 
-                    if (motion.Orbit != IdNull) {
-                        // Dynamic acceleration invalidates orbit:
-                        // Orbit was requested by the user in the previous frame so we need to delete the stored (now invalid) data
-                        DeleteOrbit(motion.Orbit); /* We do not compute the orbit of a linearly integrated object until it is requested */
-                    }
+                    /* Every dynamic step invalidates the orbit - even with zero thrust, the velocity update still averages in the
+                     * acceleration of the previous step, which may include thrust. We do not recompute the orbit of a dynamically
+                     * integrated object until it is requested */
+                    state.Version++;
 
-                    dynamics.DeltaPosition += (state.Velocity * objDT) + (0.5 * state.Acceleration * objDT * objDT);
+                    Vector3d deltaPosition = (state.Velocity * objDT) + (0.5 * state.Acceleration * objDT * objDT);
+                    if constexpr (kDoublePrecisionPosition) {
+                        state.Position += (TPosition)deltaPosition; /* DeltaPosition remains zero */
+                    }
+                    else {
+                        dynamics.DeltaPosition += deltaPosition;
+                    }
 
-                    Vector3d positionFromPrimary = (Vector3d)updateNode.LocalPositionFromPrimary() + dynamics.DeltaPosition;
+                    Vector3d positionFromPrimary = (Vector3d)state.Position + (Vector3d)lspNode.LocalOffsetFromPrimary() + dynamics.DeltaPosition;
                     double r2 = positionFromPrimary.SqrMagnitude();
                     double r = sqrt(r2);
                     Vector3d newAcceleration = dynamics.ContAcceleration - (positionFromPrimary * lsp.Grav / (r2 * r));
@@ -2286,12 +2461,16 @@ namespace Limnova
                     state.Acceleration = newAcceleration;
 
                     static constexpr double kMaxUpdateDistanced2 = kMaxPositionStepd * kMaxPositionStepd;
-                    bool positionUpdated = false;
+                    bool positionUpdated = kDoublePrecisionPosition;
                     double deltaPosMag2 = dynamics.DeltaPosition.SqrMagnitude();
-                    if (deltaPosMag2 > kMaxUpdateDistanced2) {
-                        Vector3 dPosf = (Vector3)dynamics.DeltaPosition;
-                        state.Position += dPosf;
-                        dynamics.DeltaPosition -= (Vector3d)dPosf;
+                    if (positionUpdated) {
+                        motion.NeedTrueAnomaly = true;
+                    }
+                    else if (deltaPosMag2 > kMaxUpdateDistanced2) {
+                        TPosition dPos = (TPosition)dynamics.DeltaPosition;
+                        state.Position += dPos;
+                        dynamics.DeltaPosition -= (Vector3d)dPos;
+                        motion.NeedTrueAnomaly = true;
 
                         positionUpdated = true;
                     }
@@ -2456,7 +2635,7 @@ namespace Limnova
             ObjectNode newObjNode = NewObjectNode(lspNode);
             auto& state = newObjNode.State();
             state.Mass = mass;
-            state.Position = position;
+            state.Position = (TPosition)position;
             state.Velocity = velocity;
 
             if (dynamic) {
@@ -2484,6 +2663,134 @@ namespace Limnova
 
         // -------------------------------------------------------------------------------------------------------------------------
 
+        struct ObjectDesc
+        {
+            LSpaceNode LocalSpace = {};
+            int64_t Parent = -1;            /* index of an earlier description in the same batch - if set, LocalSpace is ignored and the object is created in that object's local space */
+            uint32_t ParentLocalSpace = 0;  /* index of the parent object's local space, in the order given by GetLocalSpaces() */
+            double Mass = 0.0;
+            Vector3 Position = { 0.f };
+            Vector3d Velocity = { 0.0 };
+            bool CircularOrbit = false; /* if true, Velocity is ignored and the object is given the velocity of a circular counter-clockwise orbit */
+            bool Dynamic = false;
+            Vector3d ContAcceleration = { 0.0 }; /* dynamic objects only - magnitude is absolute (not scaled to the local space) */
+            std::vector<float> LocalSpaceRadii; /* non-influencing local spaces added to the object once it is prepared */
+        };
+
+        /// <summary>
+        /// Create many orbital physics objects at once.
+        /// Objects are created one hierarchy level at a time, so that an object's parent (named by its batch index) is prepared and has all
+        /// of its local spaces before the object is inserted. Within a level, all objects are inserted before any are prepared; they are then
+        /// prepared ordered from the highest local spaces down and by descending mass within each local space (so that spheres of influence
+        /// exist before the objects they might contain are prepared). Valid objects - including existing objects re-prepared because a new
+        /// sphere of influence moved them - are merged into the update queue together, by update timer, once the whole batch is prepared.
+        /// </summary>
+        /// <param name="objNodes">Receives the created objects, in the same order as the given descriptions</param>
+        /// <returns>Number of objects created</returns>
+        static size_t CreateMany(std::span<ObjectDesc const> descs, std::vector<ObjectNode>& objNodes)
+        {
+            if (descs.empty()) return 0;
+
+            m_Ctx->m_Tree.Reserve(descs.size());
+            m_Ctx->m_Objects.Reserve(descs.size());
+            m_Ctx->m_States.Reserve(descs.size());
+            m_Ctx->m_Motions.Reserve(descs.size());
+
+            // Order by hierarchy level
+            std::vector<uint32_t> levels(descs.size(), 0);
+            uint32_t numLevels = 1;
+            for (size_t i = 0; i < descs.size(); i++) {
+                if (descs[i].Parent < 0) continue;
+                LV_CORE_ASSERT((size_t)descs[i].Parent < i, "An object's parent must precede it in the batch!");
+                levels[i] = levels[descs[i].Parent] + 1;
+                numLevels = std::max(numLevels, levels[i] + 1);
+            }
+
+            size_t firstNew = objNodes.size();
+            objNodes.resize(firstNew + descs.size());
+
+            std::vector<ObjectNode> toQueue;
+            toQueue.reserve(descs.size());
+            m_Ctx->m_DeferredQueueInserts = &toQueue;
+
+            std::vector<std::pair<ObjectNode, size_t>> levelNodes;
+            std::vector<LSpaceNode> parentLsps;
+            for (uint32_t level = 0; level < numLevels; level++)
+            {
+                // Insert the level's nodes
+                levelNodes.clear();
+                for (size_t i = 0; i < descs.size(); i++)
+                {
+                    if (levels[i] != level) continue;
+                    auto const& desc = descs[i];
+
+                    LSpaceNode lspNode = desc.LocalSpace;
+                    if (desc.Parent >= 0) {
+                        parentLsps.clear();
+                        objNodes[firstNew + desc.Parent].GetLocalSpaces(parentLsps);
+                        LV_CORE_ASSERT(desc.ParentLocalSpace < parentLsps.size(), "Invalid parent local space index!");
+                        lspNode = parentLsps[desc.ParentLocalSpace];
+                    }
+                    LV_CORE_ASSERT(!lspNode.IsNull(), "Invalid local space!");
+
+                    ObjectNode newObjNode = NewObjectNode(lspNode);
+                    auto& state = newObjNode.State();
+                    state.Mass = desc.Mass;
+                    state.Position = (TPosition)desc.Position;
+                    state.Velocity = desc.CircularOrbit ? CircularOrbitVelocity(lspNode, desc.Position) : desc.Velocity;
+
+                    if (desc.Dynamic) {
+                        m_Ctx->m_Dynamics.Add(newObjNode.m_NodeId).ContAcceleration = desc.ContAcceleration / lspNode.LSpace().MetersPerRadius;
+                    }
+                    objNodes[firstNew + i] = newObjNode;
+                    levelNodes.emplace_back(newObjNode, i);
+                }
+
+                // Prepare in topological order
+                std::stable_sort(levelNodes.begin(), levelNodes.end(), [](auto const& lhs, auto const& rhs) {
+                    int lhsHeight = lhs.first.Height(), rhsHeight = rhs.first.Height();
+                    if (lhsHeight != rhsHeight) return lhsHeight < rhsHeight;
+                    return lhs.first.State().Mass > rhs.first.State().Mass;
+                });
+                for (auto [objNode, descIndex] : levelNodes) {
+                    if (PrepareObject(objNode) == Validity::Valid) {
+                        toQueue.push_back(objNode);
+                    }
+                }
+
+                // Add local spaces for the next level's objects
+                for (auto [objNode, descIndex] : levelNodes) {
+                    for (float radius : descs[descIndex].LocalSpaceRadii) {
+                        objNode.AddLocalSpace(radius);
+                    }
+                }
+            }
+
+            m_Ctx->m_DeferredQueueInserts = nullptr;
+
+            /* Objects may have been deferred more than once, or invalidated after they were deferred. None are in the queue:
+             * TryPrepareObject() removes an object before preparing it, and new objects were never queued */
+            std::sort(toQueue.begin(), toQueue.end(), [](ObjectNode const& lhs, ObjectNode const& rhs) { return lhs.m_NodeId < rhs.m_NodeId; });
+            toQueue.erase(std::unique(toQueue.begin(), toQueue.end()), toQueue.end());
+            std::erase_if(toQueue, [](ObjectNode const& objNode) { return objNode.Object().Validity != Validity::Valid; });
+
+            /* ComputeMotion() only selects angular or linear integration: thrusting objects are switched as SetContinuousAcceleration() would,
+             * after the whole batch is prepared (re-preparing an object resets its integration) and before queueing (which orders by timer) */
+            for (auto it = objNodes.begin() + firstNew; it != objNodes.end(); ++it) {
+                if (it->Object().Validity == Validity::Valid && it->IsDynamic() && !it->Dynamics().ContAcceleration.IsZero()) {
+                    BeginDynamicIntegration(*it);
+                }
+            }
+            UpdateQueueInsertMany(toQueue);
+
+            size_t numValid = std::count_if(objNodes.begin() + firstNew, objNodes.end(),
+                [](ObjectNode const& objNode) { return objNode.Object().Validity == Validity::Valid; });
+            LV_INFO("Created {0} OrbitalPhysics objects ({1} valid)", descs.size(), numValid);
+            return descs.size();
+        }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+
         /// <summary>
         /// Create an uninitialised orbital physics object in the specified orbital space.
         /// </summary>
@@ -2658,7 +2965,7 @@ namespace Limnova
                 fromLspLocalRadius /= fromObject.ParentLsp().LSpace().Radius;
                 fromObject = fromParent;
                 fromParent = fromObject.ParentObj();
-                localFromOffset += fromObject.State().Position * fromLspLocalRadius;
+                localFromOffset += (Vector3)fromObject.State().Position * fromLspLocalRadius;
 
                 heightDifference += 2;
             }
@@ -2667,7 +2974,7 @@ namespace Limnova
                 toLspNonlocalRadius /= toObject.ParentLsp().LSpace().Radius;
                 toObject = toParent;
                 toParent = toObject.ParentObj();
-                nonlocalToOffset += toObject.State().Position * toLspNonlocalRadius;
+                nonlocalToOffset += (Vector3)toObject.State().Position * toLspNonlocalRadius;
 
                 heightDifference -= 2;
             }
@@ -2677,12 +2984,12 @@ namespace Limnova
                 fromLspLocalRadius /= fromObject.ParentLsp().LSpace().Radius;
                 fromObject = fromParent;
                 fromParent = fromObject.ParentObj();
-                localFromOffset += fromObject.State().Position * fromLspLocalRadius;
+                localFromOffset += (Vector3)fromObject.State().Position * fromLspLocalRadius;
 
                 toLspNonlocalRadius /= toObject.ParentLsp().LSpace().Radius;
                 toObject = toParent;
                 toParent = toObject.ParentObj();
-                nonlocalToOffset += toObject.State().Position * toLspNonlocalRadius;
+                nonlocalToOffset += (Vector3)toObject.State().Position * toLspNonlocalRadius;
             }
 
             Vector3 localToOffset = nonlocalToOffset * fromToRadiusRatio;
@@ -2707,7 +3014,7 @@ namespace Limnova
                 fromLspLocalRadius /= fromLsp.LSpace().Radius;
 
                 ObjectNode fromLspParent = fromLsp.ParentObj();
-                localFromOffset += fromLspParent.State().Position * fromLspLocalRadius;
+                localFromOffset += (Vector3)fromLspParent.State().Position * fromLspLocalRadius;
 
                 fromLsp = fromLspParent.ParentLsp();
                 heightDifference += 2;
@@ -2717,7 +3024,7 @@ namespace Limnova
                 toLspNonlocalRadius /= toLsp.LSpace().Radius;
 
                 ObjectNode toLspParent = toLsp.ParentObj();
-                nonlocalToOffset += toLspParent.State().Position * toLspNonlocalRadius;
+                nonlocalToOffset += (Vector3)toLspParent.State().Position * toLspNonlocalRadius;
 
                 toLsp = toLspParent.ParentLsp();
                 heightDifference -= 2;
@@ -2727,12 +3034,12 @@ namespace Limnova
             {
                 fromLspLocalRadius /= fromLsp.LSpace().Radius;
                 ObjectNode fromLspParent = fromLsp.ParentObj();
-                localFromOffset += fromLspParent.State().Position * fromLspLocalRadius;
+                localFromOffset += (Vector3)fromLspParent.State().Position * fromLspLocalRadius;
                 fromLsp = fromLspParent.ParentLsp();
 
                 toLspNonlocalRadius /= toLsp.LSpace().Radius;
                 ObjectNode toLspParent = toLsp.ParentObj();
-                nonlocalToOffset += toLspParent.State().Position * toLspNonlocalRadius;
+                nonlocalToOffset += (Vector3)toLspParent.State().Position * toLspNonlocalRadius;
                 toLsp = toLspParent.ParentLsp();
             }
 
@@ -2849,7 +3156,7 @@ namespace Limnova
             Vector3 targetPositionAtIntercept = ComputeLocalPosition(missileObject.ParentLsp(),
                 targetObject.ParentLsp(), targetOrbitElements.PositionAt(trueAnomalyAtIntercept));
 
-            Vector3 newSeparationVector = targetPositionAtIntercept - missileObject.GetState().Position;
+            Vector3 newSeparationVector = targetPositionAtIntercept - (Vector3)missileObject.GetState().Position;
 
             // Iteratively improve...
             float targetingDelta = sqrtf((newSeparationVector - separationVector).SqrMagnitude());
@@ -2886,7 +3193,7 @@ namespace Limnova
                 targetPositionAtIntercept = ComputeLocalPosition(missileObject.ParentLsp(),
                     targetObject.ParentLsp(), targetOrbitElements.PositionAt(trueAnomalyAtIntercept));
 
-                newSeparationVector = targetPositionAtIntercept - missileObject.GetState().Position;
+                newSeparationVector = targetPositionAtIntercept - (Vector3)missileObject.GetState().Position;
 
                 targetingDelta = sqrtf((newSeparationVector - separationVector).SqrMagnitude());
             }
@@ -2898,7 +3205,7 @@ namespace Limnova
         static void SolveMissileIntercept(ObjectNode missileObject, ObjectNode targetObject, double acceleration,
             float targetingTolerance, Vector3 &localIntercept, float &timeToIntercept, size_t maxIterations = 5)
         {
-            const Vector3 missilePosition = missileObject.GetState().Position;
+            const Vector3 missilePosition = (Vector3)missileObject.GetState().Position;
             const Vector3d missileVelocity = missileObject.GetState().Velocity;
             LSpaceNode missileLsp = missileObject.ParentLsp(), targetLsp = targetObject.ParentLsp();
             const Elements &targetOrbitElements = targetObject.GetOrbit().Elements;
@@ -2994,7 +3301,7 @@ namespace Limnova
         {
             SolveMissileIntercept(missileObject, targetObject, localAcceleration, targetingTolerance, interceptPosition, timeToIntercept, maxIterations);
 
-            Vector3 relativeIntercept = interceptPosition - missileObject.GetState().Position;
+            Vector3 relativeIntercept = interceptPosition - (Vector3)missileObject.GetState().Position;
 
             Vector3 proportionalNavigationAcceleration =
                 Vector3(ComputeProportionalNavigationAcceleration(missileObject, targetObject, static_cast<double>(proportionalityConstant)));
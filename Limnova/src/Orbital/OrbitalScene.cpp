@@ -3,11 +3,18 @@
 #include <Scene/Entity.h>
 #include <Scene/Components.h>
 #include <Renderer/Renderer2D.h>
+#include <Core/Timer.h>
+
+#include <execution>
+#include <numeric>
 
 
 namespace Limnova
 {
 
+    static constexpr size_t kMinParallelViewObjects = 256; /* View spaces with fewer objects than this are drawn on the calling thread */
+    static constexpr size_t kViewObjectsPerRenderChunk = 64; /* View objects drawn by each worker into one Renderer2D command buffer */
+
     OrbitalScene::OrbitalScene()
         : Scene()
     {
@@ -19,7 +26,7 @@ namespace Limnova
         auto& rootOc = AddComponent<OrbitalComponent>(m_Entities.at(m_Root));
         rootOc.Object = OrbitalPhysics::GetRootObjectNode();
         rootOc.LocalSpaces.push_back(OrbitalPhysics::GetRootLSpaceNode());
-        m_PhysicsToEnttIds.insert({ rootOc.Object.Id(), m_Entities.at(m_Root) });
+        MapPhysicsToEntity(rootOc.Object.Id(), m_Entities.at(m_Root));
 
         AddComponent<OrbitalHierarchyComponent>(m_Entities.at(m_Root)).LocalSpaceRelativeToParent = -1;
 
@@ -37,6 +44,9 @@ namespace Limnova
         m_Registry.on_construct<OrbitalComponent>().connect<&OrbitalScene::OnOrbitalComponentConstruct>(this);
         m_Registry.on_destroy<OrbitalComponent>().connect<&OrbitalScene::OnOrbitalComponentDestruct>(this);
 
+        // Groups
+        OrbitalGroup();
+
         // Physics callbacks
         //m_PhysicsContext.m_LSpaceChangedCallback = [this](OrbitalPhysics::ObjectNode objNode) { this->OnParentLocalSpaceChange(objNode); };
     }
@@ -44,6 +54,8 @@ namespace Limnova
 
     Ref<OrbitalScene> OrbitalScene::Copy(Ref<OrbitalScene> scene)
     {
+        Timer timer;
+
         Ref<OrbitalScene> newScene = CreateRef<OrbitalScene>();
 
         // Copy base Scene
@@ -54,18 +66,15 @@ namespace Limnova
         newScene->PhysicsUseContext();
         //newScene->m_PhysicsContext.m_LSpaceChangedCallback = [newScene](OrbitalPhysics::ObjectNode objNode) { newScene->OnParentLocalSpaceChange(objNode); };
 
-        newScene->CopyAllOfComponent<OrbitalHierarchyComponent>(scene->m_Registry);
+        newScene->CloneAllOfComponent<OrbitalHierarchyComponent>(scene->m_Registry);
 
         /* Suspend OrbitalComponent dependencies while copying, to avoid creating unnecessary physics objects */
         newScene->m_Registry.on_construct<OrbitalComponent>().disconnect<&OrbitalScene::OnOrbitalComponentConstruct>(newScene.get());
-        newScene->CopyAllOfComponent<OrbitalComponent>(scene->m_Registry);
+        newScene->CloneAllOfComponent<OrbitalComponent>(scene->m_Registry);
         newScene->m_Registry.on_construct<OrbitalComponent>().connect<&OrbitalScene::OnOrbitalComponentConstruct>(newScene.get());
 
-        // Repopulate m_PhysicsToEnttIds (entt IDs are not persistent across Scene::Copy())
-        newScene->m_PhysicsToEnttIds.clear();
-        newScene->m_Registry.view<OrbitalComponent>().each([&](auto entity, auto& oc) {
-            newScene->m_PhysicsToEnttIds.insert({ oc.Object.Id(), entity});
-        });
+        /* Entity identifiers are preserved by Scene::Copy(), as are physics node IDs by the context copy */
+        newScene->m_PhysicsToEnttIds = scene->m_PhysicsToEnttIds;
 
         // Copy OrbitalScene settings
         newScene->m_LocalSpaceColor = scene->m_LocalSpaceColor;
@@ -75,6 +84,7 @@ namespace Limnova
         newScene->m_OrbitFade = scene->m_OrbitFade;
         newScene->m_OrbitAlpha = scene->m_OrbitAlpha;
         newScene->m_OrbitPointRadius = scene->m_OrbitPointRadius;
+        newScene->m_OrbitRecomputeBudget = scene->m_OrbitRecomputeBudget;
         newScene->m_ShowReferenceAxes = scene->m_ShowReferenceAxes;
         newScene->m_ReferenceAxisColor = scene->m_ReferenceAxisColor;
         newScene->m_ReferenceAxisLength = scene->m_ReferenceAxisLength;
@@ -82,6 +92,13 @@ namespace Limnova
         newScene->m_ReferenceAxisArrowSize = scene->m_ReferenceAxisArrowSize;
         newScene->m_PerifocalAxisThickness = scene->m_PerifocalAxisThickness;
         newScene->m_PerifocalAxisArrowSize = scene->m_PerifocalAxisArrowSize;
+        newScene->m_SuperiorLevels = scene->m_SuperiorLevels;
+        newScene->m_InferiorLevels = scene->m_InferiorLevels;
+        newScene->m_ImpostorRefreshFrames = scene->m_ImpostorRefreshFrames;
+        newScene->m_ImpostorRadius = scene->m_ImpostorRadius;
+        newScene->m_ImpostorMaxDistance = scene->m_ImpostorMaxDistance;
+        newScene->m_ImpostorAlpha = scene->m_ImpostorAlpha;
+        newScene->m_MinScreenSize = scene->m_MinScreenSize;
 
         newScene->m_TrackingEntity = scene->m_TrackingEntity;
         newScene->m_RelativeViewSpace = scene->m_RelativeViewSpace;
@@ -95,6 +112,7 @@ namespace Limnova
 
         scene->PhysicsUseContext(); // restore original physics context
 
+        LV_CORE_INFO("Orbital scene copy ({0} entities) took {1} ms", newScene->m_Entities.size(), timer.ElapsedMillis());
         return newScene;
     }
 
@@ -107,6 +125,73 @@ namespace Limnova
     }
 
 
+    std::vector<Entity> OrbitalScene::CreateEntities(size_t count, UUID prototype, UUID parent)
+    {
+        LV_CORE_ASSERT(prototype == UUID::Null || !HasComponent<OrbitalComponent>(m_Entities.at(prototype)),
+            "Orbital entities must be created with CreateOrbitalEntities()!");
+
+        std::vector<Entity> entities = Scene::CreateEntities(count, prototype, parent);
+
+        OrbitalHierarchyComponent ohc = prototype == UUID::Null ? OrbitalHierarchyComponent{} :
+            GetComponent<OrbitalHierarchyComponent>(m_Entities.at(prototype));
+        InsertOrbitalHierarchyComponents(entities, ohc);
+        return entities;
+    }
+
+
+    std::vector<Entity> OrbitalScene::InstantiatePrefab(const Ref<Prefab>& prefab, size_t count, UUID parent)
+    {
+        LV_CORE_ASSERT(!prefab->GetOrbital().has_value(), "Orbital prefabs must be instantiated with orbital entity descriptions!");
+
+        std::vector<Entity> entities = Scene::InstantiatePrefab(prefab, count, parent);
+        InsertOrbitalHierarchyComponents(entities, OrbitalHierarchyComponent{});
+        return entities;
+    }
+
+
+    std::vector<Entity> OrbitalScene::InstantiatePrefab(const Ref<Prefab>& prefab, std::span<OrbitalEntityDesc const> descs)
+    {
+        LV_PROFILE_FUNCTION();
+
+        LV_CORE_ASSERT(prefab->GetOrbital().has_value(), "Prefab has no orbital data!");
+        auto& orbital = prefab->GetOrbital().value();
+
+        std::vector<OrbitalEntityDesc> instanceDescs(descs.begin(), descs.end());
+        for (auto& desc : instanceDescs) {
+            if (desc.Name.empty()) desc.Name = prefab->GetName();
+            desc.Mass = orbital.Mass;
+            desc.Dynamic = orbital.Dynamic;
+            desc.LocalSpaceRadii = orbital.LocalSpaceRadii;
+        }
+        std::vector<Entity> entities = CreateOrbitalEntities(instanceDescs);
+
+        std::vector<entt::entity> instances;
+        instances.reserve(entities.size());
+        for (auto& entity : entities)
+        {
+            auto& oc = entity.GetComponent<OrbitalComponent>();
+            oc.UIColor = orbital.UIColor;
+            oc.Albedo = orbital.Albedo;
+            oc.ShowMajorMinorAxes = orbital.ShowMajorMinorAxes;
+            oc.ShowNormal = orbital.ShowNormal;
+            instances.push_back(entity.m_EnttId);
+        }
+        AttachPrefab(prefab, instances);
+        return entities;
+    }
+
+
+    void OrbitalScene::InsertOrbitalHierarchyComponents(const std::vector<Entity>& entities, const OrbitalHierarchyComponent& ohc)
+    {
+        std::vector<entt::entity> enttIds;
+        enttIds.reserve(entities.size());
+        for (auto& entity : entities) {
+            enttIds.push_back(entity.m_EnttId);
+        }
+        m_Registry.insert<OrbitalHierarchyComponent>(enttIds.begin(), enttIds.end(), ohc);
+    }
+
+
     Entity OrbitalScene::DuplicateEntity(Entity entity)
     {
         // Duplicate base Scene components
@@ -121,7 +206,7 @@ namespace Limnova
 
             dstOc.Object.SetDynamic(srcOc.Object.IsDynamic());
             dstOc.Object.SetMass(srcOc.Object.GetState().Mass);
-            dstOc.Object.SetPosition(srcOc.Object.GetState().Position);
+            dstOc.Object.SetPosition((Vector3)srcOc.Object.GetState().Position);
             dstOc.Object.SetVelocity(srcOc.Object.GetState().Velocity);
 
             for (auto srcLsp : srcOc.LocalSpaces) {
@@ -142,6 +227,84 @@ namespace Limnova
     }
 
 
+    std::vector<Entity> OrbitalScene::CreateOrbitalEntities(std::span<OrbitalEntityDesc const> descs)
+    {
+        LV_PROFILE_FUNCTION();
+
+        std::vector<Entity> entities;
+        entities.reserve(descs.size());
+        std::vector<OrbitalPhysics::ObjectDesc> objDescs;
+        objDescs.reserve(descs.size());
+
+        // Create entities without the per-entity OrbitalComponent hook (physics objects are created below)
+        m_Registry.on_construct<OrbitalComponent>().disconnect<&OrbitalScene::OnOrbitalComponentConstruct>(this);
+        for (auto const& desc : descs)
+        {
+            auto& objDesc = objDescs.emplace_back();
+
+            UUID parent;
+            if (desc.ParentIndex >= 0) {
+                LV_CORE_ASSERT((size_t)desc.ParentIndex < entities.size(), "An entity's parent must precede it in the batch!");
+                LV_CORE_ASSERT(desc.LocalSpaceRelativeToParent >= 0, "Invalid relative local space index!");
+                parent = entities[desc.ParentIndex].GetUUID();
+                objDesc.Parent = desc.ParentIndex;
+                objDesc.ParentLocalSpace = (uint32_t)desc.LocalSpaceRelativeToParent; /* resolved by OrbitalPhysics once the parent exists */
+            }
+            else {
+                parent = desc.Parent == UUID::Null ? m_Root : desc.Parent;
+                auto& parentOc = GetComponent<OrbitalComponent>(m_Entities.at(parent));
+                LV_CORE_ASSERT(desc.LocalSpaceRelativeToParent >= 0 && desc.LocalSpaceRelativeToParent < parentOc.LocalSpaces.size(),
+                    "Invalid relative local space index!");
+                objDesc.LocalSpace = parentOc.LocalSpaces[desc.LocalSpaceRelativeToParent];
+            }
+            objDesc.Mass = desc.Mass;
+            objDesc.Position = desc.Position;
+            objDesc.Velocity = desc.Velocity;
+            objDesc.CircularOrbit = desc.CircularOrbit;
+            objDesc.Dynamic = desc.Dynamic;
+            objDesc.ContAcceleration = desc.ContAcceleration;
+            objDesc.LocalSpaceRadii = desc.LocalSpaceRadii;
+
+            Entity entity = CreateEntityFromUUID(desc.Id == UUID::Null ? UUID() : desc.Id, desc.Name, parent);
+            entity.GetComponent<OrbitalHierarchyComponent>().LocalSpaceRelativeToParent = desc.LocalSpaceRelativeToParent;
+            entity.AddComponent<OrbitalComponent>();
+            entities.push_back(entity);
+        }
+        m_Registry.on_construct<OrbitalComponent>().connect<&OrbitalScene::OnOrbitalComponentConstruct>(this);
+
+        // Create physics objects, deferring local-space change hooks until every object has an entity
+        std::vector<OrbitalPhysics::ObjectNode> parentLSpaceChanged, childLSpacesChanged;
+        m_PhysicsContext.m_ParentLSpaceChangedCallback = [&](OrbitalPhysics::ObjectNode objNode) { parentLSpaceChanged.push_back(objNode); };
+        m_PhysicsContext.m_ChildLSpacesChangedCallback = [&](OrbitalPhysics::ObjectNode objNode) { childLSpacesChanged.push_back(objNode); };
+
+        std::vector<OrbitalPhysics::ObjectNode> objNodes;
+        OrbitalPhysics::CreateMany(objDescs, objNodes);
+
+        PhysicsUseContext(); /* restore callbacks */
+
+        for (size_t i = 0; i < entities.size(); i++) {
+            entities[i].GetComponent<OrbitalComponent>().Object = objNodes[i];
+            MapPhysicsToEntity(objNodes[i].Id(), entities[i].m_EnttId);
+            childLSpacesChanged.push_back(objNodes[i]); /* new objects' local spaces are always updated */
+        }
+
+        // Fire hooks once per affected object
+        std::unordered_set<OrbitalPhysics::TNodeId> fired;
+        for (auto objNode : childLSpacesChanged) {
+            if (fired.insert(objNode.Id()).second) {
+                OnChildLocalSpacesChange(objNode);
+            }
+        }
+        fired.clear();
+        for (auto objNode : parentLSpaceChanged) {
+            if (fired.insert(objNode.Id()).second) {
+                OnParentLocalSpaceChange(objNode);
+            }
+        }
+        return entities;
+    }
+
+
     void OrbitalScene::PhysicsUseContext()
     {
         OrbitalPhysics::SetContext(&m_PhysicsContext);
@@ -285,7 +448,7 @@ namespace Limnova
             std::vector<OrbitalPhysics::ObjectNode> objNodes;
             lsp.GetLocalObjects(objNodes);
             for (auto objNode : objNodes) {
-                secondaries.push_back({ m_PhysicsToEnttIds.at(objNode.Id()), this });
+                secondaries.push_back({ PhysicsToEntity(objNode.Id()), this });
             }
         }
         return secondaries;
@@ -320,7 +483,7 @@ namespace Limnova
 
     int OrbitalScene::GetLocalSpaceRelativeToParent(OrbitalPhysics::LSpaceNode lspNode)
     {
-        auto& oc = GetComponent<OrbitalComponent>(m_PhysicsToEnttIds.at(lspNode.ParentObj().Id()));
+        auto& oc = GetComponent<OrbitalComponent>(PhysicsToEntity(lspNode.ParentObj().Id()));
         for (int i = 0; i < oc.LocalSpaces.size(); i++) {
             if (oc.LocalSpaces[i] == lspNode) return i;
         }
@@ -355,41 +518,259 @@ namespace Limnova
 
     void OrbitalScene::UpdateOrbitalScene()
     {
-        auto tcView = m_Registry.view<OrbitalComponent>();
-        for (auto entity : tcView) {
-            auto& tc = m_Registry.get<TransformComponent>(entity);
+        /* Orbital entities are placed directly in the view space, independent of their parents' transforms */
+        auto orbitalGroup = OrbitalGroup();
+        for (auto entity : orbitalGroup) {
+            auto& tc = orbitalGroup.get<TransformComponent>(entity);
+            tc.SetInheritParent(false);
             tc.SetScale({ 0.f });
         }
 
-        Vector3 viewSpaceOffset = -m_ViewObject.GetState().Position;
+        ExtractViewSpace();
+
+        {
+            auto& tc = GetComponent<TransformComponent>(m_ViewParent.Entity);
+            tc.SetScale(m_ViewParent.Scale);
+            tc.SetPosition(m_ViewParent.Position);
+        }
+        for (auto& viewObj : m_ViewObjects)
+        {
+            auto& tc = GetComponent<TransformComponent>(viewObj.Entity);
+            tc.SetScale(viewObj.Scale);
+            tc.SetPosition(viewObj.Position);
+        }
+
+        /* Non-orbital children (down to hierarchy leaves) are placed relative to their orbital parents by Scene::UpdateWorldTransforms():
+         * a non-orbital entity cannot have orbital children so it is guaranteed to be purely for extending a parent entity in the
+         * scene without affecting orbital behaviour. */
+    }
+
+
+    void OrbitalScene::ExtractViewSpace()
+    {
+        LV_PROFILE_FUNCTION();
+
+        m_ViewObjects.clear();
+        m_ViewLocalSpaces.clear();
+
+        /* Extraction is the only place orbits are fetched for rendering, so the recompute budget is reset here */
+        OrbitalPhysics::ResetOrbitRecomputeBudget((uint32_t)std::max(m_OrbitRecomputeBudget, 0));
+
+        Vector3 viewSpaceOffset = -(Vector3)m_ViewObject.GetState().Position;
         auto& lsp = m_ViewLSpace.GetLSpace();
 
-        auto viewParent = m_ViewLSpace.ParentObj();
+        // View parent
         {
-            auto [tc, ohc] = GetComponents<TransformComponent, OrbitalHierarchyComponent>(m_PhysicsToEnttIds.at(viewParent.Id()));
-            tc.SetScale((Vector3)(ohc.AbsoluteScale / lsp.MetersPerRadius));
-            tc.SetPosition(viewSpaceOffset);
+            m_ViewParent.Object = m_ViewLSpace.ParentObj();
+            m_ViewParent.Entity = PhysicsToEntity(m_ViewParent.Object.Id());
+            auto [ohc, oc] = GetComponents<OrbitalHierarchyComponent, OrbitalComponent>(m_ViewParent.Entity);
+            m_ViewParent.Position = viewSpaceOffset;
+            m_ViewParent.Scale = (Vector3)(ohc.AbsoluteScale / lsp.MetersPerRadius);
+
+            size_t l = 0;
+            while (oc.LocalSpaces[l] != m_ViewLSpace) { l++; }
+            m_ViewParent.FirstLocalSpace = 0;
+            m_ViewParent.NumLocalSpaces = (uint32_t)(oc.LocalSpaces.size() - l);
+            for (; l < oc.LocalSpaces.size(); l++) {
+                m_ViewLocalSpaces.push_back({ oc.LocalSpaces[l].GetLSpace().Radius, oc.LocalSpaces[l].IsSphereOfInfluence() });
+            }
         }
 
-        std::vector<OrbitalPhysics::ObjectNode> viewObjs;
-        m_ViewLSpace.GetLocalObjects(viewObjs);
-        for (auto viewObj : viewObjs)
+        // View objects
+        std::vector<OrbitalPhysics::ObjectNode> viewObjNodes;
+        m_ViewLSpace.GetLocalObjects(viewObjNodes);
+        m_ViewObjects.reserve(viewObjNodes.size());
+        for (auto viewObjNode : viewObjNodes)
         {
-            auto [tc, ohc, oc] = GetComponents<TransformComponent, OrbitalHierarchyComponent, OrbitalComponent>(m_PhysicsToEnttIds.at(viewObj.Id()));
-            tc.SetScale((Vector3)(ohc.AbsoluteScale / lsp.MetersPerRadius));
+            auto& viewObj = m_ViewObjects.emplace_back();
+            viewObj.Object = viewObjNode;
+            viewObj.Entity = PhysicsToEntity(viewObjNode.Id());
+            auto [ohc, oc] = GetComponents<OrbitalHierarchyComponent, OrbitalComponent>(viewObj.Entity);
+
+            viewObj.Scale = (Vector3)(ohc.AbsoluteScale / lsp.MetersPerRadius);
+            viewObj.Position = viewObjNode == m_ViewObject ? Vector3{ 0.f } : viewSpaceOffset + (Vector3)viewObjNode.GetState().Position;
+
+            auto validity = viewObjNode.GetObj().Validity;
+            viewObj.Drawn = validity == OrbitalPhysics::Validity::Valid || validity == OrbitalPhysics::Validity::InvalidMotion;
+            if (!viewObj.Drawn) continue;
+
+            auto& orbit = viewObjNode.GetOrbitBudgeted();
+            viewObj.Elements = orbit.Elements;
+            viewObj.TaExit = (viewObjNode.IsDynamic() || orbit.Elements.Type == OrbitalPhysics::OrbitType::Hyperbola) ? orbit.TaExit : PI2f;
+            viewObj.OrbitCenter = viewObj.Position - viewObjNode.LocalPositionFromPrimary() + (orbit.Elements.PerifocalX * orbit.Elements.C);
+            viewObj.Color = validity == OrbitalPhysics::Validity::InvalidMotion ?
+                Vector4{ 1.f, 0.f, 0.f, 0.4f } : Vector4{ oc.UIColor, 0.4f };
+            viewObj.ShowMajorMinorAxes = oc.ShowMajorMinorAxes;
+            viewObj.ShowNormal = oc.ShowNormal;
 
-            if (viewObj == m_ViewObject) {
-                tc.SetPosition({ 0.f });
+            viewObj.FirstLocalSpace = (uint32_t)m_ViewLocalSpaces.size();
+            viewObj.NumLocalSpaces = (uint32_t)oc.LocalSpaces.size();
+            for (auto lspNode : oc.LocalSpaces) {
+                m_ViewLocalSpaces.push_back({ lspNode.GetLSpace().Radius, lspNode.IsSphereOfInfluence() });
             }
-            else {
-                tc.SetPosition(viewSpaceOffset + oc.Object.GetState().Position);
+        }
+
+        // Impostors
+        if (m_ImpostorViewLSpace != m_ViewLSpace || m_ImpostorSuperiorLevels != m_SuperiorLevels ||
+            ++m_FramesSinceImpostorRefresh >= m_ImpostorRefreshFrames)
+        {
+            ExtractSuperiorImpostors();
+        }
+        ExtractInferiorImpostors();
+    }
+
+
+    void OrbitalScene::ExtractSuperiorImpostors()
+    {
+        LV_PROFILE_FUNCTION();
+
+        m_SuperiorImpostors.clear();
+        m_ImpostorViewLSpace = m_ViewLSpace;
+        m_ImpostorSuperiorLevels = m_SuperiorLevels;
+        m_FramesSinceImpostorRefresh = 0;
+        if (m_SuperiorLevels <= 0) return; /* includes the view parent's other local spaces */
+
+        double viewMetersPerRadius = m_ViewLSpace.GetLSpace().MetersPerRadius;
+        auto addImpostor = [&](OrbitalPhysics::ObjectNode objNode, Vector3d const& offsetMeters) {
+            Vector3d offset = offsetMeters / viewMetersPerRadius;
+            double magnitude = sqrt(offset.SqrMagnitude());
+            if (magnitude == 0.0) return;
+
+            auto& impostor = m_SuperiorImpostors.emplace_back();
+            impostor.Entity = PhysicsToEntity(objNode.Id());
+            impostor.Direction = (Vector3)(offset / magnitude);
+            impostor.Magnitude = (float)magnitude;
+            impostor.Color = { GetComponent<OrbitalComponent>(impostor.Entity).UIColor, m_ImpostorAlpha };
+        };
+
+        /* Walk up the tree one level at a time: each level contains the objects in all local spaces of the current
+         * anchor object's parent object, with positions accumulated relative to the view space's parent object */
+        std::vector<OrbitalPhysics::LSpaceNode> lspNodes;
+        std::vector<OrbitalPhysics::ObjectNode> objNodes;
+        OrbitalPhysics::ObjectNode anchorObj = m_ViewLSpace.ParentObj();
+        Vector3d anchorOffset = { 0.0 }; /* Offset of the anchor object from the view space's parent object, in meters */
+
+        /* Objects in the view parent's other local spaces */
+        anchorObj.GetLocalSpaces(lspNodes);
+        for (auto lspNode : lspNodes)
+        {
+            if (lspNode == m_ViewLSpace) continue;
+            double metersPerRadius = lspNode.GetLSpace().MetersPerRadius;
+            objNodes.clear();
+            lspNode.GetLocalObjects(objNodes);
+            for (auto objNode : objNodes) {
+                addImpostor(objNode, (Vector3d)objNode.GetState().Position * metersPerRadius);
             }
         }
 
-        // TODO : place non-orbital children (down to hierarchy leaves):
-        //      : a non-orbital entity cannot have orbital children so it is
-        //      : guaranteed to be purely for extending a parent entity in the 
-        //      : scene without affecting orbital behaviour.
+        for (int level = 0; level < m_SuperiorLevels && !anchorObj.IsRoot(); level++)
+        {
+            auto anchorLsp = anchorObj.ParentLsp();
+            auto levelObj = anchorLsp.ParentObj();
+            Vector3d levelOffset = anchorOffset - (Vector3d)anchorObj.GetState().Position * anchorLsp.GetLSpace().MetersPerRadius;
+            addImpostor(levelObj, levelOffset);
+
+            lspNodes.clear();
+            levelObj.GetLocalSpaces(lspNodes);
+            for (auto lspNode : lspNodes)
+            {
+                double metersPerRadius = lspNode.GetLSpace().MetersPerRadius;
+                objNodes.clear();
+                lspNode.GetLocalObjects(objNodes);
+                for (auto objNode : objNodes) {
+                    if (objNode == anchorObj) continue;
+                    addImpostor(objNode, levelOffset + (Vector3d)objNode.GetState().Position * metersPerRadius);
+                }
+            }
+
+            anchorObj = levelObj;
+            anchorOffset = levelOffset;
+        }
+    }
+
+
+    void OrbitalScene::ExtractInferiorImpostors()
+    {
+        LV_PROFILE_FUNCTION();
+
+        m_InferiorImpostors.clear();
+        if (m_InferiorLevels <= 0) return;
+
+        double viewMetersPerRadius = m_ViewLSpace.GetLSpace().MetersPerRadius;
+
+        /* Depth-first over the local spaces of each view object, down to m_InferiorLevels below the view space */
+        struct Frame { OrbitalPhysics::ObjectNode Obj; Vector3d Offset; int Level; };
+        std::vector<Frame> stack;
+        std::vector<OrbitalPhysics::LSpaceNode> lspNodes;
+        std::vector<OrbitalPhysics::ObjectNode> objNodes;
+        for (uint32_t anchor = 0; anchor < m_ViewObjects.size(); anchor++)
+        {
+            stack.push_back({ m_ViewObjects[anchor].Object, { 0.0 }, 0 });
+            while (!stack.empty())
+            {
+                Frame frame = stack.back();
+                stack.pop_back();
+
+                lspNodes.clear();
+                frame.Obj.GetLocalSpaces(lspNodes);
+                for (auto lspNode : lspNodes)
+                {
+                    double metersPerRadius = lspNode.GetLSpace().MetersPerRadius;
+                    objNodes.clear();
+                    lspNode.GetLocalObjects(objNodes);
+                    for (auto objNode : objNodes)
+                    {
+                        Vector3d offset = frame.Offset + (Vector3d)objNode.GetState().Position * (metersPerRadius / viewMetersPerRadius);
+                        double magnitude = sqrt(offset.SqrMagnitude());
+                        if (magnitude > 0.0)
+                        {
+                            auto& impostor = m_InferiorImpostors.emplace_back();
+                            impostor.Entity = PhysicsToEntity(objNode.Id());
+                            impostor.Anchor = anchor;
+                            impostor.Direction = (Vector3)(offset / magnitude);
+                            impostor.Magnitude = (float)magnitude;
+                            impostor.Color = { GetComponent<OrbitalComponent>(impostor.Entity).UIColor, m_ImpostorAlpha };
+                        }
+                        if (frame.Level + 1 < m_InferiorLevels) {
+                            stack.push_back({ objNode, offset, frame.Level + 1 });
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+
+    void OrbitalScene::RenderImpostors(Camera& camera, const Quaternion& cameraOrientation, float cameraDistance)
+    {
+        LV_PROFILE_FUNCTION();
+
+        auto& stats = Renderer2D::GetStatistics();
+        Camera::Frustum frustum = camera.GetFrustum();
+
+        float radius = m_ImpostorRadius * cameraDistance;
+        auto drawImpostor = [&](Impostor const& impostor) {
+            Vector3 anchorPosition = impostor.Anchor == Impostor::kViewParentAnchor ?
+                m_ViewParent.Position : m_ViewObjects[impostor.Anchor].Position;
+            Vector3 position = anchorPosition + impostor.Direction * std::min(impostor.Magnitude, m_ImpostorMaxDistance);
+            if (!frustum.IntersectsSphere(position, radius)) {
+                stats.ItemsCulled++;
+                return;
+            }
+            stats.ItemsDrawn++;
+
+            Matrix4 transform = glm::translate(glm::mat4(1.f), (glm::vec3)position);
+            transform = transform * Matrix4(cameraOrientation);
+            transform = glm::scale((glm::mat4)transform, glm::vec3(2.f * radius));
+            Renderer2D::DrawCircle(transform, impostor.Color, 1.f, 0.f, (int)impostor.Entity);
+        };
+
+        for (auto& impostor : m_SuperiorImpostors) {
+            drawImpostor(impostor);
+        }
+        for (auto& impostor : m_InferiorImpostors) {
+            drawImpostor(impostor);
+        }
     }
 
 
@@ -400,16 +781,20 @@ namespace Limnova
             LV_CORE_WARN("Scene has no active camera - no rendering!");
             return;
         }
+        UpdateWorldTransforms();
+
         auto [camera, camTransform] = GetComponents<CameraComponent, TransformComponent>(m_Entities[m_ActiveCamera]);
-        camera.Camera.SetView(camTransform.GetTransform().Inverse());
+        camera.Camera.SetView(camTransform.GetWorldTransform().Inverse());
 
-        float cameraDistance = sqrtf(camTransform.GetPosition().SqrMagnitude());
+        float cameraDistance = sqrtf(camTransform.GetWorldPosition().SqrMagnitude());
         RenderOrbitalScene(camera.Camera, camTransform.GetOrientation(), cameraDistance);
     }
 
 
     void OrbitalScene::OnRenderEditor(EditorCamera& camera)
     {
+        UpdateWorldTransforms();
+
         RenderOrbitalScene(camera.GetCamera(), camera.GetOrientation(), camera.GetDistance());
     }
 
@@ -418,30 +803,39 @@ namespace Limnova
     {
         Scene::RenderScene(camera, cameraOrientation);
 
-        // TODO : draw all superior orbital spaces (this primary's primary and siblings, etc) as sprites and point lights
-        // : render as separate scenes, in their own scaling spaces, then superimpose - this allows the camera to have accurate
-        // perspective without having to place the entities at accurate distances relative to the viewed orbital space.
-
+        /* Translucent orbits, local spaces and impostors must blend over the bodies behind them, which needs the render queue's
+         * back-to-front order whatever the order they are drawn in (or merged from command buffers) */
+        bool wasQueued = Renderer2D::IsRenderQueueEnabled();
+        Renderer2D::SetRenderQueue(true);
         Renderer2D::BeginScene(camera);
 
-        RenderLocalSpace(cameraOrientation, cameraDistance);
-
-        // TODO : draw tertiaries as point lights orbiting secondaries
+        /* Superior spaces (the view primary's primary and siblings, etc) and tertiaries are drawn as impostors
+         * extracted by ExtractViewSpace() - the camera keeps accurate directions to them without placing their
+         * entities at accurate distances relative to the viewed orbital space */
+        RenderImpostors(camera, cameraOrientation, cameraDistance);
+        RenderLocalSpace(camera, cameraOrientation, cameraDistance);
 
         Renderer2D::EndScene();
+        Renderer2D::SetRenderQueue(wasQueued);
     }
 
 
-    void OrbitalScene::RenderLocalSpace(const Quaternion& cameraOrientation, float cameraDistance)
+    void OrbitalScene::RenderLocalSpace(Camera& camera, const Quaternion& cameraOrientation, float cameraDistance)
     {
-        // Render orbital visuals
-        auto& lsp = m_ViewLSpace.GetLSpace();
-        auto viewParentObjNode = m_ViewLSpace.ParentObj();
-        std::vector<OrbitalPhysics::ObjectNode> viewObjs;
-        m_ViewLSpace.GetLocalObjects(viewObjs);
+        LV_PROFILE_FUNCTION();
+
+        /* Orbit paths and local spaces are culled by their bounding spheres: outside the view frustum, or too small on screen to see.
+         * Statistics are fetched per call, as a thread recording a command buffer counts into the buffer's statistics */
+        Camera::Frustum frustum = camera.GetFrustum();
+        auto visible = [&](const Vector3& center, float radius) {
+            bool visible = frustum.IntersectsSphere(center, radius) && camera.GetScreenSize(center, radius) >= m_MinScreenSize;
+            auto& stats = Renderer2D::GetStatistics();
+            visible ? stats.ItemsDrawn++ : stats.ItemsCulled++;
+            return visible;
+        };
 
-        Entity viewParent = { m_PhysicsToEnttIds.at(viewParentObjNode.Id()), this };
-        Vector3 viewCenter = viewParent.GetComponent<TransformComponent>().GetPosition();
+        // Render orbital visuals
+        Vector3 viewCenter = m_ViewParent.Position;
         if (m_ShowReferenceAxes) {
             // X
             Renderer2D::DrawDashedArrow(viewCenter, viewCenter + (m_OrbitalReferenceX * m_ReferenceAxisLength),
@@ -453,73 +847,75 @@ namespace Limnova
             Renderer2D::DrawDashedArrow(viewCenter, viewCenter + (m_OrbitalReferenceNormal * 0.5f * m_ReferenceAxisLength),
                 m_ReferenceAxisColor, m_ReferenceAxisThickness, m_ReferenceAxisArrowSize, 4.f, 2.f);
         }
-        auto& viewOc = viewParent.GetComponent<OrbitalComponent>();
-        size_t l = 0;
-        while (viewOc.LocalSpaces[l] != m_ViewLSpace) { l++; }
-        float viewSpaceScaling = 2.f / m_ViewLSpace.GetLSpace().Radius; /* x2 for radius --> diameter */
-        for (; l < viewOc.LocalSpaces.size(); l++) {
-            Matrix4 lsTransform = glm::translate(glm::mat4(1.f), (glm::vec3)viewCenter);
-            lsTransform = lsTransform * Quaternion(Vector3::X(), -PIover2f);
+        if (m_ViewParent.NumLocalSpaces > 0) {
+            float viewSpaceScaling = 2.f / m_ViewLocalSpaces[m_ViewParent.FirstLocalSpace].Radius; /* x2 for radius --> diameter */
+            for (uint32_t l = 0; l < m_ViewParent.NumLocalSpaces; l++) {
+                auto& viewLsp = m_ViewLocalSpaces[m_ViewParent.FirstLocalSpace + l];
 
-            float lsRadius = viewOc.LocalSpaces[l].GetLSpace().Radius * viewSpaceScaling;
-            lsTransform = glm::scale((glm::mat4)lsTransform, glm::vec3(lsRadius));
+                float lsRadius = viewLsp.Radius * viewSpaceScaling;
+                if (!visible(viewCenter, 0.5f * lsRadius)) continue;
 
-            float lsThickness = m_LocalSpaceThickness * cameraDistance / lsRadius;
-            Vector4 lsColor = viewOc.LocalSpaces[l].IsSphereOfInfluence() ? m_InfluencingSpaceColor : m_LocalSpaceColor;
-            Renderer2D::DrawCircle(lsTransform, lsColor, lsThickness, m_LocalSpaceFade);
+                Matrix4 lsTransform = glm::translate(glm::mat4(1.f), (glm::vec3)viewCenter);
+                lsTransform = lsTransform * Quaternion(Vector3::X(), -PIover2f);
+                lsTransform = glm::scale((glm::mat4)lsTransform, glm::vec3(lsRadius));
+
+                float lsThickness = m_LocalSpaceThickness * cameraDistance / lsRadius;
+                Vector4 lsColor = viewLsp.IsSphereOfInfluence ? m_InfluencingSpaceColor : m_LocalSpaceColor;
+                Renderer2D::DrawCircle(lsTransform, lsColor, lsThickness, m_LocalSpaceFade);
+            }
         }
 
         float orbitDrawingThickness = m_OrbitThickness * cameraDistance;
 
-        for (auto viewObjNode : viewObjs)
+        auto drawViewObject = [&](ViewObject const& viewObj)
         {
-            auto entity = m_PhysicsToEnttIds.at(viewObjNode.Id());
-            int editorPickingId = (int)(entity);
-            auto [tc, oc] = GetComponents<TransformComponent, OrbitalComponent>(entity);
-            auto& object = oc.Object.GetObj();
-            auto& elems = oc.Object.GetOrbit().Elements;
+            if (!viewObj.Drawn) return;
 
-            if (object.Validity != OrbitalPhysics::Validity::Valid &&
-                object.Validity != OrbitalPhysics::Validity::InvalidMotion) continue;
+            int editorPickingId = (int)(viewObj.Entity);
+            auto& elems = viewObj.Elements;
 
             // TODO - point light/brightness from OrbitalComponent::Albedo
 
             // Orbit path
-            Vector3 posFromPrimary = oc.Object.LocalPositionFromPrimary();
-            Vector3 orbitCenter = tc.GetPosition() - posFromPrimary + (elems.PerifocalX * elems.C);
-            Vector4 uiColor = object.Validity == OrbitalPhysics::Validity::InvalidMotion ?
-                Vector4{ 1.f, 0.f, 0.f, 0.4f } : Vector4{ oc.UIColor, 0.4f };
-            {
+            Vector3 orbitCenter = viewObj.OrbitCenter;
+            Vector4 uiColor = viewObj.Color;
+            /* Hyperbolic paths are cut off at the view space boundary, which has unit radius around the view parent */
+            bool orbitVisible = elems.Type == OrbitalPhysics::OrbitType::Hyperbola ?
+                visible(m_ViewParent.Position, 1.f) : visible(orbitCenter, elems.SemiMajor);
+            if (orbitVisible) {
                 switch (elems.Type)
                 {
                 case OrbitalPhysics::OrbitType::Circle:
                 case OrbitalPhysics::OrbitType::Ellipse:
-                    Renderer2D::DrawOrbitalEllipse(orbitCenter, elems.PerifocalOrientation * m_OrbitalReferenceFrameOrientation, oc,
+                    Renderer2D::DrawOrbitalEllipse(orbitCenter, elems.PerifocalOrientation * m_OrbitalReferenceFrameOrientation, elems, viewObj.TaExit,
                         uiColor, orbitDrawingThickness, m_OrbitFade, editorPickingId);
                     break;
                 case OrbitalPhysics::OrbitType::Hyperbola:
-                    Renderer2D::DrawOrbitalHyperbola(orbitCenter, elems.PerifocalOrientation * m_OrbitalReferenceFrameOrientation, oc,
+                    Renderer2D::DrawOrbitalHyperbola(orbitCenter, elems.PerifocalOrientation * m_OrbitalReferenceFrameOrientation, elems, viewObj.TaExit,
                         uiColor, orbitDrawingThickness, m_OrbitFade, editorPickingId);
                     break;
                 }
             }
 
             // Local spaces
-            for (auto lspNode : oc.LocalSpaces)
+            for (uint32_t l = 0; l < viewObj.NumLocalSpaces; l++)
             {
-                Matrix4 lsTransform = glm::translate(glm::mat4(1.f), (glm::vec3)(tc.GetPosition()));
-                lsTransform = lsTransform * Matrix4(cameraOrientation);
+                auto& viewLsp = m_ViewLocalSpaces[viewObj.FirstLocalSpace + l];
 
-                float lsRadius = lspNode.GetLSpace().Radius;
+                float lsRadius = viewLsp.Radius;
+                if (!visible(viewObj.Position, lsRadius)) continue;
+
+                Matrix4 lsTransform = glm::translate(glm::mat4(1.f), (glm::vec3)(viewObj.Position));
+                lsTransform = lsTransform * Matrix4(cameraOrientation);
                 lsTransform = glm::scale((glm::mat4)lsTransform, glm::vec3(2.f * lsRadius));
 
                 float lsThickness = m_LocalSpaceThickness * cameraDistance / lsRadius;
-                Vector4 lsColor = lspNode.IsSphereOfInfluence() ? m_InfluencingSpaceColor : m_LocalSpaceColor;
+                Vector4 lsColor = viewLsp.IsSphereOfInfluence ? m_InfluencingSpaceColor : m_LocalSpaceColor;
                 Renderer2D::DrawCircle(lsTransform, lsColor, lsThickness, m_LocalSpaceFade, editorPickingId);
             }
 
             // Perifocal frame
-            if (oc.ShowMajorMinorAxes)
+            if (viewObj.ShowMajorMinorAxes)
             {
                 // Semi-major axis
                 Renderer2D::DrawArrow(orbitCenter, orbitCenter + elems.PerifocalX * elems.SemiMajor,
@@ -532,12 +928,38 @@ namespace Limnova
                 Renderer2D::DrawDashedLine(orbitCenter, orbitCenter - elems.PerifocalY * elems.SemiMinor,
                     uiColor, m_PerifocalAxisThickness, 4.f, 2.f, editorPickingId);
             }
-            if (oc.ShowNormal)
+            if (viewObj.ShowNormal)
             {
-                Renderer2D::DrawArrow(tc.GetPosition(), tc.GetPosition() + elems.PerifocalNormal * 0.5f * elems.SemiMinor,
+                Renderer2D::DrawArrow(viewObj.Position, viewObj.Position + elems.PerifocalNormal * 0.5f * elems.SemiMinor,
                     uiColor, m_PerifocalAxisThickness, m_PerifocalAxisArrowSize, editorPickingId);
             }
+        };
+
+        if (m_ViewObjects.size() < kMinParallelViewObjects) {
+            std::for_each(m_ViewObjects.begin(), m_ViewObjects.end(), drawViewObject);
+            return;
         }
+
+        /* Chunks of view objects are drawn in parallel, each into its own command buffer - the buffers are acquired in chunk order,
+         * which is the order Renderer2D merges them in, so view objects keep their serial order among themselves. The orbital scene is
+         * rendered through the render queue, which orders the buffers' primitives together with the directly drawn ones by sort key */
+        size_t numChunks = (m_ViewObjects.size() + kViewObjectsPerRenderChunk - 1) / kViewObjectsPerRenderChunk;
+        std::vector<Renderer2D::CommandBuffer*> commandBuffers(numChunks);
+        for (auto& commandBuffer : commandBuffers) {
+            commandBuffer = &Renderer2D::AcquireCommandBuffer();
+        }
+        std::vector<size_t> chunks(numChunks);
+        std::iota(chunks.begin(), chunks.end(), 0);
+        std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](size_t chunk) {
+            size_t first = chunk * kViewObjectsPerRenderChunk;
+            size_t last = std::min(first + kViewObjectsPerRenderChunk, m_ViewObjects.size());
+
+            Renderer2D::BeginRecording(*commandBuffers[chunk]);
+            for (size_t i = first; i < last; i++) {
+                drawViewObject(m_ViewObjects[i]);
+            }
+            Renderer2D::EndRecording();
+        });
     }
 
 
@@ -547,17 +969,33 @@ namespace Limnova
     }
 
 
+    void OrbitalScene::MapPhysicsToEntity(OrbitalPhysics::TNodeId nodeId, entt::entity entity)
+    {
+        if (nodeId >= m_PhysicsToEnttIds.size()) {
+            m_PhysicsToEnttIds.resize(nodeId + 1, entt::null);
+        }
+        m_PhysicsToEnttIds[nodeId] = entity;
+    }
+
+
+    entt::entity OrbitalScene::PhysicsToEntity(OrbitalPhysics::TNodeId nodeId) const
+    {
+        LV_CORE_ASSERT(nodeId < m_PhysicsToEnttIds.size() && m_PhysicsToEnttIds[nodeId] != entt::null, "Physics node has no entity!");
+        return m_PhysicsToEnttIds[nodeId];
+    }
+
+
     OrbitalPhysics::LSpaceNode OrbitalScene::GetEntityLSpace(entt::entity entity)
     {
         if (entity == m_Entities[m_Root]) { return OrbitalPhysics::GetRootLSpaceNode(); }
 
         auto [hc, ohc] = GetComponents<HierarchyComponent, OrbitalHierarchyComponent>(entity);
         if (ohc.LocalSpaceRelativeToParent == -1) {
-            return GetEntityLSpace(m_Entities[hc.Parent]);
+            return GetEntityLSpace(hc.Parent);
         }
         else {
-            LV_CORE_ASSERT(HasComponent<OrbitalComponent>(m_Entities[hc.Parent]), "Invalid LocalSpaceRelativeToParent!");
-            auto& parentOc = GetComponent<OrbitalComponent>(m_Entities[hc.Parent]);
+            LV_CORE_ASSERT(HasComponent<OrbitalComponent>(hc.Parent), "Invalid LocalSpaceRelativeToParent!");
+            auto& parentOc = GetComponent<OrbitalComponent>(hc.Parent);
             LV_CORE_ASSERT(ohc.LocalSpaceRelativeToParent < parentOc.LocalSpaces.size(), "Invalid LocalSpaceRelativeToParent!");
             return parentOc.LocalSpaces[ohc.LocalSpaceRelativeToParent];
         }
@@ -569,7 +1007,7 @@ namespace Limnova
         if (HasComponent<OrbitalComponent>(entity)) {
             return GetComponent<OrbitalComponent>(entity).Object;
         }
-        return GetEntityObject(m_Entities.at(GetComponent<HierarchyComponent>(entity).Parent));
+        return GetEntityObject(GetComponent<HierarchyComponent>(entity).Parent);
     }
 
 
@@ -580,8 +1018,8 @@ namespace Limnova
         /* Parent of an orbital entity must also be orbital */
         /*OrbitalPhysics::LSpaceNode localSpace = GetEntityLSpace(entity);
         {
-            entt::entity localParent = m_PhysicsToEnttIds.at(localSpace.ParentObj().Id());
-            if (localParent != m_Entities.at(hc.Parent)) {
+            entt::entity localParent = PhysicsToEntity(localSpace.ParentObj().Id());
+            if (localParent != hc.Parent) {
                 HierarchyDisconnect(entity);
                 HierarchyConnect(entity, localParent);
             }
@@ -592,12 +1030,12 @@ namespace Limnova
         }
 
         OrbitalPhysics::LSpaceNode localSpace;
-        Entity entityParent = GetEntity(hc.Parent);
+        Entity entityParent = { hc.Parent, this };
         if (!entityParent.HasComponent<OrbitalComponent>() || entityParent.GetComponent<OrbitalComponent>().LocalSpaces.size() == 0)
         {
             // No local space attached to parent - reparent to parent of current local space
             localSpace = GetEntityLSpace(entity);
-            entt::entity localParent = m_PhysicsToEnttIds.at(localSpace.ParentObj().Id());
+            entt::entity localParent = PhysicsToEntity(localSpace.ParentObj().Id());
             HierarchyDisconnect(entity);
             HierarchyConnect(entity, localParent);
         }
@@ -609,20 +1047,23 @@ namespace Limnova
         }
 
         oc.Object = OrbitalPhysics::Create(localSpace, 0.0, tc.GetPosition());
-        m_PhysicsToEnttIds.insert({ oc.Object.Id(), entity });
+        MapPhysicsToEntity(oc.Object.Id(), entity);
     }
 
 
     void OrbitalScene::OnOrbitalComponentDestruct(entt::registry&, entt::entity entity)
     {
-        OrbitalPhysics::Destroy(GetComponent<OrbitalComponent>(entity).Object);
+        auto objNode = GetComponent<OrbitalComponent>(entity).Object;
+        MapPhysicsToEntity(objNode.Id(), entt::null);
+        m_ImpostorViewLSpace = {}; /* cached impostors may reference the destroyed object */
+        OrbitalPhysics::Destroy(objNode);
     }
 
 
     void OrbitalScene::OnParentLocalSpaceChange(OrbitalPhysics::ObjectNode objNode)
     {
-        entt::entity objectEnttId = m_PhysicsToEnttIds.at(objNode.Id());
-        entt::entity parentEnttId = m_PhysicsToEnttIds.at(objNode.ParentObj().Id());
+        entt::entity objectEnttId = PhysicsToEntity(objNode.Id());
+        entt::entity parentEnttId = PhysicsToEntity(objNode.ParentObj().Id());
         HierarchyDisconnect(objectEnttId);
         HierarchyConnect(objectEnttId, parentEnttId);
 
@@ -637,7 +1078,7 @@ namespace Limnova
 
     void OrbitalScene::OnChildLocalSpacesChange(OrbitalPhysics::ObjectNode objNode)
     {
-        GetComponent<OrbitalComponent>(m_PhysicsToEnttIds.at(objNode.Id())).UpdateLocalSpaces();
+        GetComponent<OrbitalComponent>(PhysicsToEntity(objNode.Id())).UpdateLocalSpaces();
     }
 
 }
@@ -18,6 +18,39 @@ namespace Limnova
 
         Entity CreateEntityFromUUID(UUID uuid, const std::string& name = std::string(), UUID parent = UUID::Null) override;
         Entity DuplicateEntity(Entity entity) override;
+        std::vector<Entity> CreateEntities(size_t count, UUID prototype = UUID::Null, UUID parent = UUID::Null) override; /* Non-orbital entities only - see CreateOrbitalEntities() */
+
+        struct OrbitalEntityDesc
+        {
+            std::string Name;
+            UUID Id = UUID::Null; /* Null to generate a new ID */
+            UUID Parent = UUID::Null; /* Must be an orbital entity - Null for the root entity */
+            int64_t ParentIndex = -1; /* Index of an earlier description in the same batch - if set, Parent is ignored */
+            int LocalSpaceRelativeToParent = 0;
+            double Mass = 0.0;
+            Vector3 Position = { 0.f };
+            Vector3d Velocity = { 0.0 };
+            bool CircularOrbit = false; /* if true, Velocity is ignored and the entity is given the velocity of a circular orbit */
+            bool Dynamic = false;
+            Vector3d ContAcceleration = { 0.0 }; /* Dynamic entities only */
+            std::vector<float> LocalSpaceRadii; /* Non-influencing local spaces only */
+        };
+
+        /// <summary>
+        /// Creates many orbital entities at once: physics objects are created with OrbitalPhysics::CreateMany() and the scene's
+        /// local-space change hooks are fired once per affected entity after all entities exist, rather than once per physics change.
+        /// Entities may be parented to earlier entities in the same batch (see OrbitalEntityDesc::ParentIndex).
+        /// </summary>
+        /// <returns>Created entities, in the same order as the given descriptions</returns>
+        std::vector<Entity> CreateOrbitalEntities(std::span<OrbitalEntityDesc const> descs);
+
+        std::vector<Entity> InstantiatePrefab(const Ref<Prefab>& prefab, size_t count, UUID parent = UUID::Null) override; /* Non-orbital prefabs only */
+
+        /// <summary>
+        /// Creates instances of an orbital prefab with CreateOrbitalEntities(). The prefab provides each instance's mass, dynamics,
+        /// local-space radii and display settings - the descriptions only provide per-instance placement (and names, if not empty).
+        /// </summary>
+        std::vector<Entity> InstantiatePrefab(const Ref<Prefab>& prefab, std::span<OrbitalEntityDesc const> descs);
     public:
         void PhysicsUseContext();
 
@@ -48,14 +81,22 @@ namespace Limnova
         //OrbitalPhysics::Stats const& GetPhysicsStats() { return m_PhysicsContext.GetStats(); }
 #endif
     private:
+        void InsertOrbitalHierarchyComponents(const std::vector<Entity>& entities, const OrbitalHierarchyComponent& ohc);
         void UpdateOrbitalScene();
+        void ExtractViewSpace();
         void RenderOrbitalScene(Camera& camera, const Quaternion& cameraOrientation, float cameraDistance);
 
-        void RenderLocalSpace(const Quaternion& cameraOrientation, float cameraDistance);
+        void ExtractSuperiorImpostors();
+        void ExtractInferiorImpostors();
+        void RenderLocalSpace(Camera& camera, const Quaternion& cameraOrientation, float cameraDistance);
+        void RenderImpostors(Camera& camera, const Quaternion& cameraOrientation, float cameraDistance);
 
         OrbitalPhysics::LSpaceNode GetEntityLSpace(entt::entity entity);
         OrbitalPhysics::ObjectNode GetEntityObject(entt::entity entity);
 
+        void MapPhysicsToEntity(OrbitalPhysics::TNodeId nodeId, entt::entity entity);
+        entt::entity PhysicsToEntity(OrbitalPhysics::TNodeId nodeId) const;
+
         void OnOrbitalComponentConstruct(entt::registry&, entt::entity);
         void OnOrbitalComponentUpdate(entt::registry&, entt::entity);
         void OnOrbitalComponentDestruct(entt::registry&, entt::entity);
@@ -73,6 +114,7 @@ namespace Limnova
         float m_OrbitFade = 0.f;
         float m_OrbitAlpha = 0.4f;
         float m_OrbitPointRadius = 0.01f;
+        int m_OrbitRecomputeBudget = (int)OrbitalPhysics::kMaxOrbitRecomputesPerFrame; /* Maximum number of stale orbits recomputed for rendering each frame */
 
         bool m_ShowReferenceAxes = false;
         Vector4 m_ReferenceAxisColor = { 1.f, 1.f, 1.f, 0.2 };
@@ -82,9 +124,71 @@ namespace Limnova
 
         float m_PerifocalAxisThickness = 0.006f;
         float m_PerifocalAxisArrowSize = 0.024f;
+
+        int m_SuperiorLevels = 1;               /* Number of local-space levels above the view space drawn as impostors */
+        int m_InferiorLevels = 1;               /* Number of local-space levels below the view space's objects drawn as impostors */
+        int m_ImpostorRefreshFrames = 30;       /* Frames between refreshes of cached superior-level impostors - they are also refreshed whenever the view space changes */
+        float m_ImpostorRadius = 0.004f;
+        float m_ImpostorMaxDistance = 50.f;     /* Impostors further than this from their anchor are drawn at this distance, in their true direction */
+        float m_ImpostorAlpha = 0.8f;
+
+        float m_MinScreenSize = 0.002f;         /* Orbit paths and local-space circles whose projected diameter is smaller than this fraction of the viewport height are not drawn */
     private:
+        /// <summary>
+        /// Everything needed to place and draw one orbital object in the view space. Extracted once per frame by ExtractViewSpace(),
+        /// then consumed by both UpdateOrbitalScene() and RenderLocalSpace().
+        /// </summary>
+        struct ViewObject
+        {
+            OrbitalPhysics::ObjectNode Object;
+            entt::entity Entity = entt::null;
+            Vector3 Position;                   /* Scene-space position */
+            Vector3 Scale;                      /* Scene-space scale (absolute scale relative to the view space) */
+            bool Drawn = false;                 /* False if the object's orbit cannot be drawn (invalid object) */
+            bool ShowMajorMinorAxes = false, ShowNormal = false;
+            Vector4 Color;                      /* UI color of the orbit path and perifocal axes */
+            Vector3 OrbitCenter;                /* Scene-space centre of the orbit path */
+            OrbitalPhysics::Elements Elements;
+            float TaExit = PI2f;                /* True anomaly at which the drawn orbit path is cut off (2Pi if not cut off) */
+            uint32_t FirstLocalSpace = 0, NumLocalSpaces = 0; /* Range of the object's local spaces in m_ViewLocalSpaces */
+        };
+        struct ViewLocalSpace
+        {
+            float Radius;
+            bool IsSphereOfInfluence;
+        };
+
+        std::vector<ViewObject> m_ViewObjects;
+        std::vector<ViewLocalSpace> m_ViewLocalSpaces;
+        ViewObject m_ViewParent;                /* Parent object of the view space - not drawn, its local spaces from the view space outwards are in m_ViewLocalSpaces */
+
+        /// <summary>
+        /// An orbital object outside the view space, drawn as a point at a direction and distance from an anchor object
+        /// rather than as a full entity - used for objects in the local spaces above and below the view space.
+        /// </summary>
+        struct Impostor
+        {
+            static constexpr uint32_t kViewParentAnchor = ::std::numeric_limits<uint32_t>::max();
+
+            entt::entity Entity = entt::null;
+            uint32_t Anchor = kViewParentAnchor; /* Index in m_ViewObjects of the object this impostor is placed relative to, or kViewParentAnchor */
+            Vector3 Direction;                  /* Unit direction from the anchor */
+            float Magnitude;                    /* Distance from the anchor, in view-space units */
+            Vector4 Color;
+        };
+
+        std::vector<Impostor> m_SuperiorImpostors;  /* Cached - only refreshed every m_ImpostorRefreshFrames or when the view space changes */
+        std::vector<Impostor> m_InferiorImpostors;  /* Extracted every frame - relative positions of tertiaries change as fast as the view objects */
+        OrbitalPhysics::LSpaceNode m_ImpostorViewLSpace; /* View space for which m_SuperiorImpostors was extracted - set to null to force a refresh */
+        int m_ImpostorSuperiorLevels = 0;
+        int m_FramesSinceImpostorRefresh = 0;
+
+        /* Cached non-owning group of orbital entities, created by the constructor and kept by the registry: owning the orbital pools
+         * would let the group reorder them, and OrbitalComponent references are held across registry operations by the physics callbacks */
+        auto OrbitalGroup() { return m_Registry.group<>(entt::get<OrbitalComponent, OrbitalHierarchyComponent, TransformComponent>); }
+
         OrbitalPhysics::Context m_PhysicsContext;
-        std::map<OrbitalPhysics::TNodeId, entt::entity> m_PhysicsToEnttIds;
+        std::vector<entt::entity> m_PhysicsToEnttIds; /* Indexed by OrbitalPhysics::TNodeId - node IDs are recycled so the index stays dense */
 
         UUID m_TrackingEntity;
         int m_RelativeViewSpace;
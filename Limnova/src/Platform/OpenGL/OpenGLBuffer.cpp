@@ -60,6 +60,95 @@ namespace Limnova
     }
 
 
+    // StreamingVertexBuffer ///////////////////////////////////////////////////
+
+    OpenGLStreamingVertexBuffer::OpenGLStreamingVertexBuffer(uint32_t regionSize, uint32_t numRegions)
+        : m_RegionSize(regionSize), m_RegionFences(numRegions, nullptr)
+    {
+        LV_PROFILE_FUNCTION();
+
+        LV_CORE_ASSERT(numRegions > 0, "Streaming vertex buffer must have at least one region!");
+
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GLsizeiptr size = (GLsizeiptr)regionSize * numRegions;
+        glCreateBuffers(1, &m_RendererId);
+        glNamedBufferStorage(m_RendererId, size, nullptr, flags);
+        m_MappedData = (uint8_t*)glMapNamedBufferRange(m_RendererId, 0, size, flags);
+        LV_CORE_ASSERT(m_MappedData != nullptr, "Failed to map streaming vertex buffer!");
+    }
+
+
+    OpenGLStreamingVertexBuffer::~OpenGLStreamingVertexBuffer()
+    {
+        LV_PROFILE_FUNCTION();
+
+        for (auto fence : m_RegionFences) {
+            if (fence != nullptr) glDeleteSync((GLsync)fence);
+        }
+        glUnmapNamedBuffer(m_RendererId);
+        glDeleteBuffers(1, &m_RendererId);
+    }
+
+
+    void OpenGLStreamingVertexBuffer::SetData(const void* data, uint32_t size)
+    {
+        LV_PROFILE_FUNCTION();
+
+        LV_CORE_ASSERT(size <= m_RegionSize, "Data does not fit in a region!");
+        memcpy(BeginRegion(), data, size);
+    }
+
+
+    void OpenGLStreamingVertexBuffer::Bind() const
+    {
+        LV_PROFILE_FUNCTION();
+
+        glBindBuffer(GL_ARRAY_BUFFER, m_RendererId);
+    }
+
+
+    void OpenGLStreamingVertexBuffer::Unbind() const
+    {
+        LV_PROFILE_FUNCTION();
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+
+    void* OpenGLStreamingVertexBuffer::BeginRegion()
+    {
+        if (!m_RegionBegun)
+        {
+            if (GLsync fence = (GLsync)m_RegionFences[m_RegionIndex])
+            {
+                LV_PROFILE_SCOPE("OpenGLStreamingVertexBuffer::BeginRegion - wait for GPU");
+
+                /* Only flush on the first attempt - later attempts just keep waiting, 1 ms at a time */
+                GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+                while (result == GL_TIMEOUT_EXPIRED) {
+                    result = glClientWaitSync(fence, 0, 1000000);
+                }
+                LV_CORE_ASSERT(result != GL_WAIT_FAILED, "Failed to wait for streaming vertex buffer region!");
+
+                glDeleteSync(fence);
+                m_RegionFences[m_RegionIndex] = nullptr;
+            }
+            m_RegionBegun = true;
+        }
+        return m_MappedData + GetRegionOffset();
+    }
+
+
+    void OpenGLStreamingVertexBuffer::EndRegion()
+    {
+        LV_CORE_ASSERT(m_RegionBegun, "EndRegion() called without BeginRegion()!");
+
+        m_RegionFences[m_RegionIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        m_RegionIndex = (m_RegionIndex + 1) % (uint32_t)m_RegionFences.size();
+        m_RegionBegun = false;
+    }
+
+
     // IndexBuffer /////////////////////////////////////////////////////////////
 
     OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t* indices, uint32_t count)
@@ -27,6 +27,38 @@ namespace Limnova
     };
 
 
+    // StreamingVertexBuffer ///////////////////////////////////////////////////
+    class OpenGLStreamingVertexBuffer : public StreamingVertexBuffer
+    {
+    public:
+        OpenGLStreamingVertexBuffer(uint32_t regionSize, uint32_t numRegions);
+        ~OpenGLStreamingVertexBuffer();
+
+        void SetData(const void* data, uint32_t size) override;
+
+        void Bind() const override;
+        void Unbind() const override;
+
+        inline const BufferLayout& GetLayout() const override { return m_Layout; }
+        inline void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+
+        void* BeginRegion() override;
+        void EndRegion() override;
+
+        inline uint32_t GetRegionOffset() const override { return m_RegionIndex * m_RegionSize; }
+        inline uint32_t GetRegionSize() const override { return m_RegionSize; }
+    private:
+        uint32_t m_RendererId;
+        BufferLayout m_Layout;
+
+        uint8_t* m_MappedData;
+        uint32_t m_RegionSize;
+        uint32_t m_RegionIndex = 0;
+        bool m_RegionBegun = false;
+        std::vector<void*> m_RegionFences; /* GLsync per region, or nullptr if the region has not been drawn from */
+    };
+
+
     // IndexBuffer /////////////////////////////////////////////////////////////
     class OpenGLIndexBuffer : public IndexBuffer
     {
@@ -114,6 +114,12 @@ namespace Limnova
         glDeleteFramebuffers(1, &m_RendererId);
         glDeleteTextures(m_ColorAttachments.size(), m_ColorAttachments.data());
         glDeleteTextures(1, &m_DepthAttachment);
+
+        for (auto& readback : m_Readbacks)
+        {
+            if (readback.Fence != nullptr) glDeleteSync((GLsync)readback.Fence);
+            if (readback.Buffer != 0) glDeleteBuffers(1, &readback.Buffer);
+        }
     }
 
 
@@ -255,6 +261,111 @@ namespace Limnova
     }
 
 
+    uint32_t OpenGLFramebuffer::RequestReadback(uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t attachmentIndex)
+    {
+        LV_PROFILE_FUNCTION();
+
+        LV_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "Attachment index out of bounds!");
+
+        if (x >= m_Specification.Width || y >= m_Specification.Height) return 0;
+        width = std::min(width, m_Specification.Width - x);
+        height = std::min(height, m_Specification.Height - y);
+        if (width == 0 || height == 0) return 0;
+
+        Readback& readback = m_Readbacks[m_NextReadback];
+        m_NextReadback = (m_NextReadback + 1) % kNumReadbacks;
+        if (readback.Fence != nullptr)
+        {
+            /* Ring is full - drop the oldest readback */
+            glDeleteSync((GLsync)readback.Fence);
+            readback.Fence = nullptr;
+        }
+
+        size_t size = (size_t)width * height * sizeof(int);
+        if (readback.Buffer == 0) {
+            glCreateBuffers(1, &readback.Buffer);
+        }
+        if (size > readback.Capacity)
+        {
+            glNamedBufferData(readback.Buffer, size, nullptr, GL_STREAM_READ);
+            readback.Capacity = size;
+        }
+
+        /* With a pixel pack buffer bound, glReadPixels only queues the copy: it returns without waiting for the GPU */
+        GLint previousReadFramebuffer;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousReadFramebuffer);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_RendererId);
+        glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.Buffer);
+        glReadPixels(x, y, width, height, GL_RED_INTEGER, GL_INT, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, previousReadFramebuffer);
+
+        readback.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        readback.Id = m_NextReadbackId++;
+        if (m_NextReadbackId == 0) m_NextReadbackId = 1; /* 0 is reserved for 'no readback' */
+        readback.X = x;
+        readback.Y = y;
+        readback.Width = width;
+        readback.Height = height;
+        return readback.Id;
+    }
+
+
+    bool OpenGLFramebuffer::PollReadback(FramebufferReadback& result)
+    {
+        LV_PROFILE_FUNCTION();
+
+        /* The ring is in request order starting from the next slot, and fences signal in order, so only the oldest needs checking */
+        for (size_t i = 0; i < kNumReadbacks; i++)
+        {
+            Readback& readback = m_Readbacks[(m_NextReadback + i) % kNumReadbacks];
+            if (readback.Fence == nullptr) continue;
+
+            GLenum status = glClientWaitSync((GLsync)readback.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+            if (status == GL_TIMEOUT_EXPIRED) return false;
+
+            glDeleteSync((GLsync)readback.Fence);
+            readback.Fence = nullptr;
+            if (status == GL_WAIT_FAILED)
+            {
+                LV_CORE_ERROR("Framebuffer readback {0} failed!", readback.Id);
+                continue;
+            }
+
+            result.Id = readback.Id;
+            result.X = readback.X;
+            result.Y = readback.Y;
+            result.Width = readback.Width;
+            result.Height = readback.Height;
+            result.Pixels.resize((size_t)readback.Width * readback.Height);
+            glGetNamedBufferSubData(readback.Buffer, 0, result.Pixels.size() * sizeof(int), result.Pixels.data());
+            return true;
+        }
+        return false;
+    }
+
+
+    bool OpenGLFramebuffer::IsReadbackPending(uint32_t id) const
+    {
+        if (id == 0) return false;
+        return std::any_of(m_Readbacks.begin(), m_Readbacks.end(), [id](const Readback& readback) {
+            return readback.Fence != nullptr && readback.Id == id;
+        });
+    }
+
+
+    void OpenGLFramebuffer::DiscardReadbacks()
+    {
+        for (auto& readback : m_Readbacks)
+        {
+            if (readback.Fence == nullptr) continue;
+            glDeleteSync((GLsync)readback.Fence);
+            readback.Fence = nullptr;
+        }
+    }
+
+
     void OpenGLFramebuffer::ClearAttachment(uint32_t attachmentIndex, int clearValue)
     {
         GLenum format = LvFBTextureFormatToGL(
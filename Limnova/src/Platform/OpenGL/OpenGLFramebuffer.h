@@ -25,6 +25,11 @@ namespace Limnova
         void ClearAttachment(uint32_t attachmentIndex, int clearValue) override;
 
         int ReadPixel(uint32_t x, uint32_t y, uint32_t attachmentIndex = 0) const override;
+
+        uint32_t RequestReadback(uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t attachmentIndex = 0) override;
+        bool PollReadback(FramebufferReadback& readback) override;
+        bool IsReadbackPending(uint32_t id) const override;
+        void DiscardReadbacks() override;
     private:
         void Reset();
     private:
@@ -36,6 +41,20 @@ namespace Limnova
 
         std::vector<uint32_t> m_ColorAttachments;
         uint32_t m_DepthAttachment = 0;
+
+        /* Ring of pixel pack buffers for asynchronous readbacks */
+        struct Readback
+        {
+            uint32_t Buffer = 0;
+            size_t Capacity = 0;
+            void* Fence = nullptr; /* GLsync signalled when the GPU has written the buffer - null if the slot holds no readback */
+            uint32_t Id = 0;
+            uint32_t X = 0, Y = 0, Width = 0, Height = 0;
+        };
+        static constexpr size_t kNumReadbacks = 3;
+        std::array<Readback, kNumReadbacks> m_Readbacks;
+        size_t m_NextReadback = 0; /* also the oldest readback, when the ring is full */
+        uint32_t m_NextReadbackId = 1;
     };
 
 }
@@ -7,12 +7,18 @@
 #include <spirv_cross/spirv_cross.hpp>
 #include <spirv_cross/spirv_glsl.hpp>
 
+#include <execution>
+#include <iomanip>
+#include <numeric>
+
 
 namespace Limnova
 {
 
     static constexpr const char* kCacheDir = LV_ASSET_DIR"/cache/shader/opengl";
     static constexpr bool kOptimizeShaderc = true;
+    /* Hashed with the sources, so changing the compile targets invalidates the cache */
+    static constexpr const char* kCompileTargets = "vulkan_1_2 opengl_4_5";
 
 
     static GLenum ShaderTypeFromString(const std::string& type)
@@ -92,30 +98,91 @@ namespace Limnova
     }
 
 
-    OpenGLShader::OpenGLShader(const std::string& filepath)
-        : m_Filepath(filepath)
+    static constexpr const char* kCachedProgramFileExtension = ".cached_program";
+
+
+    /// <summary> 64-bit FNV-1a </summary>
+    static uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
     {
-        LV_PROFILE_FUNCTION();
+        auto bytes = (const uint8_t*)data;
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
 
-        CreateCacheDirectoryIfNeeded();
 
-        std::string source = ReadFile(filepath);
-        auto shaderSources = Preprocess(source);
-        
+    static uint64_t HashSources(const std::unordered_map<GLenum, std::string>& sources)
+    {
+        /* Stages are hashed in a fixed order - the map's iteration order is unspecified */
+        std::vector<GLenum> stages;
+        for (auto&& [stage, source] : sources) {
+            stages.push_back(stage);
+        }
+        std::sort(stages.begin(), stages.end());
+
+        uint64_t hash = 0xcbf29ce484222325ull;
+        hash = HashBytes(hash, kCompileTargets, strlen(kCompileTargets));
+        hash = HashBytes(hash, &kOptimizeShaderc, sizeof(kOptimizeShaderc));
+        for (GLenum stage : stages)
         {
-            Timer timer;
-            CompileOrGetVulkanBinaries(shaderSources);
-            CompileOrGetOpenGLBinaries();
-            CreateProgram();
-            LV_CORE_INFO("Shader creation took {0} ms", timer.ElapsedMillis());
+            const std::string& source = sources.at(stage);
+            hash = HashBytes(hash, &stage, sizeof(stage));
+            hash = HashBytes(hash, source.data(), source.size());
         }
+        return hash;
+    }
+
+
+    static bool ReadCachedSPIRV(const std::filesystem::path& cachedPath, std::vector<uint32_t>& data)
+    {
+        std::ifstream in(cachedPath, std::ios::in | std::ios::binary);
+        if (!in.is_open()) return false;
 
-        // Extract name from filepath
+        in.seekg(0, std::ios::end);
+        auto size = in.tellg();
+        in.seekg(0, std::ios::beg);
+
+        data.resize(size / sizeof(uint32_t));
+        in.read((char*)data.data(), size);
+        return true;
+    }
+
+
+    static void WriteCachedSPIRV(const std::filesystem::path& cachedPath, const std::vector<uint32_t>& data)
+    {
+        std::ofstream out(cachedPath, std::ios::out | std::ios::binary);
+        if (out.is_open())
+        {
+            out.write((char*)data.data(), data.size() * sizeof(uint32_t));
+            out.flush();
+            out.close();
+        }
+    }
+
+
+    static std::string NameFromFilepath(const std::string& filepath)
+    {
         auto lastSlash = filepath.find_last_of("/\\");
         lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
         auto lastDot = filepath.rfind('.');
         auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
-        m_Name = filepath.substr(lastSlash, count);
+        return filepath.substr(lastSlash, count);
+    }
+
+
+    OpenGLShader::OpenGLShader(const std::string& filepath)
+        : m_Name(NameFromFilepath(filepath)), m_Filepath(filepath)
+    {
+        LV_PROFILE_FUNCTION();
+
+        CreateCacheDirectoryIfNeeded();
+
+        std::string source = ReadFile(filepath);
+        Compile(Preprocess(source));
+        CreateProgram();
     }
 
 
@@ -124,11 +191,10 @@ namespace Limnova
     {
         LV_PROFILE_FUNCTION();
 
-        std::string source = ReadFile(filepath);
-        auto shaderSources = Preprocess(source);
+        CreateCacheDirectoryIfNeeded();
 
-        CompileOrGetVulkanBinaries(shaderSources);
-        CompileOrGetOpenGLBinaries();
+        std::string source = ReadFile(filepath);
+        Compile(Preprocess(source));
         CreateProgram();
     }
 
@@ -138,16 +204,45 @@ namespace Limnova
     {
         LV_PROFILE_FUNCTION();
 
+        CreateCacheDirectoryIfNeeded();
+
         std::unordered_map<GLenum, std::string> shaderSources;
         shaderSources[GL_VERTEX_SHADER] = vertexSrc;
         shaderSources[GL_FRAGMENT_SHADER] = fragmentSrc;
 
-        CompileOrGetVulkanBinaries(shaderSources);
-        CompileOrGetOpenGLBinaries();
+        Compile(shaderSources);
         CreateProgram();
     }
 
 
+    std::vector<Ref<Shader>> OpenGLShader::Create(const std::vector<std::string>& filepaths)
+    {
+        LV_PROFILE_FUNCTION();
+
+        CreateCacheDirectoryIfNeeded();
+
+        Timer timer;
+
+        /* Compilation needs no GL context, so the shaders compile in parallel; programs are then created on this thread */
+        std::vector<Ref<OpenGLShader>> shaders;
+        for (auto const& filepath : filepaths)
+        {
+            auto& shader = shaders.emplace_back(new OpenGLShader());
+            shader->m_Name = NameFromFilepath(filepath);
+            shader->m_Filepath = filepath;
+        }
+        std::for_each(std::execution::par, shaders.begin(), shaders.end(), [](const Ref<OpenGLShader>& shader) {
+            shader->Compile(shader->Preprocess(shader->ReadFile(shader->m_Filepath)));
+        });
+        for (auto const& shader : shaders) {
+            shader->CreateProgram();
+        }
+
+        LV_CORE_INFO("Created {0} shaders in {1} ms", shaders.size(), timer.ElapsedMillis());
+        return std::vector<Ref<Shader>>(shaders.begin(), shaders.end());
+    }
+
+
     OpenGLShader::~OpenGLShader()
     {
         LV_PROFILE_FUNCTION();
@@ -213,59 +308,76 @@ namespace Limnova
     }
 
 
-    void OpenGLShader::CompileOrGetVulkanBinaries(const std::unordered_map<GLenum, std::string>& sources)
+    std::filesystem::path OpenGLShader::GetCachePath(const char* extension) const
+    {
+        std::stringstream filename;
+        filename << m_Name << '.' << std::hex << std::setw(16) << std::setfill('0') << m_SourceHash << extension;
+        return std::filesystem::path(GetCacheDirectory()) / filename.str();
+    }
+
+
+    void OpenGLShader::Compile(const std::unordered_map<GLenum, std::string>& shaderSources)
     {
         LV_PROFILE_FUNCTION();
 
-        GLuint program = glCreateProgram();
+        Timer timer;
 
-        shaderc::Compiler compiler;
-        shaderc::CompileOptions options;
-        options.SetTargetEnvironment(shaderc_target_env_vulkan,
-            shaderc_env_version_vulkan_1_2);
-        if (kOptimizeShaderc) {
-            options.SetOptimizationLevel(shaderc_optimization_level_performance);
+        m_Sources = shaderSources;
+        m_SourceHash = HashSources(shaderSources);
+
+        /* A cached program binary makes the SPIR-V unnecessary, unless the driver rejects it in CreateProgram() */
+        if (!LoadProgramBinary())
+        {
+            CompileOrGetVulkanBinaries(shaderSources);
+            CompileOrGetOpenGLBinaries();
         }
 
-        std::filesystem::path cacheDirectory = GetCacheDirectory();
+        m_CompileMillis = timer.ElapsedMillis();
+    }
+
+
+    void OpenGLShader::CompileOrGetVulkanBinaries(const std::unordered_map<GLenum, std::string>& sources)
+    {
+        LV_PROFILE_FUNCTION();
+
         auto& shaderData = m_VulkanSPIRV;
         shaderData.clear();
+
+        /* Each stage's entry is created up front so the stages can compile in parallel, each writing only to its own entry */
+        std::vector<GLenum> stages;
         for (auto&& [stage, source] : sources)
         {
-            std::filesystem::path shaderFilepath = m_Filepath;
-            std::filesystem::path cachedPath = cacheDirectory /
-                (shaderFilepath.filename().string() +
-                GLShaderStageCachedVulkanFileExtension(stage));
+            stages.push_back(stage);
+            shaderData[stage];
+        }
+        std::vector<uint8_t> cached(stages.size());
+        std::vector<size_t> stageIndices(stages.size());
+        std::iota(stageIndices.begin(), stageIndices.end(), 0);
+        std::for_each(std::execution::par, stageIndices.begin(), stageIndices.end(), [&](size_t i)
+        {
+            GLenum stage = stages[i];
+            std::filesystem::path cachedPath = GetCachePath(GLShaderStageCachedVulkanFileExtension(stage));
+            auto& data = shaderData.at(stage);
+            cached[i] = ReadCachedSPIRV(cachedPath, data);
+            if (cached[i]) return;
+
+            shaderc::Compiler compiler;
+            shaderc::CompileOptions options;
+            options.SetTargetEnvironment(shaderc_target_env_vulkan,
+                shaderc_env_version_vulkan_1_2);
+            if (kOptimizeShaderc) {
+                options.SetOptimizationLevel(shaderc_optimization_level_performance);
+            }
 
-            std::ifstream in(cachedPath, std::ios::in | std::ios::binary);
-            if (in.is_open())
-            {
-                in.seekg(0, std::ios::end);
-                auto size = in.tellg();
-                in.seekg(0, std::ios::beg);
+            shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(
+                sources.at(stage), GLShaderStageToShaderc(stage), m_Filepath.c_str(), options);
 
-                auto& data = shaderData[stage];
-                data.resize(size / sizeof(uint32_t));
-                in.read((char*)data.data(), size);
-            }
-            else
-            {
-                shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(
-                    source, GLShaderStageToShaderc(stage), m_Filepath.c_str(), options);
-
-                LV_CORE_ASSERT(module.GetCompilationStatus() == shaderc_compilation_status_success, module.GetErrorMessage());
-
-                shaderData[stage] = std::vector<uint32_t>(module.cbegin(), module.cend());
-                std::ofstream out(cachedPath, std::ios::out | std::ios::binary);
-                if (out.is_open())
-                {
-                    auto& data = shaderData[stage];
-                    out.write((char*)data.data(), data.size() * sizeof(uint32_t));
-                    out.flush();
-                    out.close();
-                }
-            }
-        }
+            LV_CORE_ASSERT(module.GetCompilationStatus() == shaderc_compilation_status_success, module.GetErrorMessage());
+
+            data = std::vector<uint32_t>(module.cbegin(), module.cend());
+            WriteCachedSPIRV(cachedPath, data);
+        });
+        m_SPIRVFromCache = std::all_of(cached.begin(), cached.end(), [](uint8_t c) { return c; });
 
         for (auto&& [stage, data] : shaderData) {
             Reflect(stage, data);
@@ -275,67 +387,160 @@ namespace Limnova
 
     void OpenGLShader::CompileOrGetOpenGLBinaries()
     {
+        LV_PROFILE_FUNCTION();
+
         auto& shaderData = m_OpenGLSPIRV;
+        shaderData.clear();
+        m_OpenGLSource.clear();
 
-        shaderc::Compiler compiler;
-        shaderc::CompileOptions options;
-        options.SetTargetEnvironment(shaderc_target_env_opengl,
-            shaderc_env_version_opengl_4_5);
-        if (kOptimizeShaderc) {
-            options.SetOptimizationLevel(shaderc_optimization_level_performance);
+        /* As for the Vulkan binaries, the stages cross-compile in parallel */
+        std::vector<GLenum> stages;
+        for (auto&& [stage, spirv] : m_VulkanSPIRV)
+        {
+            stages.push_back(stage);
+            shaderData[stage];
+            m_OpenGLSource[stage];
         }
+        std::vector<uint8_t> cached(stages.size());
+        std::vector<size_t> stageIndices(stages.size());
+        std::iota(stageIndices.begin(), stageIndices.end(), 0);
+        std::for_each(std::execution::par, stageIndices.begin(), stageIndices.end(), [&](size_t i)
+        {
+            GLenum stage = stages[i];
+            std::filesystem::path cachedPath = GetCachePath(GLShaderStageCachedOpenGLFileExtension(stage));
+            auto& data = shaderData.at(stage);
+            cached[i] = ReadCachedSPIRV(cachedPath, data);
+            if (cached[i]) return;
+
+            spirv_cross::CompilerGLSL glslCompiler(m_VulkanSPIRV.at(stage));
+            auto& source = m_OpenGLSource.at(stage);
+            source = glslCompiler.compile();
+
+            shaderc::Compiler compiler;
+            shaderc::CompileOptions options;
+            options.SetTargetEnvironment(shaderc_target_env_opengl,
+                shaderc_env_version_opengl_4_5);
+            if (kOptimizeShaderc) {
+                options.SetOptimizationLevel(shaderc_optimization_level_performance);
+            }
 
-        std::filesystem::path cacheDirectory = GetCacheDirectory();
+            shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(
+                source, GLShaderStageToShaderc(stage), m_Filepath.c_str());
 
-        shaderData.clear();
-        m_OpenGLSource.clear();
-        for (auto&& [stage, spirv] : m_VulkanSPIRV)
+            LV_CORE_ASSERT(module.GetCompilationStatus() == shaderc_compilation_status_success, module.GetErrorMessage());
+
+            data = std::vector<uint32_t>(module.cbegin(), module.cend());
+            WriteCachedSPIRV(cachedPath, data);
+        });
+        m_SPIRVFromCache = m_SPIRVFromCache && std::all_of(cached.begin(), cached.end(), [](uint8_t c) { return c; });
+    }
+
+
+    bool OpenGLShader::LoadProgramBinary()
+    {
+        LV_PROFILE_FUNCTION();
+
+        m_ProgramBinary.clear();
+
+        std::ifstream in(GetCachePath(kCachedProgramFileExtension), std::ios::in | std::ios::binary);
+        if (!in.is_open()) return false;
+
+        in.seekg(0, std::ios::end);
+        auto size = (size_t)in.tellg();
+        in.seekg(0, std::ios::beg);
+        if (size <= sizeof(uint32_t)) return false;
+
+        /* File layout: the binary format enum followed by the binary */
+        uint32_t format;
+        in.read((char*)&format, sizeof(uint32_t));
+        m_ProgramBinaryFormat = format;
+        m_ProgramBinary.resize(size - sizeof(uint32_t));
+        in.read((char*)m_ProgramBinary.data(), m_ProgramBinary.size());
+        return true;
+    }
+
+
+    bool OpenGLShader::CreateProgramFromBinary()
+    {
+        LV_PROFILE_FUNCTION();
+
+        GLuint program = glCreateProgram();
+        glProgramBinary(program, m_ProgramBinaryFormat, m_ProgramBinary.data(), (GLsizei)m_ProgramBinary.size());
+
+        GLint isLinked;
+        glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+        if (isLinked == GL_FALSE)
         {
-            std::filesystem::path shaderFilepath = m_Filepath;
-            std::filesystem::path cachedPath = cacheDirectory /
-                (shaderFilepath.filename().string() +
-                GLShaderStageCachedOpenGLFileExtension(stage));
+            glDeleteProgram(program);
+            return false;
+        }
 
-            std::ifstream in(cachedPath, std::ios::in | std::ios::binary);
-            if (in.is_open())
-            {
-                in.seekg(0, std::ios::end);
-                auto size = in.tellg();
-                in.seekg(0, std::ios::beg);
+        m_RendererId = program;
+        return true;
+    }
 
-                auto& data = shaderData[stage];
-                data.resize(size / sizeof(uint32_t));
-                in.read((char*)data.data(), size);
-            }
-            else
-            {
-                spirv_cross::CompilerGLSL glslCompiler(spirv);
-                m_OpenGLSource[stage] = glslCompiler.compile();
-                auto& source = m_OpenGLSource[stage];
 
-                shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(
-                    source, GLShaderStageToShaderc(stage), m_Filepath.c_str());
+    void OpenGLShader::SaveProgramBinary()
+    {
+        LV_PROFILE_FUNCTION();
 
-                LV_CORE_ASSERT(module.GetCompilationStatus() == shaderc_compilation_status_success, module.GetErrorMessage());
+        GLint numFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+        if (numFormats == 0) return; /* driver does not support program binaries */
 
-                shaderData[stage] = std::vector<uint32_t>(module.cbegin(), module.cend());
+        GLint length = 0;
+        glGetProgramiv(m_RendererId, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) return;
 
-                std::ofstream out(cachedPath, std::ios::out | std::ios::binary);
-                if (out.is_open())
-                {
-                    auto& data = shaderData[stage];
-                    out.write((char*)data.data(), data.size() * sizeof(uint32_t));
-                    out.flush();
-                    out.close();
-                }
-            }
+        std::vector<uint8_t> binary(length);
+        GLenum format;
+        glGetProgramBinary(m_RendererId, length, nullptr, &format, binary.data());
+
+        std::ofstream out(GetCachePath(kCachedProgramFileExtension), std::ios::out | std::ios::binary);
+        if (out.is_open())
+        {
+            uint32_t formatData = format;
+            out.write((char*)&formatData, sizeof(uint32_t));
+            out.write((char*)binary.data(), binary.size());
+            out.flush();
+            out.close();
         }
     }
 
 
     void OpenGLShader::CreateProgram()
+    {
+        LV_PROFILE_FUNCTION();
+
+        Timer timer;
+
+        const char* cacheResult = "program binary cache";
+        if (m_ProgramBinary.empty() || !CreateProgramFromBinary())
+        {
+            if (!m_ProgramBinary.empty())
+            {
+                /* Rejected by the driver, e.g. after a driver update */
+                LV_CORE_WARN("Cached program binary for shader '{0}' is no longer valid: recompiling!", m_Name);
+                CompileOrGetVulkanBinaries(m_Sources);
+                CompileOrGetOpenGLBinaries();
+            }
+            cacheResult = m_SPIRVFromCache ? "SPIR-V cache" : "compiled";
+
+            if (LinkProgram()) {
+                SaveProgramBinary();
+            }
+        }
+        m_ProgramBinary.clear();
+        m_ProgramBinary.shrink_to_fit();
+
+        LV_CORE_INFO("Shader '{0}' ({1}): compile {2} ms, link {3} ms", m_Name, cacheResult, m_CompileMillis, timer.ElapsedMillis());
+    }
+
+
+    bool OpenGLShader::LinkProgram()
     {
         GLuint program = glCreateProgram();
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
         std::vector<GLuint> shaderIds;
         for (auto&& [stage, spirv] : m_OpenGLSPIRV)
@@ -363,6 +568,8 @@ namespace Limnova
             for (auto id : shaderIds) {
                 glDeleteShader(id);
             }
+            m_RendererId = 0;
+            return false;
         }
 
         for (auto id : shaderIds)
@@ -372,6 +579,7 @@ namespace Limnova
         }
 
         m_RendererId = program;
+        return true;
     }
 
 
@@ -16,6 +16,9 @@ namespace Limnova
         OpenGLShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
         ~OpenGLShader();
 
+        /// <summary> Creates shaders from files, compiling them in parallel </summary>
+        static std::vector<Ref<Shader>> Create(const std::vector<std::string>& filepaths);
+
         const std::string& GetName() const override { return m_Name; }
 
         void Bind() const override;
@@ -43,20 +46,37 @@ namespace Limnova
         void UploadUniformMat3f(const std::string& uniformName, const glm::mat3& matrix);
         void UploadUniformMat4f(const std::string& uniformName, const glm::mat4& matrix);
     private:
+        OpenGLShader() = default;
+
         std::string ReadFile(const std::string& filepath);
         std::unordered_map<GLenum, std::string> Preprocess(const std::string& source);
-        //void Compile(const std::unordered_map<GLenum, std::string>& sources);
+        std::filesystem::path GetCachePath(const char* extension) const;
+
+        // Compilation - needs no GL context, so may run on any thread
+        void Compile(const std::unordered_map<GLenum, std::string>& shaderSources);
         void CompileOrGetVulkanBinaries(const std::unordered_map<GLenum, std::string>& shaderSources);
         void CompileOrGetOpenGLBinaries();
-        void CreateProgram();
+        bool LoadProgramBinary();
         void Reflect(GLenum stage, const std::vector<uint32_t>& shaderData);
+
+        // Program creation - on the GL thread
+        void CreateProgram();
+        bool CreateProgramFromBinary();
+        bool LinkProgram();
+        void SaveProgramBinary();
     private:
-        uint32_t m_RendererId;
+        uint32_t m_RendererId = 0;
         std::string m_Name;
         std::string m_Filepath;
+        std::unordered_map<GLenum, std::string> m_Sources;
+        uint64_t m_SourceHash = 0; /* of the sources and compile targets - names the cache files */
         std::unordered_map<GLenum, std::vector<uint32_t>> m_VulkanSPIRV;
         std::unordered_map<GLenum, std::vector<uint32_t>> m_OpenGLSPIRV;
         std::unordered_map<GLenum, std::string> m_OpenGLSource;
+        std::vector<uint8_t> m_ProgramBinary; /* loaded from the cache, released once the program is created */
+        GLenum m_ProgramBinaryFormat = 0;
+        bool m_SPIRVFromCache = false;
+        float m_CompileMillis = 0.f;
     };
 
 }
@@ -14,19 +14,12 @@ namespace Limnova
     {
         LV_PROFILE_FUNCTION();
 
-        glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererId);
-        glTextureStorage2D(m_RendererId, 1, m_InternalFormat, m_Width, m_Height);
-
-        // TODO : parameters set by user
-        glTextureParameteri(m_RendererId, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTextureParameteri(m_RendererId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        SetWrapMode(Texture::WrapMode::Tile);
+        CreateStorage();
     }
 
 
     OpenGLTexture2D::OpenGLTexture2D(const std::string& path, const WrapMode wrap)
-        : m_Path(path)
+        : m_Path(path), m_WrapMode(wrap)
     {
         LV_PROFILE_FUNCTION();
 
@@ -53,6 +46,16 @@ namespace Limnova
         }
         LV_CORE_ASSERT(m_InternalFormat && m_UsageFormat, "Failed to load image: number of channels not supported!");
 
+        CreateStorage();
+
+        glTextureSubImage2D(m_RendererId, 0, 0, 0, m_Width, m_Height, m_UsageFormat, GL_UNSIGNED_BYTE, data);
+
+        stbi_image_free(data);
+    }
+
+
+    void OpenGLTexture2D::CreateStorage()
+    {
         glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererId);
         glTextureStorage2D(m_RendererId, 1, m_InternalFormat, m_Width, m_Height);
 
@@ -60,11 +63,7 @@ namespace Limnova
         glTextureParameteri(m_RendererId, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTextureParameteri(m_RendererId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-        SetWrapMode(wrap);
-
-        glTextureSubImage2D(m_RendererId, 0, 0, 0, m_Width, m_Height, m_UsageFormat, GL_UNSIGNED_BYTE, data);
-
-        stbi_image_free(data);
+        SetWrapMode(m_WrapMode);
     }
 
 
@@ -96,6 +95,7 @@ namespace Limnova
         case WrapMode::Clamp:        mode = GL_CLAMP_TO_EDGE; break;
         default: LV_CORE_ERROR("Invalid wrap mode!"); mode = GL_REPEAT;
         }
+        m_WrapMode = wrap;
         glTextureParameteri(m_RendererId, GL_TEXTURE_WRAP_S, mode);
         glTextureParameteri(m_RendererId, GL_TEXTURE_WRAP_T, mode);
     }
@@ -109,4 +109,33 @@ namespace Limnova
         glTextureSubImage2D(m_RendererId, 0, 0, 0, m_Width, m_Height, m_UsageFormat, GL_UNSIGNED_BYTE, data);
     }
 
+
+
+    void OpenGLTexture2D::SetSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+    {
+        LV_PROFILE_FUNCTION();
+
+        LV_CORE_ASSERT(x + width <= m_Width && y + height <= m_Height, "Sub-image must lie within the texture!");
+        glTextureSubImage2D(m_RendererId, 0, x, y, width, height, m_UsageFormat, GL_UNSIGNED_BYTE, data);
+    }
+
+
+
+    void OpenGLTexture2D::SetImage(const void* data, uint32_t width, uint32_t height, uint32_t channels)
+    {
+        LV_PROFILE_FUNCTION();
+
+        LV_CORE_ASSERT(channels == 3 || channels == 4, "Number of channels not supported!");
+        m_Width = width;
+        m_Height = height;
+        m_InternalFormat = channels == 4 ? GL_RGBA8 : GL_RGB8;
+        m_UsageFormat = channels == 4 ? GL_RGBA : GL_RGB;
+
+        /* Texture storage is immutable, so a differently-sized image needs a new texture object */
+        glDeleteTextures(1, &m_RendererId);
+        CreateStorage();
+
+        glTextureSubImage2D(m_RendererId, 0, 0, 0, m_Width, m_Height, m_UsageFormat, GL_UNSIGNED_BYTE, data);
+    }
+
 }
@@ -22,17 +22,22 @@ namespace Limnova
         void SetWrapMode(const WrapMode wrap) override;
 
         void SetData(void* data, uint32_t size) override;
+        void SetSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+        void SetImage(const void* data, uint32_t width, uint32_t height, uint32_t channels) override;
 
         bool operator==(const Texture& other) const override
         {
             return m_RendererId == ((OpenGLTexture2D&)other).m_RendererId;
         }
+    private:
+        void CreateStorage();
     private:
         std::string m_Path; // TODO : move to asset manager
         uint32_t m_RendererId;
         uint32_t m_Width, m_Height;
         uint32_t m_InternalFormat;
         uint32_t m_UsageFormat;
+        WrapMode m_WrapMode = WrapMode::Tile;
     };
 
 }
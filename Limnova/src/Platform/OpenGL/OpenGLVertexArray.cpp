@@ -21,6 +21,10 @@ namespace Limnova
             case ShaderDataType::Bool:      return GL_BOOL;
             case ShaderDataType::Mat3:      return GL_FLOAT;
             case ShaderDataType::Mat4:      return GL_FLOAT;
+            case ShaderDataType::Half:      return GL_HALF_FLOAT;
+            case ShaderDataType::Half2:     return GL_HALF_FLOAT;
+            case ShaderDataType::Half4:     return GL_HALF_FLOAT;
+            case ShaderDataType::UByte4:    return GL_UNSIGNED_BYTE;
         }
         LV_CORE_ASSERT(false, "ShaderDataTypeToOpenGLBaseType() was passd an unknown ShaderDataType!");
         return 0;
@@ -68,6 +72,7 @@ namespace Limnova
         vertexBuffer->Bind();
 
         const auto& layout = vertexBuffer->GetLayout();
+        uint32_t divisor = layout.IsPerInstance() ? 1 : 0;
         for (const auto& element : layout)
         {
             switch (element.Type)
@@ -76,6 +81,10 @@ namespace Limnova
             case ShaderDataType::Float2:
             case ShaderDataType::Float3:
             case ShaderDataType::Float4:
+            case ShaderDataType::Half:
+            case ShaderDataType::Half2:
+            case ShaderDataType::Half4:
+            case ShaderDataType::UByte4:
             {
                 glEnableVertexAttribArray(m_VertexBufferIndex);
                 glVertexAttribPointer(m_VertexBufferIndex,
@@ -84,6 +93,7 @@ namespace Limnova
                     element.Normalized ? GL_TRUE : GL_FALSE,
                     layout.GetStride(),
                     (const void*)element.Offset);
+                glVertexAttribDivisor(m_VertexBufferIndex, divisor);
                 m_VertexBufferIndex++;
                 break;
             }
@@ -99,6 +109,7 @@ namespace Limnova
                     ShaderDataTypeToOpenGLBaseType(element.Type),
                     layout.GetStride(),
                     (const void*)element.Offset);
+                glVertexAttribDivisor(m_VertexBufferIndex, divisor);
                 m_VertexBufferIndex++;
                 break;
             }
@@ -33,6 +33,20 @@ namespace Limnova
     }
 
 
+    // StreamingVertexBuffer ///////////////////////////////////////////////////
+
+    Ref<StreamingVertexBuffer> StreamingVertexBuffer::Create(uint32_t regionSize, uint32_t numRegions)
+    {
+        switch (Renderer::GetAPI())
+        {
+            case RendererAPI::API::None: LV_CORE_ASSERT(false, "RendererAPI::None is not supported!"); return nullptr;
+            case RendererAPI::API::OpenGL: return CreateRef<OpenGLStreamingVertexBuffer>(regionSize, numRegions);
+        }
+        LV_CORE_ASSERT(false, "Renderer::GetAPI() returned unknown RendererAPI!");
+        return nullptr;
+    }
+
+
     // IndexBuffer /////////////////////////////////////////////////////////////
 
     Ref<IndexBuffer> IndexBuffer::Create(uint32_t* indices, uint32_t count)
@@ -78,6 +92,10 @@ namespace Limnova
             case ShaderDataType::Mat3:      return 3 * 3;
             case ShaderDataType::Mat4:      return 4 * 4;
             case ShaderDataType::Bool:      return 1;
+            case ShaderDataType::Half:      return 1;
+            case ShaderDataType::Half2:     return 2;
+            case ShaderDataType::Half4:     return 4;
+            case ShaderDataType::UByte4:    return 4;
         }
         LV_CORE_ASSERT(false, "GetElementCount() was called on a BufferElement with an unknown ShaderDataType!");
         return 0;
@@ -10,7 +10,9 @@ namespace Limnova
         Float, Float2, Float3, Float4,
         Int, Int2, Int3, Int4,
         Mat3, Mat4,
-        Bool
+        Bool,
+        Half, Half2, Half4,     /* 16-bit floats - read by shaders as float vectors */
+        UByte4                  /* 8-bit unsigned components - read as vec4, in [0, 1] if the element is normalized */
     };
 
 
@@ -29,6 +31,10 @@ namespace Limnova
         case ShaderDataType::Mat3:      return 4 * 3 * 3;
         case ShaderDataType::Mat4:      return 4 * 4 * 4;
         case ShaderDataType::Bool:      return 1;
+        case ShaderDataType::Half:      return 2;
+        case ShaderDataType::Half2:     return 2 * 2;
+        case ShaderDataType::Half4:     return 2 * 4;
+        case ShaderDataType::UByte4:    return 4;
         }
         LV_CORE_ASSERT(false, "ShaderDataTypeSize() was passed an unknown ShaderDataType!");
         return 0;
@@ -58,16 +64,18 @@ namespace Limnova
     class BufferLayout
     {
     public:
-        BufferLayout() : m_Stride(0)
+        BufferLayout() : m_Stride(0), m_PerInstance(false)
         {
         }
-        BufferLayout(const std::initializer_list<BufferElement>& elements)
-            : m_Elements(elements), m_Stride(0)
+        /// <param name="perInstance">If true, the elements advance once per instance rather than once per vertex</param>
+        BufferLayout(const std::initializer_list<BufferElement>& elements, bool perInstance = false)
+            : m_Elements(elements), m_Stride(0), m_PerInstance(perInstance)
         {
             CalculateOffsetsAndStride();
         }
 
         inline uint32_t GetStride() const { return m_Stride; }
+        inline bool IsPerInstance() const { return m_PerInstance; }
         inline const std::vector<BufferElement>& GetElements() const { return m_Elements; };
 
         std::vector<BufferElement>::iterator begin() { return m_Elements.begin(); }
@@ -79,6 +87,7 @@ namespace Limnova
     private:
         std::vector<BufferElement> m_Elements;
         uint32_t m_Stride;
+        bool m_PerInstance;
     };
 
 
@@ -99,6 +108,31 @@ namespace Limnova
         virtual void SetLayout(const BufferLayout& layout) = 0;
     };
 
+
+    /// <summary>
+    /// Vertex buffer for data rewritten every batch: a ring of regions kept mapped in client memory, so vertices are written
+    /// directly into the buffer instead of being staged and copied. Each region is fenced after the draws which read it, and is
+    /// only handed out again once the GPU has finished with it - so writes never stall on the draw in flight.
+    /// Draws must read the current region by offsetting their first vertex (or instance) by GetRegionOffset().
+    /// </summary>
+    class StreamingVertexBuffer : public VertexBuffer
+    {
+    public:
+        static constexpr uint32_t kDefaultNumRegions = 3;
+
+        static Ref<StreamingVertexBuffer> Create(uint32_t regionSize, uint32_t numRegions = kDefaultNumRegions);
+
+        /// <summary> Waits, if necessary, until the GPU has finished reading the current region </summary>
+        /// <returns>Pointer to the start of the current region, valid until EndRegion()</returns>
+        virtual void* BeginRegion() = 0;
+        /// <summary> Fences the current region after all draws submitted so far, and advances to the next region </summary>
+        virtual void EndRegion() = 0;
+
+        /// <returns>Offset in bytes of the current region from the start of the buffer</returns>
+        virtual uint32_t GetRegionOffset() const = 0;
+        virtual uint32_t GetRegionSize() const = 0;
+    };
+
     // Currently only supports 32-bit index buffers
     class IndexBuffer
     {
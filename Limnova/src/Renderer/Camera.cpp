@@ -31,6 +31,60 @@ namespace Limnova
     }
 
 
+    Camera::Frustum Camera::GetFrustum()
+    {
+        /* Gribb-Hartmann plane extraction from the rows of the view-projection matrix, for zero-to-one clip depth */
+        glm::mat4 m = m_Projection.mat * m_View.mat;
+        auto row = [&m](int i) { return glm::vec4{ m[0][i], m[1][i], m[2][i], m[3][i] }; };
+
+        std::array<glm::vec4, 6> planes = {
+            row(3) + row(0),
+            row(3) - row(0),
+            row(3) + row(1),
+            row(3) - row(1),
+            row(2),
+            row(3) - row(2)
+        };
+
+        Frustum frustum;
+        for (size_t i = 0; i < planes.size(); i++) {
+            frustum.Planes[i] = planes[i] / glm::length(glm::vec3{ planes[i] });
+        }
+        return frustum;
+    }
+
+
+    bool Camera::Frustum::IntersectsSphere(const Vector3& center, float radius) const
+    {
+        for (auto& plane : Planes) {
+            if (plane.XYZ().Dot(center) + plane.w < -radius) return false;
+        }
+        return true;
+    }
+
+
+    float Camera::GetScreenSize(const Vector3& center, float radius)
+    {
+        /* Clip-space w is the view depth for perspective projections and 1 for orthographic projections */
+        glm::vec4 clipCenter = m_Projection.mat * (m_View.mat * glm::vec4{ (glm::vec3)center, 1.f });
+        float w = std::max(clipCenter.w, 1e-6f);
+        return radius * m_Projection.mat[1][1] / w;
+    }
+
+
+    void Camera::GetRay(const Vector2& ndc, Vector3& origin, Vector3& direction)
+    {
+        glm::mat4 inverseViewProj = glm::inverse(m_Projection.mat * m_View.mat);
+        glm::vec4 nearPoint = inverseViewProj * glm::vec4{ ndc.x, ndc.y, 0.f, 1.f };
+        glm::vec4 farPoint = inverseViewProj * glm::vec4{ ndc.x, ndc.y, 1.f, 1.f };
+        glm::vec3 start = glm::vec3{ nearPoint } / nearPoint.w;
+        glm::vec3 end = glm::vec3{ farPoint } / farPoint.w;
+
+        origin = start;
+        direction = glm::normalize(end - start);
+    }
+
+
     void Camera::SetView(const Vector3& position, const Vector3& aimDirection, const Vector3& upDirection)
     {
         LV_PROFILE_FUNCTION();
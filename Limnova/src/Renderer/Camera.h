@@ -34,6 +34,27 @@ namespace Limnova
 
         const Matrix4& GetProjection() { return m_Projection; }
         const Matrix4& GetView() { return m_View; }
+
+        /// <summary>
+        /// The six planes bounding the camera's view volume, in world space. Each plane is stored as (normal, distance) with the normal
+        /// pointing into the volume, so a point P is inside a plane when Dot(normal, P) + distance >= 0.
+        /// </summary>
+        struct Frustum
+        {
+            std::array<Vector4, 6> Planes; /* Left, right, bottom, top, near, far */
+
+            bool IntersectsSphere(const Vector3& center, float radius) const;
+        };
+        Frustum GetFrustum();
+
+        /// <summary>
+        /// Projected diameter of a world-space sphere as a fraction of the viewport height (1 = fills the viewport vertically).
+        /// Only valid for spheres in front of the camera.
+        /// </summary>
+        float GetScreenSize(const Vector3& center, float radius);
+
+        /// <summary> World-space ray from the camera through a point in normalized device coordinates (-1 to 1, Y up) </summary>
+        void GetRay(const Vector2& ndc, Vector3& origin, Vector3& direction);
     private:
         virtual Data const* GetData();
         void RecomputeData();
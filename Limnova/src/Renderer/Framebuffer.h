@@ -51,6 +51,15 @@ namespace Limnova
     };
 
 
+    /// <summary> A rectangle of an integer color attachment, read back asynchronously </summary>
+    struct FramebufferReadback
+    {
+        uint32_t Id = 0; /* as returned by Framebuffer::RequestReadback() */
+        uint32_t X = 0, Y = 0, Width = 0, Height = 0;
+        std::vector<int> Pixels; /* Width*Height values, row by row from the bottom */
+    };
+
+
     class Framebuffer
     {
     public:
@@ -69,7 +78,23 @@ namespace Limnova
 
         virtual void ClearAttachment(uint32_t attachmentIndex, int clearValue) = 0;
 
+        /// <summary> Reads one pixel of an integer attachment - waits for the GPU to finish drawing to the framebuffer </summary>
         virtual int ReadPixel(uint32_t x, uint32_t y, uint32_t attachmentIndex = 0) const = 0;
+
+        /// <summary>
+        /// Starts reading a rectangle of an integer attachment without waiting for the GPU. The rectangle is clipped to the framebuffer.
+        /// Results are collected with PollReadback(), usually one or two frames later. A few readbacks can be in flight at once -
+        /// beyond that, the oldest uncollected readback is dropped.
+        /// </summary>
+        /// <returns>Readback ID, or 0 if the rectangle lies outside the framebuffer</returns>
+        virtual uint32_t RequestReadback(uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t attachmentIndex = 0) = 0;
+        /// <summary> Collects the oldest readback, if the GPU has completed it. Call repeatedly to collect all completed readbacks </summary>
+        /// <returns>False if no readback has completed</returns>
+        virtual bool PollReadback(FramebufferReadback& readback) = 0;
+        /// <returns>True if the readback has been requested but not yet collected (nor dropped, nor failed)</returns>
+        virtual bool IsReadbackPending(uint32_t id) const = 0;
+        /// <summary> Drops every readback which has not yet been collected - e.g, when the attachment's contents no longer mean what they did when read </summary>
+        virtual void DiscardReadbacks() = 0;
     };
 
 }
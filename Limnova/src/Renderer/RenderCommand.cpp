@@ -39,9 +39,15 @@ namespace Limnova
     }
 
 
-    void RenderCommand::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount)
+    void RenderCommand::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t baseVertex)
     {
-        s_RendererApi->DrawIndexed(vertexArray, indexCount);
+        s_RendererApi->DrawIndexed(vertexArray, indexCount, baseVertex);
+    }
+
+
+    void RenderCommand::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance)
+    {
+        s_RendererApi->DrawIndexedInstanced(vertexArray, indexCount, instanceCount, baseInstance);
     }
 
 }
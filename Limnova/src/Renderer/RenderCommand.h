@@ -16,7 +16,8 @@ namespace Limnova
         static void Clear();
 
         static void DrawIndexed(const Ref<VertexArray>& vertexArray);
-        static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount);
+        static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t baseVertex = 0);
+        static void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance = 0);
     private:
         static RendererAPI* s_RendererApi;
     };
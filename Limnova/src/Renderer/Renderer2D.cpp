@@ -3,16 +3,43 @@
 #include "VertexArray.h"
 #include "Shader.h"
 
+#include <Core/Timer.h>
+#include <Structures/RadixSort.h>
+
+#include <glm/glm/gtc/packing.hpp>
+
 
 namespace Limnova
 {
 
+    /* Vertex and instance data is rewritten every frame, so attributes are packed as tightly as their precision allows:
+     * colors are RGBA8 (ShaderDataType::UByte4, normalized) and attributes confined to small ranges - local coordinates
+     * of unit shapes, fractions of their size - are half floats (ShaderDataType::Half*). Shaders read both as floats.
+     * Anything in world units keeps full precision: orbits span many orders of magnitude. */
+
+    /// <returns>Color packed as RGBA8 - components are clamped to [0, 1]</returns>
+    static uint32_t PackColor(const Vector4& color)
+    {
+        return glm::packUnorm4x8((glm::vec4)color);
+    }
+
+    static uint32_t PackHalf2(const float x, const float y)
+    {
+        return glm::packHalf2x16({ x, y });
+    }
+
+    static uint16_t PackHalf(const float value)
+    {
+        return glm::packHalf1x16(value);
+    }
+
+
     struct QuadVertex
     {
         Vector3 Position;
-        Vector4 Color;
-        Vector2 TexCoord;
-        Vector2 TexScale;
+        uint32_t Color;         /* RGBA8 */
+        Vector2 TexCoord;       /* full precision: atlas regions must land on texel boundaries */
+        uint32_t TexScale;      /* half2 */
         float TexIndex;
 
         // Editor only
@@ -23,10 +50,10 @@ namespace Limnova
     struct CircleVertex
     {
         Vector3 WorldPosition;
-        Vector2 LocalPosition;
-        Vector4 Color;
-        float Thickness;
-        float Fade;
+        uint32_t LocalPosition; /* half2 */
+        uint32_t Color;         /* RGBA8 */
+        uint16_t Thickness;     /* half */
+        uint16_t Fade;          /* half */
 
         // Editor only
         int EntityId;
@@ -37,7 +64,7 @@ namespace Limnova
     {
         Vector3 WorldPosition;
         Vector2 LocalPosition;
-        Vector4 Color;
+        uint32_t Color;         /* RGBA8 */
         float SemiMajorAxis;
         float SemiMinorAxis;
         Vector2 CutoffPoint;
@@ -54,7 +81,7 @@ namespace Limnova
     {
         Vector3 WorldPosition;
         Vector2 LocalPosition;
-        Vector4 Color;
+        uint32_t Color;         /* RGBA8 */
         float SemiMajorAxis;
         float SemiMinorAxis;
         Vector2 CutoffPoint;
@@ -70,8 +97,8 @@ namespace Limnova
     struct LineVertex
     {
         Vector3 WorldPosition;
-        Vector2 LocalPosition;
-        Vector4 Color;
+        uint32_t LocalPosition; /* half2 */
+        uint32_t Color;         /* RGBA8 */
         float Length;
         float Thickness;
         float DashLength;
@@ -82,20 +109,129 @@ namespace Limnova
     };
 
 
+    /* Instanced primitives: a shared unit quad (corners at +/-1) is placed in the world by each instance's center and
+     * half-axes, and everything else which the batched vertices duplicate four times is stored once per instance */
+
+    struct CircleInstance
+    {
+        Vector3 Center;
+        Vector3 HalfAxisX;
+        Vector3 HalfAxisY;
+        uint32_t Color;         /* RGBA8 */
+        uint16_t Thickness;     /* half */
+        uint16_t Fade;          /* half */
+
+        // Editor only
+        int EntityId;
+    };
+
+
+    struct EllipseInstance
+    {
+        Vector3 Center;
+        Vector3 HalfAxisX;
+        Vector3 HalfAxisY;
+        Vector2 PerifocalExtent; /* perifocal-frame position of the quad's (+1, +1) corner */
+        uint32_t Color;         /* RGBA8 */
+        float SemiMajorAxis;
+        float SemiMinorAxis;
+        Vector2 CutoffPoint;
+        Vector2 CutoffNormal;
+        float Thickness;
+        float Fade;
+
+        // Editor only
+        int EntityId;
+    };
+
+
+    struct LineInstance
+    {
+        Vector3 Center;
+        Vector3 HalfAxisX;
+        Vector3 HalfAxisY;
+        uint32_t Color;         /* RGBA8 */
+        float Length;
+        float Thickness;
+        float DashLength;
+        float GapLength;
+
+        // Editor only
+        int EntityId;
+    };
+
+
+    /// <summary>
+    /// Record list which a recorded primitive is in. Each has its own shader, so the render queue groups primitives by it.
+    /// </summary>
+    enum class RecordType : uint32_t { Quad = 0, Circle, CircleInstance, Ellipse, EllipseInstance, Hyperbola, Line, LineInstance };
+    static constexpr uint32_t kRecordTypeShift = 29; /* QueueEntry::Record bits above this are the RecordType, below it the primitive's index in its list */
+
+
+    /// <summary>
+    /// Primitives recorded by one thread, in the same vertex and instance formats as the batches so that merging them is a copy.
+    /// </summary>
+    struct Renderer2D::CommandBuffer
+    {
+        /// <summary> One recorded primitive, as ordered by the render queue </summary>
+        struct QueueEntry
+        {
+            float Depth;        /* view-space depth - distance in front of the camera along its aim direction */
+            uint32_t Record;    /* RecordType and primitive index - see kRecordTypeShift */
+            uint16_t Texture;   /* index in Textures - 0 for untextured primitives */
+            uint8_t Layer;
+            bool Transparent;
+        };
+        std::vector<QueueEntry> Entries;
+
+        std::vector<QuadVertex> QuadVertices;
+        std::vector<Ref<Texture2D>> Textures; /* recorded quads' TexIndex values index this list rather than the texture slots - 0 = white texture */
+        std::vector<float> TextureSlots; /* scratch for merging: slot of each recorded texture in the current quad batch, or -1 */
+
+        std::vector<CircleVertex> CircleVertices;
+        std::vector<CircleInstance> CircleInstances;
+        std::vector<EllipseVertex> EllipseVertices;
+        std::vector<EllipseInstance> EllipseInstances;
+        std::vector<HyperbolaVertex> HyperbolaVertices;
+        std::vector<LineVertex> LineVertices;
+        std::vector<LineInstance> LineInstances;
+
+        Renderer2D::Statistics Stats;
+
+        void Clear()
+        {
+            Entries.clear();
+            QuadVertices.clear();
+            Textures.assign(1, nullptr);
+            CircleVertices.clear();
+            CircleInstances.clear();
+            EllipseVertices.clear();
+            EllipseInstances.clear();
+            HyperbolaVertices.clear();
+            LineVertices.clear();
+            LineInstances.clear();
+            memset(&Stats, 0, sizeof(Renderer2D::Statistics));
+        }
+    };
+
+
     struct Renderer2DData
     {
         // Camera
         const Camera::Data* CameraData = nullptr;
+        Matrix4 CameraView;
         Ref<UniformBuffer> SceneUniformBuffer;
 
+        // Batch capacities, in primitives - each grows when a scene needed more than one batch, up to the limit
+        uint32_t BatchCapacityLimit = 65536;
+
         // Quads
-        const uint32_t MaxQuads = 4096;
-        const uint32_t MaxQuadVertices = MaxQuads * 4;
-        const uint32_t MaxQuadIndices = MaxQuads * 6;
+        uint32_t MaxQuads = 4096;
+        uint32_t QuadSceneCount = 0;
         static const uint32_t MaxTextureSlots = 32; // TODO : set with render capabilities
 
         Ref<VertexArray> QuadVertexArray;
-        Ref<VertexBuffer> QuadVertexBuffer;
+        Ref<StreamingVertexBuffer> QuadVertexBuffer;
         Ref<Shader> QuadShader;
         Ref<Texture2D> WhiteTexture;
 
@@ -110,39 +246,68 @@ namespace Limnova
 
         Renderer2D::Statistics Stats;
 
+        // Command buffers - acquired for the current scene in this order, which is the order they are merged in at EndScene
+        std::vector<Scope<Renderer2D::CommandBuffer>> CommandBuffers;
+        uint32_t NumCommandBuffers = 0;
+
+        // Render queue - while active, every primitive of the scene is recorded, then sorted and batched at EndScene
+        /* Off by default: recording stages every primitive in CPU memory before it is copied to the mapped batches, which only pays
+         * off when the scene needs the sorted order (transparency across types, or many texture/shader switches) */
+        bool UseRenderQueue = false;
+        bool QueueActive = false; /* UseRenderQueue as of BeginScene, until EndScene */
+        Renderer2D::CommandBuffer Queue;
+        std::vector<SortKeyIndex> QueueKeys, QueueKeysScratch;
+
+        // Instancing
+        bool UseInstancing = true;
+        Ref<VertexBuffer> UnitQuadVertexBuffer;
+
         // Circles
-        const uint32_t MaxCircles = 4096;
-        const uint32_t MaxCircleVertices = MaxCircles * 4;
-        const uint32_t MaxCircleIndices = MaxCircles * 6;
+        uint32_t MaxCircles = 4096;
+        uint32_t CircleSceneCount = 0;
 
         Ref<VertexArray> CircleVertexArray;
-        Ref<VertexBuffer> CircleVertexBuffer;
+        Ref<StreamingVertexBuffer> CircleVertexBuffer;
         Ref<Shader> CircleShader;
 
         uint32_t CircleIndexCount = 0;
         CircleVertex* CircleVertexBufferBase = nullptr;
         CircleVertex* CircleVertexBufferPtr = nullptr;
 
+        Ref<VertexArray> CircleInstanceVertexArray;
+        Ref<StreamingVertexBuffer> CircleInstanceBuffer;
+        Ref<Shader> CircleInstanceShader;
+
+        uint32_t CircleInstanceCount = 0;
+        CircleInstance* CircleInstanceBufferBase = nullptr;
+        CircleInstance* CircleInstanceBufferPtr = nullptr;
+
         // Ellipses
-        const uint32_t MaxEllipses = 1024;
-        const uint32_t MaxEllipseVertices = MaxEllipses * 4;
-        const uint32_t MaxEllipseIndices = MaxEllipses * 6;
+        uint32_t MaxEllipses = 1024;
+        uint32_t EllipseSceneCount = 0;
 
         Ref<VertexArray> EllipseVertexArray;
-        Ref<VertexBuffer> EllipseVertexBuffer;
+        Ref<StreamingVertexBuffer> EllipseVertexBuffer;
         Ref<Shader> EllipseShader;
 
         uint32_t EllipseIndexCount = 0;
         EllipseVertex* EllipseVertexBufferBase = nullptr;
         EllipseVertex* EllipseVertexBufferPtr = nullptr;
 
+        Ref<VertexArray> EllipseInstanceVertexArray;
+        Ref<StreamingVertexBuffer> EllipseInstanceBuffer;
+        Ref<Shader> EllipseInstanceShader;
+
+        uint32_t EllipseInstanceCount = 0;
+        EllipseInstance* EllipseInstanceBufferBase = nullptr;
+        EllipseInstance* EllipseInstanceBufferPtr = nullptr;
+
         // Hyperbolas
-        const uint32_t MaxHyperbolas = 1024;
-        const uint32_t MaxHyperbolaVertices = MaxHyperbolas * 3;
-        const uint32_t MaxHyperbolaIndices = MaxHyperbolas * 3;
+        uint32_t MaxHyperbolas = 1024;
+        uint32_t HyperbolaSceneCount = 0;
 
         Ref<VertexArray> HyperbolaVertexArray;
-        Ref<VertexBuffer> HyperbolaVertexBuffer;
+        Ref<StreamingVertexBuffer> HyperbolaVertexBuffer;
         Ref<Shader> HyperbolaShader;
 
         uint32_t HyperbolaIndexCount = 0;
@@ -152,18 +317,25 @@ namespace Limnova
         Vector4 HyperbolaVertexPositions[3];
 
         // Lines
-        const uint32_t MaxLines = 1024;
-        const uint32_t MaxLineVertices = MaxLines * 4;
-        const uint32_t MaxLineIndices = MaxLines * 6;
+        uint32_t MaxLines = 1024;
+        uint32_t LineSceneCount = 0;
 
         Ref<VertexArray> LineVertexArray;
-        Ref<VertexBuffer> LineVertexBuffer;
+        Ref<StreamingVertexBuffer> LineVertexBuffer;
         Ref<Shader> LineShader;
 
         uint32_t LineIndexCount = 0;
         LineVertex* LineVertexBufferBase = nullptr;
         LineVertex* LineVertexBufferPtr = nullptr;
 
+        Ref<VertexArray> LineInstanceVertexArray;
+        Ref<StreamingVertexBuffer> LineInstanceBuffer;
+        Ref<Shader> LineInstanceShader;
+
+        uint32_t LineInstanceCount = 0;
+        LineInstance* LineInstanceBufferBase = nullptr;
+        LineInstance* LineInstanceBufferPtr = nullptr;
+
         // Orbit resources
         //Ref<VertexArray> HyperbolaVertexArray2;
         //Ref<Shader> HyperbolaShader2;
@@ -174,6 +346,10 @@ namespace Limnova
 
     static Renderer2DData s_Data;
 
+    /* Command buffer which the calling thread's Draw functions record into, instead of writing to the batches */
+    static thread_local Renderer2D::CommandBuffer* s_RecordingBuffer = nullptr;
+    static thread_local uint8_t s_Layer = 0;
+
 
     struct OrbitData
     {
@@ -192,31 +368,187 @@ namespace Limnova
     static OrbitData* s_OrbitData;
 
 
-    void Renderer2D::Init()
+    /// <summary>
+    /// Decomposes a quad transform into the quad's world-space center and half-axes, as used by instanced primitives.
+    /// </summary>
+    static void GetQuadAxes(const Matrix4& transform, Vector3& center, Vector3& halfAxisX, Vector3& halfAxisY)
     {
-        LV_PROFILE_FUNCTION();
+        center = (transform * Vector4{ 0.f, 0.f, 0.f, 1.f }).XYZ();
+        halfAxisX = (transform * Vector4{ 0.5f, 0.f, 0.f, 0.f }).XYZ();
+        halfAxisY = (transform * Vector4{ 0.f, 0.5f, 0.f, 0.f }).XYZ();
+    }
+
+
+    /// <returns>Statistics of the calling thread's command buffer if it is recording, otherwise the scene's statistics</returns>
+    static Renderer2D::Statistics& CurrentStatistics()
+    {
+        return s_RecordingBuffer ? s_RecordingBuffer->Stats : s_Data.Stats;
+    }
+
+
+    /// <returns>Command buffer which the calling thread's Draw calls record into, or null if they write directly to the batches</returns>
+    static Renderer2D::CommandBuffer* Recorder()
+    {
+        if (s_RecordingBuffer) return s_RecordingBuffer;
+        return s_Data.QueueActive ? &s_Data.Queue : nullptr;
+    }
+
+
+    static void RecordQueueEntry(Renderer2D::CommandBuffer& buffer, RecordType type, size_t primitiveIndex, const Matrix4& transform, bool transparent, float textureIndex = 0.f)
+    {
+        auto& entry = buffer.Entries.emplace_back();
+        Vector3 center = { transform.mat[3][0], transform.mat[3][1], transform.mat[3][2] };
+        entry.Depth = -(s_Data.CameraView * Vector4{ center, 1.f }).z;
+        entry.Record = ((uint32_t)type << kRecordTypeShift) | (uint32_t)primitiveIndex;
+        entry.Texture = (uint16_t)textureIndex;
+        entry.Layer = s_Layer;
+        entry.Transparent = transparent;
+    }
+
+
+    /// <summary>
+    /// Render queue sort key, most significant first: layer (8 bits), transparent (1), then
+    /// - opaque: record type (3), texture (16), depth front-to-back (32). Grouping by shader and texture minimizes state changes,
+    ///   and the depth test resolves visibility between opaque primitives in any order.
+    /// - transparent: depth back-to-front (32), record type (3), texture (16). Blending needs the furthest drawn first, so state is
+    ///   only grouped among primitives at equal depth.
+    /// </summary>
+    static uint64_t QueueSortKey(const Renderer2D::CommandBuffer::QueueEntry& entry)
+    {
+        /* Map the float's bits to an unsigned integer with the same ordering (depths behind the camera are negative) */
+        uint32_t depthBits;
+        std::memcpy(&depthBits, &entry.Depth, sizeof(float));
+        depthBits = (depthBits & 0x80000000u) ? ~depthBits : (depthBits | 0x80000000u);
+
+        uint64_t key = (uint64_t)entry.Layer << 56;
+        uint64_t type = entry.Record >> kRecordTypeShift;
+        if (!entry.Transparent) {
+            return key | (type << 48) | ((uint64_t)entry.Texture << 32) | (uint64_t)depthBits;
+        }
+        return key | (1ull << 55) | ((uint64_t)(uint32_t)~depthBits << 19) | (type << 16) | (uint64_t)entry.Texture;
+    }
+
+
+    /// <summary>
+    /// Copies whole primitives' records into a batch, flushing the batch whenever it is full.
+    /// </summary>
+    /// <param name="countPerPrimitive">Amount each primitive adds to batchCount - indices, or 1 for instances</param>
+    /// <param name="maxCount">Capacity of the batch, in the same units as batchCount</param>
+    template<typename TRecord, typename TFlush>
+    static void CopyToBatch(const TRecord* records, size_t numPrimitives, uint32_t recordsPerPrimitive, uint32_t countPerPrimitive, uint32_t maxCount,
+        TRecord*& batchPtr, uint32_t& batchCount, uint32_t& sceneCount, TFlush&& flushAndReset)
+    {
+        while (numPrimitives > 0)
+        {
+            if (maxCount - batchCount < countPerPrimitive) {
+                flushAndReset();
+            }
+            size_t n = std::min<size_t>((maxCount - batchCount) / countPerPrimitive, numPrimitives);
+            memcpy(batchPtr, records, n * recordsPerPrimitive * sizeof(TRecord));
+            records += n * recordsPerPrimitive;
+            batchPtr += n * recordsPerPrimitive;
+            batchCount += (uint32_t)n * countPerPrimitive;
+            sceneCount += (uint32_t)n;
+            numPrimitives -= n;
+        }
+    }
+
+
+    /// <summary> Adds the statistics which a command buffer's Draw calls counted to the scene's </summary>
+    static void MergeStatistics(const Renderer2D::Statistics& recorded)
+    {
+        s_Data.Stats.ItemsDrawn += recorded.ItemsDrawn;
+        s_Data.Stats.ItemsCulled += recorded.ItemsCulled;
+        auto mergePrimitive = [](Renderer2D::PrimitiveStatistics& scene, Renderer2D::PrimitiveStatistics const& primitive) {
+            scene.Count += primitive.Count;
+            scene.DrawMillis += primitive.DrawMillis;
+        };
+        mergePrimitive(s_Data.Stats.Quads, recorded.Quads);
+        mergePrimitive(s_Data.Stats.Circles, recorded.Circles);
+        mergePrimitive(s_Data.Stats.Ellipses, recorded.Ellipses);
+        mergePrimitive(s_Data.Stats.Hyperbolas, recorded.Hyperbolas);
+        mergePrimitive(s_Data.Stats.Lines, recorded.Lines);
+    }
+
+
+    /// <returns>Space for the given number of records appended to a command buffer's list</returns>
+    template<typename T>
+    static T* RecordPrimitive(std::vector<T>& records, size_t numRecords)
+    {
+        size_t first = records.size();
+        records.resize(first + numRecords);
+        return records.data() + first;
+    }
+
+
+    /// <returns>Index of the texture in the quad batch's texture slots, or in the recording command buffer's texture list</returns>
+    float Renderer2D::GetTextureIndex(const Ref<Texture2D>& texture)
+    {
+        if (auto* recorder = Recorder())
+        {
+            auto& textures = recorder->Textures;
+            for (uint32_t i = 1; i < textures.size(); i++)
+            {
+                if (*textures[i].get() == *texture.get())
+                {
+                    return (float)i;
+                }
+            }
+            textures.push_back(texture);
+            return (float)(textures.size() - 1);
+        }
+
+        float textureIndex = 0.f;
+        for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
+        {
+            if (*s_Data.TextureSlots[i].get() == *texture.get())
+            {
+                textureIndex = (float)i;
+            }
+        }
+        if (textureIndex == 0.f)
+        {
+            if (s_Data.TextureSlotIndex == s_Data.MaxTextureSlots)
+            {
+                /* Out of texture slots - the quads so far are drawn with the textures bound now */
+                FlushQuads();
+                ResetQuadBatch();
+            }
+            textureIndex = (float)s_Data.TextureSlotIndex;
+            s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
+            s_Data.TextureSlotIndex++;
+        }
+        return textureIndex;
+    }
 
-        s_Data.SceneUniformBuffer = UniformBuffer::Create(0, sizeof(Camera::Data));
+
+    /// <summary>
+    /// (Re)creates the buffers and vertex arrays of every batch, sized by the current batch capacities.
+    /// </summary>
+    static void CreateBatchResources()
+    {
+        LV_PROFILE_FUNCTION();
 
         // Quads
         s_Data.QuadVertexArray = VertexArray::Create();
 
-        s_Data.QuadVertexBuffer = VertexBuffer::Create(s_Data.MaxQuadVertices * sizeof(QuadVertex));
+        s_Data.QuadVertexBuffer = StreamingVertexBuffer::Create(s_Data.MaxQuads * 4 * sizeof(QuadVertex));
         s_Data.QuadVertexBuffer->SetLayout({
             { ShaderDataType::Float3,   "a_Position" },
-            { ShaderDataType::Float4,   "a_Color"    },
+            { ShaderDataType::UByte4,   "a_Color",   true },
             { ShaderDataType::Float2,   "a_TexCoord" },
-            { ShaderDataType::Float2,   "a_TexScale" },
+            { ShaderDataType::Half2,    "a_TexScale" },
             { ShaderDataType::Float,    "a_TexIndex" },
             { ShaderDataType::Int,      "a_EntityId" }
         });
         s_Data.QuadVertexArray->AddVertexBuffer(s_Data.QuadVertexBuffer);
 
-        s_Data.QuadVertexBufferBase = new QuadVertex[s_Data.MaxQuadVertices];
-
-        uint32_t* quadIndices = new uint32_t[s_Data.MaxQuadIndices];
+        /* Shared by every quad-shaped batch, so it must cover the largest of them */
+        uint32_t maxQuadShapes = std::max({ s_Data.MaxQuads, s_Data.MaxCircles, s_Data.MaxEllipses, s_Data.MaxLines });
+        uint32_t maxQuadIndices = maxQuadShapes * 6;
+        uint32_t* quadIndices = new uint32_t[maxQuadIndices];
         uint32_t offset = 0;
-        for (uint32_t i = 0; i < s_Data.MaxQuadIndices; i += 6)
+        for (uint32_t i = 0; i < maxQuadIndices; i += 6)
         {
             quadIndices[i + 0] = offset + 0;
             quadIndices[i + 1] = offset + 1;
@@ -228,55 +560,48 @@ namespace Limnova
 
             offset += 4;
         }
-        Ref<IndexBuffer> quadIB = IndexBuffer::Create(quadIndices, s_Data.MaxQuadIndices);
+        Ref<IndexBuffer> quadIB = IndexBuffer::Create(quadIndices, maxQuadIndices);
         s_Data.QuadVertexArray->SetIndexBuffer(quadIB);
         delete[] quadIndices;
 
-        s_Data.WhiteTexture = Texture2D::Create(1, 1);
-        uint32_t whiteTextureData = 0xffffffff;
-        s_Data.WhiteTexture->SetData(&whiteTextureData, sizeof(uint32_t));
-
-        int samplers[s_Data.MaxTextureSlots];
-        for (uint32_t i = 0; i < s_Data.MaxTextureSlots; i++)
-        {
-            samplers[i] = i;
-        }
-
-        s_Data.QuadShader = Shader::Create(LV_ASSET_DIR"/shaders/Renderer2D_Quad.lvglsl");
-
-        s_Data.TextureSlots[0] = s_Data.WhiteTexture;
-
-        s_Data.QuadVertexPositions[0] = {-0.5f,-0.5f, 0.f, 1.f  };
-        s_Data.QuadVertexPositions[1] = { 0.5f,-0.5f, 0.f, 1.f  };
-        s_Data.QuadVertexPositions[2] = { 0.5f, 0.5f, 0.f, 1.f  };
-        s_Data.QuadVertexPositions[3] = {-0.5f, 0.5f, 0.f, 1.f  };
-
         // Circles
         s_Data.CircleVertexArray = VertexArray::Create();
 
-        s_Data.CircleVertexBuffer = VertexBuffer::Create(s_Data.MaxCircleVertices * sizeof(CircleVertex));
+        s_Data.CircleVertexBuffer = StreamingVertexBuffer::Create(s_Data.MaxCircles * 4 * sizeof(CircleVertex));
         s_Data.CircleVertexBuffer->SetLayout({
             { ShaderDataType::Float3,   "a_WorldPosition" },
-            { ShaderDataType::Float2,   "a_LocalPosition" },
-            { ShaderDataType::Float4,   "a_Color"         },
-            { ShaderDataType::Float,    "a_Thickness"     },
-            { ShaderDataType::Float,    "a_Fade"          },
+            { ShaderDataType::Half2,    "a_LocalPosition" },
+            { ShaderDataType::UByte4,   "a_Color",        true },
+            { ShaderDataType::Half,     "a_Thickness"     },
+            { ShaderDataType::Half,     "a_Fade"          },
             { ShaderDataType::Int,      "a_EntityId"      }
         });
         s_Data.CircleVertexArray->AddVertexBuffer(s_Data.CircleVertexBuffer);
         s_Data.CircleVertexArray->SetIndexBuffer(quadIB); /* Reuse quad indexes (same geometry) */
-        s_Data.CircleVertexBufferBase = new CircleVertex[s_Data.MaxCircleVertices];
 
-        s_Data.CircleShader = Shader::Create(LV_ASSET_DIR"/shaders/Renderer2D_Circle.lvglsl");
+        s_Data.CircleInstanceVertexArray = VertexArray::Create();
+        s_Data.CircleInstanceVertexArray->AddVertexBuffer(s_Data.UnitQuadVertexBuffer);
+        s_Data.CircleInstanceBuffer = StreamingVertexBuffer::Create(s_Data.MaxCircles * sizeof(CircleInstance));
+        s_Data.CircleInstanceBuffer->SetLayout(BufferLayout({
+            { ShaderDataType::Float3,   "a_Center"      },
+            { ShaderDataType::Float3,   "a_HalfAxisX"   },
+            { ShaderDataType::Float3,   "a_HalfAxisY"   },
+            { ShaderDataType::UByte4,   "a_Color",      true },
+            { ShaderDataType::Half,     "a_Thickness"   },
+            { ShaderDataType::Half,     "a_Fade"        },
+            { ShaderDataType::Int,      "a_EntityId"    }
+        }, true));
+        s_Data.CircleInstanceVertexArray->AddVertexBuffer(s_Data.CircleInstanceBuffer);
+        s_Data.CircleInstanceVertexArray->SetIndexBuffer(quadIB); /* Only the first quad's indexes are used */
 
         // Ellipses
         s_Data.EllipseVertexArray = VertexArray::Create();
 
-        s_Data.EllipseVertexBuffer = VertexBuffer::Create(s_Data.MaxEllipseVertices * sizeof(EllipseVertex));
+        s_Data.EllipseVertexBuffer = StreamingVertexBuffer::Create(s_Data.MaxEllipses * 4 * sizeof(EllipseVertex));
         s_Data.EllipseVertexBuffer->SetLayout({
             { ShaderDataType::Float3,   "a_WorldPosition"   },
             { ShaderDataType::Float2,   "a_LocalPosition"   },
-            { ShaderDataType::Float4,   "a_Color"           },
+            { ShaderDataType::UByte4,   "a_Color",          true },
             { ShaderDataType::Float,    "a_SemiMajorAxis"   },
             { ShaderDataType::Float,    "a_SemiMinorAxis"   },
             { ShaderDataType::Float2,   "a_CutoffPoint"     },
@@ -287,19 +612,35 @@ namespace Limnova
         });
         s_Data.EllipseVertexArray->AddVertexBuffer(s_Data.EllipseVertexBuffer);
         s_Data.EllipseVertexArray->SetIndexBuffer(quadIB); /* Reuse quad indexes (same geometry) */
-        s_Data.EllipseVertexBufferBase = new EllipseVertex[s_Data.MaxEllipseVertices];
 
-        //s_Data.EllipseShader = Shader::Create(LV_ASSET_DIR"/shaders/Renderer2D_Ellipse.lvglsl");
-        s_Data.EllipseShader = Shader::Create(LV_ASSET_DIR"/shaders/Orbital_Ellipse.lvglsl");
+        s_Data.EllipseInstanceVertexArray = VertexArray::Create();
+        s_Data.EllipseInstanceVertexArray->AddVertexBuffer(s_Data.UnitQuadVertexBuffer);
+        s_Data.EllipseInstanceBuffer = StreamingVertexBuffer::Create(s_Data.MaxEllipses * sizeof(EllipseInstance));
+        s_Data.EllipseInstanceBuffer->SetLayout(BufferLayout({
+            { ShaderDataType::Float3,   "a_Center"          },
+            { ShaderDataType::Float3,   "a_HalfAxisX"       },
+            { ShaderDataType::Float3,   "a_HalfAxisY"       },
+            { ShaderDataType::Float2,   "a_PerifocalExtent" },
+            { ShaderDataType::UByte4,   "a_Color",          true },
+            { ShaderDataType::Float,    "a_SemiMajorAxis"   },
+            { ShaderDataType::Float,    "a_SemiMinorAxis"   },
+            { ShaderDataType::Float2,   "a_CutoffPoint"     },
+            { ShaderDataType::Float2,   "a_CutoffNormal"    },
+            { ShaderDataType::Float,    "a_Thickness"       },
+            { ShaderDataType::Float,    "a_Fade"            },
+            { ShaderDataType::Int,      "a_EntityId"        }
+        }, true));
+        s_Data.EllipseInstanceVertexArray->AddVertexBuffer(s_Data.EllipseInstanceBuffer);
+        s_Data.EllipseInstanceVertexArray->SetIndexBuffer(quadIB); /* Only the first quad's indexes are used */
 
         // Hyperbolas
         s_Data.HyperbolaVertexArray = VertexArray::Create();
 
-        s_Data.HyperbolaVertexBuffer = VertexBuffer::Create(s_Data.MaxHyperbolaVertices * sizeof(HyperbolaVertex));
+        s_Data.HyperbolaVertexBuffer = StreamingVertexBuffer::Create(s_Data.MaxHyperbolas * 3 * sizeof(HyperbolaVertex));
         s_Data.HyperbolaVertexBuffer->SetLayout({
             { ShaderDataType::Float3,   "a_WorldPosition"   },
             { ShaderDataType::Float2,   "a_LocalPosition"   },
-            { ShaderDataType::Float4,   "a_Color"           },
+            { ShaderDataType::UByte4,   "a_Color",          true },
             { ShaderDataType::Float,    "a_SemiMajorAxis"   },
             { ShaderDataType::Float,    "a_SemiMinorAxis"   },
             { ShaderDataType::Float2,   "a_CutoffPoint"     },
@@ -310,30 +651,23 @@ namespace Limnova
             });
         s_Data.HyperbolaVertexArray->AddVertexBuffer(s_Data.HyperbolaVertexBuffer);
 
-        uint32_t* hyperbolaIndices = new uint32_t[s_Data.MaxHyperbolaIndices];
-        for (uint32_t i = 0; i < s_Data.MaxHyperbolaIndices; i++) {
+        uint32_t maxHyperbolaIndices = s_Data.MaxHyperbolas * 3;
+        uint32_t* hyperbolaIndices = new uint32_t[maxHyperbolaIndices];
+        for (uint32_t i = 0; i < maxHyperbolaIndices; i++) {
             hyperbolaIndices[i] = i;
         }
-        Ref<IndexBuffer> hyperbolaIB = IndexBuffer::Create(hyperbolaIndices, s_Data.MaxHyperbolaIndices);
+        Ref<IndexBuffer> hyperbolaIB = IndexBuffer::Create(hyperbolaIndices, maxHyperbolaIndices);
         s_Data.HyperbolaVertexArray->SetIndexBuffer(hyperbolaIB);
         delete[] hyperbolaIndices;
 
-        s_Data.HyperbolaVertexArray->SetIndexBuffer(hyperbolaIB);
-        s_Data.HyperbolaVertexBufferBase = new HyperbolaVertex[s_Data.MaxHyperbolaVertices];
-        s_Data.HyperbolaShader = Shader::Create(LV_ASSET_DIR"/shaders/Orbital_Hyperbola.lvglsl");
-
-        s_Data.HyperbolaVertexPositions[0] = { 0.f,  0.f,  0.f,  1.f  };
-        s_Data.HyperbolaVertexPositions[1] = {-1.f,  1.f,  0.f,  1.f  };
-        s_Data.HyperbolaVertexPositions[2] = {-1.f, -1.f,  0.f,  1.f  };
-
         // Lines
         s_Data.LineVertexArray = VertexArray::Create();
 
-        s_Data.LineVertexBuffer = VertexBuffer::Create(s_Data.MaxLineVertices * sizeof(LineVertex));
+        s_Data.LineVertexBuffer = StreamingVertexBuffer::Create(s_Data.MaxLines * 4 * sizeof(LineVertex));
         s_Data.LineVertexBuffer->SetLayout({
             { ShaderDataType::Float3,   "a_WorldPosition" },
-            { ShaderDataType::Float2,   "a_LocalPosition" },
-            { ShaderDataType::Float4,   "a_Color"         },
+            { ShaderDataType::Half2,    "a_LocalPosition" },
+            { ShaderDataType::UByte4,   "a_Color",        true },
             { ShaderDataType::Float,    "a_Length"        },
             { ShaderDataType::Float,    "a_Thickness"     },
             { ShaderDataType::Float,    "a_DashLength"    },
@@ -342,9 +676,125 @@ namespace Limnova
         });
         s_Data.LineVertexArray->AddVertexBuffer(s_Data.LineVertexBuffer);
         s_Data.LineVertexArray->SetIndexBuffer(quadIB); /* Reuse quad indexes (same geometry) */
-        s_Data.LineVertexBufferBase = new LineVertex[s_Data.MaxLineVertices];
 
-        s_Data.LineShader = Shader::Create(LV_ASSET_DIR"/shaders/Renderer2D_Line.lvglsl");
+        s_Data.LineInstanceVertexArray = VertexArray::Create();
+        s_Data.LineInstanceVertexArray->AddVertexBuffer(s_Data.UnitQuadVertexBuffer);
+        s_Data.LineInstanceBuffer = StreamingVertexBuffer::Create(s_Data.MaxLines * sizeof(LineInstance));
+        s_Data.LineInstanceBuffer->SetLayout(BufferLayout({
+            { ShaderDataType::Float3,   "a_Center"      },
+            { ShaderDataType::Float3,   "a_HalfAxisX"   },
+            { ShaderDataType::Float3,   "a_HalfAxisY"   },
+            { ShaderDataType::UByte4,   "a_Color",      true },
+            { ShaderDataType::Float,    "a_Length"      },
+            { ShaderDataType::Float,    "a_Thickness"   },
+            { ShaderDataType::Float,    "a_DashLength"  },
+            { ShaderDataType::Float,    "a_GapLength"   },
+            { ShaderDataType::Int,      "a_EntityId"    }
+        }, true));
+        s_Data.LineInstanceVertexArray->AddVertexBuffer(s_Data.LineInstanceBuffer);
+        s_Data.LineInstanceVertexArray->SetIndexBuffer(quadIB); /* Only the first quad's indexes are used */
+    }
+
+
+    /// <returns>Capacity which fits a whole scene's worth of primitives in one batch, up to the capacity limit</returns>
+    static uint32_t GrowBatchCapacity(uint32_t capacity, uint32_t sceneCount)
+    {
+        if (sceneCount <= capacity || capacity >= s_Data.BatchCapacityLimit) {
+            return capacity;
+        }
+        while (capacity < sceneCount) capacity *= 2;
+        return std::min(capacity, s_Data.BatchCapacityLimit);
+    }
+
+
+    /// <summary>
+    /// Adds the time spent in its scope to a statistics timer.
+    /// </summary>
+    class StatisticsTimer
+    {
+    public:
+        StatisticsTimer(float& millis) : m_Millis(millis) {}
+        ~StatisticsTimer() { m_Millis += m_Timer.ElapsedMillis(); }
+    private:
+        float& m_Millis;
+        Timer m_Timer;
+    };
+
+
+    static void UpdateCapacityStatistics()
+    {
+        s_Data.Stats.Quads.Capacity = s_Data.MaxQuads;
+        s_Data.Stats.Circles.Capacity = s_Data.MaxCircles;
+        s_Data.Stats.Ellipses.Capacity = s_Data.MaxEllipses;
+        s_Data.Stats.Hyperbolas.Capacity = s_Data.MaxHyperbolas;
+        s_Data.Stats.Lines.Capacity = s_Data.MaxLines;
+    }
+
+
+    void Renderer2D::Init()
+    {
+        LV_PROFILE_FUNCTION();
+
+        s_Data.SceneUniformBuffer = UniformBuffer::Create(0, sizeof(Camera::Data));
+
+        // Shaders - compiled together, in parallel
+        std::pair<Ref<Shader>*, std::string> shaderFiles[] = {
+            { &s_Data.QuadShader,               LV_ASSET_DIR"/shaders/Renderer2D_Quad.lvglsl" },
+            { &s_Data.CircleShader,             LV_ASSET_DIR"/shaders/Renderer2D_Circle.lvglsl" },
+            { &s_Data.CircleInstanceShader,     LV_ASSET_DIR"/shaders/Renderer2D_CircleInstanced.lvglsl" },
+            //{ &s_Data.EllipseShader,          LV_ASSET_DIR"/shaders/Renderer2D_Ellipse.lvglsl" },
+            { &s_Data.EllipseShader,            LV_ASSET_DIR"/shaders/Orbital_Ellipse.lvglsl" },
+            { &s_Data.EllipseInstanceShader,    LV_ASSET_DIR"/shaders/Orbital_EllipseInstanced.lvglsl" },
+            { &s_Data.HyperbolaShader,          LV_ASSET_DIR"/shaders/Orbital_Hyperbola.lvglsl" },
+            { &s_Data.LineShader,               LV_ASSET_DIR"/shaders/Renderer2D_Line.lvglsl" },
+            { &s_Data.LineInstanceShader,       LV_ASSET_DIR"/shaders/Renderer2D_LineInstanced.lvglsl" },
+        };
+        std::vector<std::string> shaderPaths;
+        for (auto const& [shader, path] : shaderFiles) {
+            shaderPaths.push_back(path);
+        }
+        std::vector<Ref<Shader>> shaders = Shader::Create(shaderPaths);
+        for (size_t i = 0; i < shaders.size(); i++) {
+            *shaderFiles[i].first = shaders[i];
+        }
+
+        // Quads
+        s_Data.WhiteTexture = Texture2D::Create(1, 1);
+        uint32_t whiteTextureData = 0xffffffff;
+        s_Data.WhiteTexture->SetData(&whiteTextureData, sizeof(uint32_t));
+
+        int samplers[s_Data.MaxTextureSlots];
+        for (uint32_t i = 0; i < s_Data.MaxTextureSlots; i++)
+        {
+            samplers[i] = i;
+        }
+
+        s_Data.TextureSlots[0] = s_Data.WhiteTexture;
+
+        s_Data.QuadVertexPositions[0] = {-0.5f,-0.5f, 0.f, 1.f  };
+        s_Data.QuadVertexPositions[1] = { 0.5f,-0.5f, 0.f, 1.f  };
+        s_Data.QuadVertexPositions[2] = { 0.5f, 0.5f, 0.f, 1.f  };
+        s_Data.QuadVertexPositions[3] = {-0.5f, 0.5f, 0.f, 1.f  };
+
+        // Instancing
+        float unitQuadVertices[2 * 4] = {
+            -1.f, -1.f,
+             1.f, -1.f,
+             1.f,  1.f,
+            -1.f,  1.f
+        };
+        s_Data.UnitQuadVertexBuffer = VertexBuffer::Create(unitQuadVertices, sizeof(unitQuadVertices));
+        s_Data.UnitQuadVertexBuffer->SetLayout({
+            { ShaderDataType::Float2,   "a_Corner" }
+        });
+
+        // Hyperbolas
+        s_Data.HyperbolaVertexPositions[0] = { 0.f,  0.f,  0.f,  1.f  };
+        s_Data.HyperbolaVertexPositions[1] = {-1.f,  1.f,  0.f,  1.f  };
+        s_Data.HyperbolaVertexPositions[2] = {-1.f, -1.f,  0.f,  1.f  };
+
+        CreateBatchResources();
+        UpdateCapacityStatistics();
 
 #ifdef EXCLUDED
         // Color hyperbola
@@ -406,18 +856,68 @@ namespace Limnova
 
         s_Data.SceneUniformBuffer->UpdateData((void*)camera.GetData(), offsetof(Renderer::SceneData, Renderer::SceneData::CameraData), sizeof(Camera::Data));
         s_Data.CameraData = camera.GetData();
+        s_Data.CameraView = camera.GetView();
+
+        // Grow any batch which the previous scene overflowed, so it fits in a single flush from now on
+        uint32_t maxQuads = GrowBatchCapacity(s_Data.MaxQuads, s_Data.QuadSceneCount);
+        uint32_t maxCircles = GrowBatchCapacity(s_Data.MaxCircles, s_Data.CircleSceneCount);
+        uint32_t maxEllipses = GrowBatchCapacity(s_Data.MaxEllipses, s_Data.EllipseSceneCount);
+        uint32_t maxHyperbolas = GrowBatchCapacity(s_Data.MaxHyperbolas, s_Data.HyperbolaSceneCount);
+        uint32_t maxLines = GrowBatchCapacity(s_Data.MaxLines, s_Data.LineSceneCount);
+        if (maxQuads != s_Data.MaxQuads || maxCircles != s_Data.MaxCircles || maxEllipses != s_Data.MaxEllipses
+            || maxHyperbolas != s_Data.MaxHyperbolas || maxLines != s_Data.MaxLines)
+        {
+            s_Data.MaxQuads = maxQuads;
+            s_Data.MaxCircles = maxCircles;
+            s_Data.MaxEllipses = maxEllipses;
+            s_Data.MaxHyperbolas = maxHyperbolas;
+            s_Data.MaxLines = maxLines;
+            CreateBatchResources();
+
+            LV_CORE_INFO("Renderer2D batch capacities grown to: {0} quads, {1} circles, {2} ellipses, {3} hyperbolas, {4} lines",
+                maxQuads, maxCircles, maxEllipses, maxHyperbolas, maxLines);
+        }
+        UpdateCapacityStatistics();
+
+        s_Data.QuadSceneCount = 0;
+        s_Data.CircleSceneCount = 0;
+        s_Data.EllipseSceneCount = 0;
+        s_Data.HyperbolaSceneCount = 0;
+        s_Data.LineSceneCount = 0;
 
         ResetQuadBatch();
         ResetCircleBatch();
         ResetEllipseBatch();
         ResetHyperbolaBatch();
         ResetLineBatch();
+
+        s_Data.Queue.Clear();
+        s_Data.QueueActive = s_Data.UseRenderQueue;
     }
 
 
     void Renderer2D::EndScene()
     {
         LV_PROFILE_FUNCTION();
+        LV_CORE_ASSERT(s_RecordingBuffer == nullptr, "EndScene must be called by the rendering thread, after recording has ended!");
+
+        /* Deactivated first, so that texture lookups from here on resolve to the batch's texture slots */
+        bool queued = s_Data.QueueActive;
+        s_Data.QueueActive = false;
+
+        for (uint32_t i = 0; i < s_Data.NumCommandBuffers; i++) {
+            if (queued) {
+                AppendToQueue(*s_Data.CommandBuffers[i]);
+            }
+            else {
+                MergeCommandBuffer(*s_Data.CommandBuffers[i]);
+            }
+        }
+        s_Data.NumCommandBuffers = 0;
+
+        if (queued) {
+            SubmitQueue();
+        }
 
         FlushQuads();
         FlushCircles();
@@ -427,9 +927,271 @@ namespace Limnova
     }
 
 
+    Renderer2D::CommandBuffer& Renderer2D::AcquireCommandBuffer()
+    {
+        LV_CORE_ASSERT(s_RecordingBuffer == nullptr, "Command buffers must be acquired by the rendering thread!");
+
+        if (s_Data.NumCommandBuffers == s_Data.CommandBuffers.size()) {
+            s_Data.CommandBuffers.push_back(CreateScope<CommandBuffer>());
+        }
+        CommandBuffer& commandBuffer = *s_Data.CommandBuffers[s_Data.NumCommandBuffers++];
+        commandBuffer.Clear();
+        return commandBuffer;
+    }
+
+
+    void Renderer2D::BeginRecording(CommandBuffer& commandBuffer)
+    {
+        LV_CORE_ASSERT(s_RecordingBuffer == nullptr, "This thread is already recording a command buffer!");
+        s_RecordingBuffer = &commandBuffer;
+    }
+
+
+    void Renderer2D::EndRecording()
+    {
+        LV_CORE_ASSERT(s_RecordingBuffer != nullptr, "This thread is not recording a command buffer!");
+        s_RecordingBuffer = nullptr;
+    }
+
+
+    void Renderer2D::MergeCommandBuffer(CommandBuffer& commandBuffer)
+    {
+        LV_PROFILE_FUNCTION();
+
+        // Quads - one at a time, as their recorded texture indices are remapped to the batch's texture slots
+        auto& textureSlots = commandBuffer.TextureSlots;
+        auto resetTextureSlots = [&] {
+            textureSlots.assign(commandBuffer.Textures.size(), -1.f);
+            textureSlots[0] = 0.f;
+        };
+        resetTextureSlots();
+        for (size_t q = 0; q < commandBuffer.QuadVertices.size(); q += 4)
+        {
+            uint32_t recordedIndex = (uint32_t)commandBuffer.QuadVertices[q].TexIndex;
+            if (s_Data.QuadIndexCount >= s_Data.MaxQuads * 6
+                || (textureSlots[recordedIndex] < 0.f && s_Data.TextureSlotIndex == s_Data.MaxTextureSlots))
+            {
+                FlushQuads();
+                ResetQuadBatch();
+                resetTextureSlots();
+            }
+            if (textureSlots[recordedIndex] < 0.f) {
+                textureSlots[recordedIndex] = GetTextureIndex(commandBuffer.Textures[recordedIndex]);
+            }
+
+            memcpy(s_Data.QuadVertexBufferPtr, &commandBuffer.QuadVertices[q], 4 * sizeof(QuadVertex));
+            for (uint32_t i = 0; i < 4; i++)
+            {
+                s_Data.QuadVertexBufferPtr->TexIndex = textureSlots[recordedIndex];
+                s_Data.QuadVertexBufferPtr++;
+            }
+            s_Data.QuadIndexCount += 6;
+            s_Data.QuadSceneCount++;
+        }
+
+        auto flushCircles = [] { FlushCircles(); ResetCircleBatch(); };
+        CopyToBatch(commandBuffer.CircleInstances.data(), commandBuffer.CircleInstances.size(), 1, 1, s_Data.MaxCircles,
+            s_Data.CircleInstanceBufferPtr, s_Data.CircleInstanceCount, s_Data.CircleSceneCount, flushCircles);
+        CopyToBatch(commandBuffer.CircleVertices.data(), commandBuffer.CircleVertices.size() / 4, 4, 6, s_Data.MaxCircles * 6,
+            s_Data.CircleVertexBufferPtr, s_Data.CircleIndexCount, s_Data.CircleSceneCount, flushCircles);
+
+        auto flushEllipses = [] { FlushEllipses(); ResetEllipseBatch(); };
+        CopyToBatch(commandBuffer.EllipseInstances.data(), commandBuffer.EllipseInstances.size(), 1, 1, s_Data.MaxEllipses,
+            s_Data.EllipseInstanceBufferPtr, s_Data.EllipseInstanceCount, s_Data.EllipseSceneCount, flushEllipses);
+        CopyToBatch(commandBuffer.EllipseVertices.data(), commandBuffer.EllipseVertices.size() / 4, 4, 6, s_Data.MaxEllipses * 6,
+            s_Data.EllipseVertexBufferPtr, s_Data.EllipseIndexCount, s_Data.EllipseSceneCount, flushEllipses);
+
+        CopyToBatch(commandBuffer.HyperbolaVertices.data(), commandBuffer.HyperbolaVertices.size() / 3, 3, 3, s_Data.MaxHyperbolas * 3,
+            s_Data.HyperbolaVertexBufferPtr, s_Data.HyperbolaIndexCount, s_Data.HyperbolaSceneCount, [] { FlushHyperbolas(); ResetHyperbolaBatch(); });
+
+        auto flushLines = [] { FlushLines(); ResetLineBatch(); };
+        CopyToBatch(commandBuffer.LineInstances.data(), commandBuffer.LineInstances.size(), 1, 1, s_Data.MaxLines,
+            s_Data.LineInstanceBufferPtr, s_Data.LineInstanceCount, s_Data.LineSceneCount, flushLines);
+        CopyToBatch(commandBuffer.LineVertices.data(), commandBuffer.LineVertices.size() / 4, 4, 6, s_Data.MaxLines * 6,
+            s_Data.LineVertexBufferPtr, s_Data.LineIndexCount, s_Data.LineSceneCount, flushLines);
+
+        MergeStatistics(commandBuffer.Stats);
+    }
+
+
+    void Renderer2D::AppendToQueue(CommandBuffer& commandBuffer)
+    {
+        LV_PROFILE_FUNCTION();
+
+        auto& queue = s_Data.Queue;
+
+        /* Recorded texture indices are remapped to the queue's texture list */
+        auto& textureMap = commandBuffer.TextureSlots;
+        textureMap.assign(commandBuffer.Textures.size(), 0.f);
+        for (uint32_t t = 1; t < commandBuffer.Textures.size(); t++)
+        {
+            auto& texture = commandBuffer.Textures[t];
+            auto it = std::find_if(queue.Textures.begin() + 1, queue.Textures.end(), [&](Ref<Texture2D> const& queued) { return *queued.get() == *texture.get(); });
+            if (it == queue.Textures.end()) {
+                it = queue.Textures.insert(it, texture);
+            }
+            textureMap[t] = (float)(it - queue.Textures.begin());
+        }
+
+        /* Entries index their primitive within its record list, so they are rebased past the queue's existing records */
+        const uint32_t bases[] = {
+            (uint32_t)queue.QuadVertices.size() / 4,
+            (uint32_t)queue.CircleVertices.size() / 4,
+            (uint32_t)queue.CircleInstances.size(),
+            (uint32_t)queue.EllipseVertices.size() / 4,
+            (uint32_t)queue.EllipseInstances.size(),
+            (uint32_t)queue.HyperbolaVertices.size() / 3,
+            (uint32_t)queue.LineVertices.size() / 4,
+            (uint32_t)queue.LineInstances.size()
+        };
+        for (auto entry : commandBuffer.Entries)
+        {
+            entry.Record += bases[entry.Record >> kRecordTypeShift];
+            entry.Texture = (uint16_t)textureMap[entry.Texture];
+            queue.Entries.push_back(entry);
+        }
+
+        size_t firstQuadVertex = queue.QuadVertices.size();
+        auto append = [](auto& dst, auto const& src) { dst.insert(dst.end(), src.begin(), src.end()); };
+        append(queue.QuadVertices, commandBuffer.QuadVertices);
+        for (size_t v = firstQuadVertex; v < queue.QuadVertices.size(); v++) {
+            queue.QuadVertices[v].TexIndex = textureMap[(uint32_t)queue.QuadVertices[v].TexIndex];
+        }
+        append(queue.CircleVertices, commandBuffer.CircleVertices);
+        append(queue.CircleInstances, commandBuffer.CircleInstances);
+        append(queue.EllipseVertices, commandBuffer.EllipseVertices);
+        append(queue.EllipseInstances, commandBuffer.EllipseInstances);
+        append(queue.HyperbolaVertices, commandBuffer.HyperbolaVertices);
+        append(queue.LineVertices, commandBuffer.LineVertices);
+        append(queue.LineInstances, commandBuffer.LineInstances);
+
+        MergeStatistics(commandBuffer.Stats);
+    }
+
+
+    void Renderer2D::SubmitQueue()
+    {
+        LV_PROFILE_FUNCTION();
+
+        auto& queue = s_Data.Queue;
+
+        s_Data.QueueKeys.resize(queue.Entries.size());
+        for (uint32_t i = 0; i < queue.Entries.size(); i++) {
+            s_Data.QueueKeys[i] = { QueueSortKey(queue.Entries[i]), i };
+        }
+        RadixSort(s_Data.QueueKeys, s_Data.QueueKeysScratch);
+
+        auto& textureSlots = queue.TextureSlots;
+        auto resetTextureSlots = [&] {
+            textureSlots.assign(queue.Textures.size(), -1.f);
+            textureSlots[0] = 0.f;
+        };
+        resetTextureSlots();
+
+        auto flushQuads = [&] { FlushQuads(); ResetQuadBatch(); resetTextureSlots(); };
+        auto flushCircles = [] { FlushCircles(); ResetCircleBatch(); };
+        auto flushEllipses = [] { FlushEllipses(); ResetEllipseBatch(); };
+        auto flushHyperbolas = [] { FlushHyperbolas(); ResetHyperbolaBatch(); };
+        auto flushLines = [] { FlushLines(); ResetLineBatch(); };
+
+        /* Batches are only flushed when the record type (and so the shader) changes, or when a batch or the texture slots are full.
+         * Flushing on every type change draws each run before anything later in the queue, which keeps transparent primitives
+         * in back-to-front order across types */
+        RecordType runType = RecordType::Quad;
+        auto const& keys = s_Data.QueueKeys;
+        constexpr uint32_t kPrimitiveMask = (1u << kRecordTypeShift) - 1;
+        for (size_t k = 0; k < keys.size();)
+        {
+            auto const& entry = queue.Entries[keys[k].Index];
+            RecordType type = (RecordType)(entry.Record >> kRecordTypeShift);
+            size_t primitive = entry.Record & kPrimitiveMask;
+
+            if (type != runType)
+            {
+                switch (runType)
+                {
+                case RecordType::Quad:              flushQuads(); break;
+                case RecordType::Circle:
+                case RecordType::CircleInstance:    flushCircles(); break;
+                case RecordType::Ellipse:
+                case RecordType::EllipseInstance:   flushEllipses(); break;
+                case RecordType::Hyperbola:         flushHyperbolas(); break;
+                case RecordType::Line:
+                case RecordType::LineInstance:      flushLines(); break;
+                }
+                runType = type;
+            }
+
+            /* Sorted entries which are also consecutive in their record list (and share a texture) are copied in one go - opaque
+             * primitives drawn in order at increasing depth, or at equal depth, stay contiguous after the (stable) sort */
+            size_t numPrimitives = 1;
+            while (k + numPrimitives < keys.size())
+            {
+                auto const& next = queue.Entries[keys[k + numPrimitives].Index];
+                if (next.Record != entry.Record + numPrimitives || next.Texture != entry.Texture) break;
+                numPrimitives++;
+            }
+
+            switch (type)
+            {
+            case RecordType::Quad:
+            {
+                if (s_Data.QuadIndexCount >= s_Data.MaxQuads * 6
+                    || (textureSlots[entry.Texture] < 0.f && s_Data.TextureSlotIndex == s_Data.MaxTextureSlots))
+                {
+                    flushQuads();
+                }
+                if (textureSlots[entry.Texture] < 0.f) {
+                    textureSlots[entry.Texture] = GetTextureIndex(queue.Textures[entry.Texture]);
+                }
+                /* A flush resets the texture slots, so a run of quads is cut at the end of the batch rather than copied across it */
+                numPrimitives = std::min<size_t>(numPrimitives, (s_Data.MaxQuads * 6 - s_Data.QuadIndexCount) / 6);
+                QuadVertex* vertices = s_Data.QuadVertexBufferPtr;
+                CopyToBatch(&queue.QuadVertices[primitive * 4], numPrimitives, 4, 6, s_Data.MaxQuads * 6,
+                    s_Data.QuadVertexBufferPtr, s_Data.QuadIndexCount, s_Data.QuadSceneCount, flushQuads);
+                for (size_t i = 0; i < numPrimitives * 4; i++) {
+                    vertices[i].TexIndex = textureSlots[entry.Texture];
+                }
+                break;
+            }
+            case RecordType::Circle:
+                CopyToBatch(&queue.CircleVertices[primitive * 4], numPrimitives, 4, 6, s_Data.MaxCircles * 6,
+                    s_Data.CircleVertexBufferPtr, s_Data.CircleIndexCount, s_Data.CircleSceneCount, flushCircles);
+                break;
+            case RecordType::CircleInstance:
+                CopyToBatch(&queue.CircleInstances[primitive], numPrimitives, 1, 1, s_Data.MaxCircles,
+                    s_Data.CircleInstanceBufferPtr, s_Data.CircleInstanceCount, s_Data.CircleSceneCount, flushCircles);
+                break;
+            case RecordType::Ellipse:
+                CopyToBatch(&queue.EllipseVertices[primitive * 4], numPrimitives, 4, 6, s_Data.MaxEllipses * 6,
+                    s_Data.EllipseVertexBufferPtr, s_Data.EllipseIndexCount, s_Data.EllipseSceneCount, flushEllipses);
+                break;
+            case RecordType::EllipseInstance:
+                CopyToBatch(&queue.EllipseInstances[primitive], numPrimitives, 1, 1, s_Data.MaxEllipses,
+                    s_Data.EllipseInstanceBufferPtr, s_Data.EllipseInstanceCount, s_Data.EllipseSceneCount, flushEllipses);
+                break;
+            case RecordType::Hyperbola:
+                CopyToBatch(&queue.HyperbolaVertices[primitive * 3], numPrimitives, 3, 3, s_Data.MaxHyperbolas * 3,
+                    s_Data.HyperbolaVertexBufferPtr, s_Data.HyperbolaIndexCount, s_Data.HyperbolaSceneCount, flushHyperbolas);
+                break;
+            case RecordType::Line:
+                CopyToBatch(&queue.LineVertices[primitive * 4], numPrimitives, 4, 6, s_Data.MaxLines * 6,
+                    s_Data.LineVertexBufferPtr, s_Data.LineIndexCount, s_Data.LineSceneCount, flushLines);
+                break;
+            case RecordType::LineInstance:
+                CopyToBatch(&queue.LineInstances[primitive], numPrimitives, 1, 1, s_Data.MaxLines,
+                    s_Data.LineInstanceBufferPtr, s_Data.LineInstanceCount, s_Data.LineSceneCount, flushLines);
+                break;
+            }
+            k += numPrimitives;
+        }
+    }
+
+
     void Renderer2D::FlushQuads()
     {
         LV_PROFILE_FUNCTION();
+        StatisticsTimer timer(s_Data.Stats.Quads.FlushMillis);
 
         if (s_Data.QuadIndexCount == 0) {
             return;
@@ -443,11 +1205,14 @@ namespace Limnova
         }
 
         uint32_t dataSize = (uint8_t*)s_Data.QuadVertexBufferPtr - (uint8_t*)s_Data.QuadVertexBufferBase;
-        s_Data.QuadVertexBuffer->SetData(s_Data.QuadVertexBufferBase, dataSize);
 
-        RenderCommand::DrawIndexed(s_Data.QuadVertexArray, s_Data.QuadIndexCount);
+        RenderCommand::DrawIndexed(s_Data.QuadVertexArray, s_Data.QuadIndexCount, s_Data.QuadVertexBuffer->GetRegionOffset() / sizeof(QuadVertex));
+        s_Data.QuadVertexBuffer->EndRegion();
 
         s_Data.Stats.DrawCalls++;
+        s_Data.Stats.BytesUploaded += dataSize;
+        s_Data.Stats.Quads.Flushes++;
+        s_Data.Stats.Quads.Bytes += dataSize;
     }
 
 
@@ -456,6 +1221,7 @@ namespace Limnova
         LV_PROFILE_FUNCTION();
 
         s_Data.QuadIndexCount = 0;
+        s_Data.QuadVertexBufferBase = (QuadVertex*)s_Data.QuadVertexBuffer->BeginRegion();
         s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
 
         s_Data.TextureSlotIndex = 1;
@@ -465,27 +1231,40 @@ namespace Limnova
     void Renderer2D::DrawBatchedQuad(const Matrix4& transform, const Vector4& color, const Vector2* textureCoords, const Vector2& textureScale, const float textureIndex, int entityId)
     {
         LV_PROFILE_FUNCTION();
+        StatisticsTimer timer(CurrentStatistics().Quads.DrawMillis);
 
-        if (s_Data.QuadIndexCount >= s_Data.MaxQuadIndices)
+        QuadVertex* vertices;
+        if (auto* recorder = Recorder())
         {
-            FlushQuads();
-            ResetQuadBatch();
+            vertices = RecordPrimitive(recorder->QuadVertices, 4);
+            RecordQueueEntry(*recorder, RecordType::Quad, recorder->QuadVertices.size() / 4 - 1, transform, color.w < 1.f || textureIndex != 0.f, textureIndex);
+        }
+        else
+        {
+            if (s_Data.QuadIndexCount >= s_Data.MaxQuads * 6)
+            {
+                FlushQuads();
+                ResetQuadBatch();
+            }
+            vertices = s_Data.QuadVertexBufferPtr;
+            s_Data.QuadVertexBufferPtr += 4;
+            s_Data.QuadIndexCount += 6;
+            s_Data.QuadSceneCount++;
         }
 
+        uint32_t packedColor = PackColor(color);
+        uint32_t packedTextureScale = PackHalf2(textureScale.x, textureScale.y);
         for (uint32_t i = 0; i < 4; i++)
         {
-            s_Data.QuadVertexBufferPtr->Position = (transform * s_Data.QuadVertexPositions[i]).XYZ();
-            s_Data.QuadVertexBufferPtr->Color = color;
-            s_Data.QuadVertexBufferPtr->TexCoord = textureCoords[i];
-            s_Data.QuadVertexBufferPtr->TexScale = textureScale;
-            s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-            s_Data.QuadVertexBufferPtr->EntityId = entityId;
-            s_Data.QuadVertexBufferPtr++;
+            vertices[i].Position = (transform * s_Data.QuadVertexPositions[i]).XYZ();
+            vertices[i].Color = packedColor;
+            vertices[i].TexCoord = textureCoords[i];
+            vertices[i].TexScale = packedTextureScale;
+            vertices[i].TexIndex = textureIndex;
+            vertices[i].EntityId = entityId;
         }
-        s_Data.QuadIndexCount += 6;
 
-
-        s_Data.Stats.QuadCount++;
+        CurrentStatistics().Quads.Count++;
     }
 
 
@@ -504,20 +1283,7 @@ namespace Limnova
     void Renderer2D::DrawQuad(const Matrix4& transform, const Ref<Texture2D>& texture, const Vector4& tint, const Vector2& textureScale)
     {
         const Vector2 textureCoords[4]{ { 0.f, 0.f }, { 1.f, 0.f }, { 1.f, 1.f }, { 0.f, 1.f } };
-        float textureIndex = 0.f;
-        for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
-        {
-            if (*s_Data.TextureSlots[i].get() == *texture.get())
-            {
-                textureIndex = (float)i;
-            }
-        }
-        if (textureIndex == 0.f)
-        {
-            textureIndex = (float)s_Data.TextureSlotIndex;
-            s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-            s_Data.TextureSlotIndex++;
-        }
+        float textureIndex = GetTextureIndex(texture);
 
         DrawBatchedQuad(transform, tint, textureCoords, textureScale, textureIndex);
     }
@@ -527,20 +1293,7 @@ namespace Limnova
     {
         const Ref<Texture2D>& texture = subTexture->GetTexture();
         const Vector2* textureCoords = subTexture->GetTexCoords();
-        float textureIndex = 0.f;
-        for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
-        {
-            if (*s_Data.TextureSlots[i].get() == *texture.get())
-            {
-                textureIndex = (float)i;
-            }
-        }
-        if (textureIndex == 0.f)
-        {
-            textureIndex = (float)s_Data.TextureSlotIndex;
-            s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-            s_Data.TextureSlotIndex++;
-        }
+        float textureIndex = GetTextureIndex(texture);
 
         DrawBatchedQuad(transform, tint, textureCoords, textureScale, textureIndex);
     }
@@ -628,20 +1381,7 @@ namespace Limnova
         transform = glm::scale(transform, glm::vec3((glm::vec2)size, 1.f));
 
         const Vector2 textureCoords[4]{ { 0.f, 0.f }, { 1.f, 0.f }, { 1.f, 1.f }, { 0.f, 1.f } };
-        float textureIndex = 0.f;
-        for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
-        {
-            if (*s_Data.TextureSlots[i].get() == *texture.get())
-            {
-                textureIndex = (float)i;
-            }
-        }
-        if (textureIndex == 0.f)
-        {
-            textureIndex = (float)s_Data.TextureSlotIndex;
-            s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-            s_Data.TextureSlotIndex++;
-        }
+        float textureIndex = GetTextureIndex(texture);
 
         DrawBatchedQuad(transform, tint, textureCoords, textureScale, textureIndex);
     }
@@ -664,20 +1404,7 @@ namespace Limnova
         transform = glm::scale(transform, glm::vec3((glm::vec2)size, 1.f));
 
         const Vector2* textureCoords = subTexture->GetTexCoords();
-        float textureIndex = 0.f;
-        for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
-        {
-            if (*s_Data.TextureSlots[i].get() == *texture.get())
-            {
-                textureIndex = (float)i;
-            }
-        }
-        if (textureIndex == 0.f)
-        {
-            textureIndex = (float)s_Data.TextureSlotIndex;
-            s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-            s_Data.TextureSlotIndex++;
-        }
+        float textureIndex = GetTextureIndex(texture);
 
         DrawBatchedQuad(transform, tint, textureCoords, textureScale, textureIndex);
     }
@@ -694,20 +1421,37 @@ namespace Limnova
     void Renderer2D::FlushCircles()
     {
         LV_PROFILE_FUNCTION();
+        StatisticsTimer timer(s_Data.Stats.Circles.FlushMillis);
 
-        if (s_Data.CircleIndexCount == 0) {
-            return;
-        }
+        if (s_Data.CircleInstanceCount > 0)
+        {
+            s_Data.CircleInstanceShader->Bind();
 
-        s_Data.CircleShader->Bind();
+            uint32_t dataSize = (uint8_t*)s_Data.CircleInstanceBufferPtr - (uint8_t*)s_Data.CircleInstanceBufferBase;
 
-        uint32_t dataSize = (uint8_t*)s_Data.CircleVertexBufferPtr - (uint8_t*)s_Data.CircleVertexBufferBase;
-        s_Data.CircleVertexBuffer->SetData(s_Data.CircleVertexBufferBase, dataSize);
+            RenderCommand::DrawIndexedInstanced(s_Data.CircleInstanceVertexArray, 6, s_Data.CircleInstanceCount, s_Data.CircleInstanceBuffer->GetRegionOffset() / sizeof(CircleInstance));
+            s_Data.CircleInstanceBuffer->EndRegion();
 
-        RenderCommand::DrawIndexed(s_Data.CircleVertexArray, s_Data.CircleIndexCount);
+            s_Data.Stats.DrawCalls++;
+            s_Data.Stats.BytesUploaded += dataSize;
+            s_Data.Stats.Circles.Flushes++;
+            s_Data.Stats.Circles.Bytes += dataSize;
+        }
 
+        if (s_Data.CircleIndexCount > 0)
+        {
+            s_Data.CircleShader->Bind();
 
-        s_Data.Stats.DrawCalls++;
+            uint32_t dataSize = (uint8_t*)s_Data.CircleVertexBufferPtr - (uint8_t*)s_Data.CircleVertexBufferBase;
+
+            RenderCommand::DrawIndexed(s_Data.CircleVertexArray, s_Data.CircleIndexCount, s_Data.CircleVertexBuffer->GetRegionOffset() / sizeof(CircleVertex));
+            s_Data.CircleVertexBuffer->EndRegion();
+
+            s_Data.Stats.DrawCalls++;
+            s_Data.Stats.BytesUploaded += dataSize;
+            s_Data.Stats.Circles.Flushes++;
+            s_Data.Stats.Circles.Bytes += dataSize;
+        }
     }
 
 
@@ -716,35 +1460,80 @@ namespace Limnova
         LV_PROFILE_FUNCTION();
 
         s_Data.CircleIndexCount = 0;
+        s_Data.CircleVertexBufferBase = (CircleVertex*)s_Data.CircleVertexBuffer->BeginRegion();
         s_Data.CircleVertexBufferPtr = s_Data.CircleVertexBufferBase;
+
+        s_Data.CircleInstanceCount = 0;
+        s_Data.CircleInstanceBufferBase = (CircleInstance*)s_Data.CircleInstanceBuffer->BeginRegion();
+        s_Data.CircleInstanceBufferPtr = s_Data.CircleInstanceBufferBase;
     }
 
 
     void Renderer2D::DrawCircle(const Matrix4& transform, const Vector4& color, float thickness, float fade, int entityId)
     {
         LV_PROFILE_FUNCTION();
+        StatisticsTimer timer(CurrentStatistics().Circles.DrawMillis);
+        CurrentStatistics().Circles.Count++;
 
-        if (s_Data.CircleIndexCount >= s_Data.MaxCircleIndices)
+        if (s_Data.UseInstancing)
         {
-            FlushCircles();
-            ResetCircleBatch();
+            CircleInstance* instance;
+            if (auto* recorder = Recorder())
+            {
+                instance = RecordPrimitive(recorder->CircleInstances, 1);
+                RecordQueueEntry(*recorder, RecordType::CircleInstance, recorder->CircleInstances.size() - 1, transform, color.w < 1.f || fade > 0.f);
+            }
+            else
+            {
+                if (s_Data.CircleInstanceCount >= s_Data.MaxCircles)
+                {
+                    FlushCircles();
+                    ResetCircleBatch();
+                }
+                instance = s_Data.CircleInstanceBufferPtr;
+                s_Data.CircleInstanceBufferPtr++;
+                s_Data.CircleInstanceCount++;
+                s_Data.CircleSceneCount++;
+            }
+
+            GetQuadAxes(transform, instance->Center, instance->HalfAxisX, instance->HalfAxisY);
+            instance->Color = PackColor(color);
+            instance->Thickness = PackHalf(thickness);
+            instance->Fade = PackHalf(fade);
+            instance->EntityId = entityId;
+            return;
         }
 
-        for (uint32_t i = 0; i < 4; i++)
+        CircleVertex* vertices;
+        if (auto* recorder = Recorder())
         {
-            s_Data.CircleVertexBufferPtr->WorldPosition = (transform * s_Data.QuadVertexPositions[i]).XYZ();
-            s_Data.CircleVertexBufferPtr->LocalPosition.x = 2.f * s_Data.QuadVertexPositions[i].x;
-            s_Data.CircleVertexBufferPtr->LocalPosition.y = 2.f * s_Data.QuadVertexPositions[i].y;
-            s_Data.CircleVertexBufferPtr->Color = color;
-            s_Data.CircleVertexBufferPtr->Thickness = thickness;
-            s_Data.CircleVertexBufferPtr->Fade = fade;
-            s_Data.CircleVertexBufferPtr->EntityId = entityId;
-            s_Data.CircleVertexBufferPtr++;
+            vertices = RecordPrimitive(recorder->CircleVertices, 4);
+            RecordQueueEntry(*recorder, RecordType::Circle, recorder->CircleVertices.size() / 4 - 1, transform, color.w < 1.f || fade > 0.f);
+        }
+        else
+        {
+            if (s_Data.CircleIndexCount >= s_Data.MaxCircles * 6)
+            {
+                FlushCircles();
+                ResetCircleBatch();
+            }
+            vertices = s_Data.CircleVertexBufferPtr;
+            s_Data.CircleVertexBufferPtr += 4;
+            s_Data.CircleIndexCount += 6;
+            s_Data.CircleSceneCount++;
         }
-        s_Data.CircleIndexCount += 6;
-
 
-        s_Data.Stats.QuadCount++;
+        uint32_t packedColor = PackColor(color);
+        uint16_t packedThickness = PackHalf(thickness), packedFade = PackHalf(fade);
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            vertices[i].WorldPosition = (transform * s_Data.QuadVertexPositions[i]).XYZ();
+            vertices[i].LocalPosition = PackHalf2(2.f * s_Data.QuadVertexPositions[i].x, 2.f * s_Data.QuadVertexPositions[i].y);
+            vertices[i].Color = packedColor;
+            vertices[i].Thickness = packedThickness;
+            vertices[i].Fade = packedFade;
+            vertices[i].EntityId = entityId;
+        }
     }
 
 
@@ -762,20 +1551,37 @@ namespace Limnova
     void Renderer2D::FlushEllipses()
     {
         LV_PROFILE_FUNCTION();
+        StatisticsTimer timer(s_Data.Stats.Ellipses.FlushMillis);
 
-        if (s_Data.EllipseIndexCount == 0) {
-            return;
-        }
+        if (s_Data.EllipseInstanceCount > 0)
+        {
+            s_Data.EllipseInstanceShader->Bind();
 
-        s_Data.EllipseShader->Bind();
+            uint32_t dataSize = (uint8_t*)s_Data.EllipseInstanceBufferPtr - (uint8_t*)s_Data.EllipseInstanceBufferBase;
 
-        uint32_t dataSize = (uint8_t*)s_Data.EllipseVertexBufferPtr - (uint8_t*)s_Data.EllipseVertexBufferBase;
-        s_Data.EllipseVertexBuffer->SetData(s_Data.EllipseVertexBufferBase, dataSize);
+            RenderCommand::DrawIndexedInstanced(s_Data.EllipseInstanceVertexArray, 6, s_Data.EllipseInstanceCount, s_Data.EllipseInstanceBuffer->GetRegionOffset() / sizeof(EllipseInstance));
+            s_Data.EllipseInstanceBuffer->EndRegion();
 
-        RenderCommand::DrawIndexed(s_Data.EllipseVertexArray, s_Data.EllipseIndexCount);
+            s_Data.Stats.DrawCalls++;
+            s_Data.Stats.BytesUploaded += dataSize;
+            s_Data.Stats.Ellipses.Flushes++;
+            s_Data.Stats.Ellipses.Bytes += dataSize;
+        }
 
+        if (s_Data.EllipseIndexCount > 0)
+        {
+            s_Data.EllipseShader->Bind();
 
-        s_Data.Stats.DrawCalls++;
+            uint32_t dataSize = (uint8_t*)s_Data.EllipseVertexBufferPtr - (uint8_t*)s_Data.EllipseVertexBufferBase;
+
+            RenderCommand::DrawIndexed(s_Data.EllipseVertexArray, s_Data.EllipseIndexCount, s_Data.EllipseVertexBuffer->GetRegionOffset() / sizeof(EllipseVertex));
+            s_Data.EllipseVertexBuffer->EndRegion();
+
+            s_Data.Stats.DrawCalls++;
+            s_Data.Stats.BytesUploaded += dataSize;
+            s_Data.Stats.Ellipses.Flushes++;
+            s_Data.Stats.Ellipses.Bytes += dataSize;
+        }
     }
 
 
@@ -784,20 +1590,86 @@ namespace Limnova
         LV_PROFILE_FUNCTION();
 
         s_Data.EllipseIndexCount = 0;
+        s_Data.EllipseVertexBufferBase = (EllipseVertex*)s_Data.EllipseVertexBuffer->BeginRegion();
         s_Data.EllipseVertexBufferPtr = s_Data.EllipseVertexBufferBase;
+
+        s_Data.EllipseInstanceCount = 0;
+        s_Data.EllipseInstanceBufferBase = (EllipseInstance*)s_Data.EllipseInstanceBuffer->BeginRegion();
+        s_Data.EllipseInstanceBufferPtr = s_Data.EllipseInstanceBufferBase;
+    }
+
+
+    void Renderer2D::SubmitEllipseInstance(const Matrix4& transform, const Vector2& perifocalExtent, float semiMajorAxis, float semiMinorAxis, const Vector2& cutoffPoint, const Vector2& cutoffNormal, const Vector4& color, float thickness, float fade, int entityId)
+    {
+        EllipseInstance* instance;
+        if (auto* recorder = Recorder())
+        {
+            instance = RecordPrimitive(recorder->EllipseInstances, 1);
+            RecordQueueEntry(*recorder, RecordType::EllipseInstance, recorder->EllipseInstances.size() - 1, transform, color.w < 1.f || fade > 0.f);
+        }
+        else
+        {
+            if (s_Data.EllipseInstanceCount >= s_Data.MaxEllipses)
+            {
+                FlushEllipses();
+                ResetEllipseBatch();
+            }
+            instance = s_Data.EllipseInstanceBufferPtr;
+            s_Data.EllipseInstanceBufferPtr++;
+            s_Data.EllipseInstanceCount++;
+            s_Data.EllipseSceneCount++;
+        }
+
+        GetQuadAxes(transform, instance->Center, instance->HalfAxisX, instance->HalfAxisY);
+        instance->PerifocalExtent = perifocalExtent;
+        instance->Color = PackColor(color);
+        instance->SemiMajorAxis = semiMajorAxis;
+        instance->SemiMinorAxis = semiMinorAxis;
+        instance->CutoffPoint = cutoffPoint;
+        instance->CutoffNormal = cutoffNormal;
+        instance->Thickness = thickness;
+        instance->Fade = fade;
+        instance->EntityId = entityId;
+
+        CurrentStatistics().Ellipses.Count++;
     }
 
 
     void Renderer2D::DrawBatchedEllipse(const Matrix4& transform, float majorMinorAxisRatio, Vector2 cutoffPoint, Vector2 cutoffNormal, const Vector4& color, float thickness, float fade, int entityId)
     {
         LV_PROFILE_FUNCTION();
+        StatisticsTimer timer(CurrentStatistics().Ellipses.DrawMillis);
 
-        if (s_Data.EllipseIndexCount >= s_Data.MaxEllipseIndices)
+        if (s_Data.UseInstancing)
         {
-            FlushEllipses();
-            ResetEllipseBatch();
+            /* The quad is padded by half the thickness on each side, in the quad's local space */
+            float paddedScale = 1.f + thickness;
+            Matrix4 paddedTransform = glm::scale((glm::mat4)transform, glm::vec3{ paddedScale, paddedScale, 1.f });
+            SubmitEllipseInstance(paddedTransform, { paddedScale * majorMinorAxisRatio, paddedScale }, majorMinorAxisRatio, 1.f,
+                cutoffPoint, cutoffNormal, color, thickness, fade, entityId);
+            return;
         }
 
+        EllipseVertex* vertices;
+        if (auto* recorder = Recorder())
+        {
+            vertices = RecordPrimitive(recorder->EllipseVertices, 4);
+            RecordQueueEntry(*recorder, RecordType::Ellipse, recorder->EllipseVertices.size() / 4 - 1, transform, color.w < 1.f || fade > 0.f);
+        }
+        else
+        {
+            if (s_Data.EllipseIndexCount >= s_Data.MaxEllipses * 6)
+            {
+                FlushEllipses();
+                ResetEllipseBatch();
+            }
+            vertices = s_Data.EllipseVertexBufferPtr;
+            s_Data.EllipseVertexBufferPtr += 4;
+            s_Data.EllipseIndexCount += 6;
+            s_Data.EllipseSceneCount++;
+        }
+
+        uint32_t packedColor = PackColor(color);
         for (uint32_t i = 0; i < 4; i++)
         {
             /* for Orbital_Ellipse.lvglsl */
@@ -807,23 +1679,20 @@ namespace Limnova
                 (i == 0 || i == 1) ? -vertexPadding : vertexPadding,
                 0.f, 0.f
             };
-            s_Data.EllipseVertexBufferPtr->WorldPosition = (transform * (s_Data.QuadVertexPositions[i] + vertexPositionPadding)).XYZ();
-            s_Data.EllipseVertexBufferPtr->LocalPosition.x = 2.f * (s_Data.QuadVertexPositions[i].x + vertexPositionPadding.x) * majorMinorAxisRatio;
-            s_Data.EllipseVertexBufferPtr->LocalPosition.y = 2.f * (s_Data.QuadVertexPositions[i].y + vertexPositionPadding.y);
-            s_Data.EllipseVertexBufferPtr->Color = color;
-            s_Data.EllipseVertexBufferPtr->SemiMajorAxis = majorMinorAxisRatio;
-            s_Data.EllipseVertexBufferPtr->SemiMinorAxis = 1.0f;
-            s_Data.EllipseVertexBufferPtr->CutoffPoint = cutoffPoint;
-            s_Data.EllipseVertexBufferPtr->CutoffNormal = cutoffNormal;
-            s_Data.EllipseVertexBufferPtr->Thickness = thickness;
-            s_Data.EllipseVertexBufferPtr->Fade = fade;
-            s_Data.EllipseVertexBufferPtr->EntityId = entityId;
-            s_Data.EllipseVertexBufferPtr++;
+            vertices[i].WorldPosition = (transform * (s_Data.QuadVertexPositions[i] + vertexPositionPadding)).XYZ();
+            vertices[i].LocalPosition.x = 2.f * (s_Data.QuadVertexPositions[i].x + vertexPositionPadding.x) * majorMinorAxisRatio;
+            vertices[i].LocalPosition.y = 2.f * (s_Data.QuadVertexPositions[i].y + vertexPositionPadding.y);
+            vertices[i].Color = packedColor;
+            vertices[i].SemiMajorAxis = majorMinorAxisRatio;
+            vertices[i].SemiMinorAxis = 1.0f;
+            vertices[i].CutoffPoint = cutoffPoint;
+            vertices[i].CutoffNormal = cutoffNormal;
+            vertices[i].Thickness = thickness;
+            vertices[i].Fade = fade;
+            vertices[i].EntityId = entityId;
         }
-        s_Data.EllipseIndexCount += 6;
 
-
-        s_Data.Stats.QuadCount++;
+        CurrentStatistics().Ellipses.Count++;
     }
 
 
@@ -849,8 +1718,15 @@ namespace Limnova
 
     void Renderer2D::DrawOrbitalEllipse(const Vector3& center, const Quaternion& orientation, const OrbitalComponent& component, const Vector4& color, float thickness, float fade, int entityId)
     {
-        auto& orbit = component.Object.GetOrbit();
-        auto& elems = orbit.Elements;
+        auto& orbit = component.Object.GetOrbitBudgeted();
+        float taExit = component.Object.IsDynamic() ? orbit.TaExit : PI2f;
+        DrawOrbitalEllipse(center, orientation, orbit.Elements, taExit, color, thickness, fade, entityId);
+    }
+
+
+    void Renderer2D::DrawOrbitalEllipse(const Vector3& center, const Quaternion& orientation, const OrbitalPhysics::Elements& elems, float taExit, const Vector4& color, float thickness, float fade, int entityId)
+    {
+        StatisticsTimer timer(CurrentStatistics().Ellipses.DrawMillis);
 
         Matrix4 transform = glm::translate(glm::mat4(1.f), (glm::vec3)center);
         transform = transform * Matrix4(orientation);
@@ -858,49 +1734,65 @@ namespace Limnova
 
         Vector2 cutoffPoint = { 0.f }; /* the point on the orbit path above the x-axis (positive y-component) at which the orbit should stop being drawn */
         Vector2 cutoffNormal = { 0.f }; /* the normal to the the cutoff line, equal to the unit direction vector of the orbit velocity at the cutoff point */
-        if (component.Object.IsDynamic())
+        if (taExit < PI2f) // TEMP !
         {
-            if (orbit.TaExit < PI2f) // TEMP !
-            {
-                cutoffPoint = { OrbitalPhysics::kLocalSpaceEscapeRadius * cosf(orbit.TaExit) - elems.C, /* subtract center's x-offset to convert x-component to the perifocal frame */
-                    OrbitalPhysics::kLocalSpaceEscapeRadius * sinf(orbit.TaExit) };
+            cutoffPoint = { OrbitalPhysics::kLocalSpaceEscapeRadius * cosf(taExit) - elems.C, /* subtract center's x-offset to convert x-component to the perifocal frame */
+                OrbitalPhysics::kLocalSpaceEscapeRadius * sinf(taExit) };
 
-                // Compute cutoff normal from the orbit velocity at the cutoff point
-                cutoffNormal.x = -sinf(orbit.TaExit);
-                cutoffNormal.y = elems.E + cosf(orbit.TaExit);
-                cutoffNormal.Normalize();
-            }
+            // Compute cutoff normal from the orbit velocity at the cutoff point
+            cutoffNormal.x = -sinf(taExit);
+            cutoffNormal.y = elems.E + cosf(taExit);
+            cutoffNormal.Normalize();
         }
 
         // Submit to batch
-        if (s_Data.EllipseIndexCount >= s_Data.MaxEllipseIndices)
+        if (s_Data.UseInstancing)
+        {
+            Vector2 perifocalExtent = { elems.SemiMajor + thickness / 2.f, elems.SemiMinor + thickness / 2.f };
+            SubmitEllipseInstance(transform, perifocalExtent, elems.SemiMajor, elems.SemiMinor,
+                cutoffPoint, cutoffNormal, color, thickness, fade, entityId);
+            return;
+        }
+
+        EllipseVertex* vertices;
+        if (auto* recorder = Recorder())
+        {
+            vertices = RecordPrimitive(recorder->EllipseVertices, 4);
+            RecordQueueEntry(*recorder, RecordType::Ellipse, recorder->EllipseVertices.size() / 4 - 1, transform, color.w < 1.f || fade > 0.f);
+        }
+        else
         {
-            FlushEllipses();
-            ResetEllipseBatch();
+            if (s_Data.EllipseIndexCount >= s_Data.MaxEllipses * 6)
+            {
+                FlushEllipses();
+                ResetEllipseBatch();
+            }
+            vertices = s_Data.EllipseVertexBufferPtr;
+            s_Data.EllipseVertexBufferPtr += 4;
+            s_Data.EllipseIndexCount += 6;
+            s_Data.EllipseSceneCount++;
         }
 
+        uint32_t packedColor = PackColor(color);
         for (uint32_t i = 0; i < 4; i++)
         {
             float padX = (i == 0 || i == 3) ? -thickness / 2.f : thickness / 2.f;
             float padY = (i == 0 || i == 1) ? -thickness / 2.f : thickness / 2.f;
 
-            s_Data.EllipseVertexBufferPtr->WorldPosition = (transform * s_Data.QuadVertexPositions[i]).XYZ();
-            s_Data.EllipseVertexBufferPtr->LocalPosition.x = s_Data.QuadVertexPositions[i].x * 2.f * elems.SemiMajor + padX;
-            s_Data.EllipseVertexBufferPtr->LocalPosition.y = s_Data.QuadVertexPositions[i].y * 2.f * elems.SemiMinor + padY;
-            s_Data.EllipseVertexBufferPtr->Color = color;
-            s_Data.EllipseVertexBufferPtr->SemiMajorAxis = elems.SemiMajor;
-            s_Data.EllipseVertexBufferPtr->SemiMinorAxis = elems.SemiMinor;
-            s_Data.EllipseVertexBufferPtr->CutoffPoint = cutoffPoint;
-            s_Data.EllipseVertexBufferPtr->CutoffNormal = cutoffNormal;
-            s_Data.EllipseVertexBufferPtr->Thickness = thickness;
-            s_Data.EllipseVertexBufferPtr->Fade = fade;
-            s_Data.EllipseVertexBufferPtr->EntityId = entityId;
-            s_Data.EllipseVertexBufferPtr++;
+            vertices[i].WorldPosition = (transform * s_Data.QuadVertexPositions[i]).XYZ();
+            vertices[i].LocalPosition.x = s_Data.QuadVertexPositions[i].x * 2.f * elems.SemiMajor + padX;
+            vertices[i].LocalPosition.y = s_Data.QuadVertexPositions[i].y * 2.f * elems.SemiMinor + padY;
+            vertices[i].Color = packedColor;
+            vertices[i].SemiMajorAxis = elems.SemiMajor;
+            vertices[i].SemiMinorAxis = elems.SemiMinor;
+            vertices[i].CutoffPoint = cutoffPoint;
+            vertices[i].CutoffNormal = cutoffNormal;
+            vertices[i].Thickness = thickness;
+            vertices[i].Fade = fade;
+            vertices[i].EntityId = entityId;
         }
-        s_Data.EllipseIndexCount += 6;
 
-
-        s_Data.Stats.QuadCount++;
+        CurrentStatistics().Ellipses.Count++;
     }
 
 
@@ -909,6 +1801,7 @@ namespace Limnova
     void Renderer2D::FlushHyperbolas()
     {
         LV_PROFILE_FUNCTION();
+        StatisticsTimer timer(s_Data.Stats.Hyperbolas.FlushMillis);
 
         if (s_Data.HyperbolaIndexCount == 0) {
             return;
@@ -917,12 +1810,15 @@ namespace Limnova
         s_Data.HyperbolaShader->Bind();
 
         uint32_t dataSize = (uint8_t*)s_Data.HyperbolaVertexBufferPtr - (uint8_t*)s_Data.HyperbolaVertexBufferBase;
-        s_Data.HyperbolaVertexBuffer->SetData(s_Data.HyperbolaVertexBufferBase, dataSize);
 
-        RenderCommand::DrawIndexed(s_Data.HyperbolaVertexArray, s_Data.HyperbolaIndexCount);
+        RenderCommand::DrawIndexed(s_Data.HyperbolaVertexArray, s_Data.HyperbolaIndexCount, s_Data.HyperbolaVertexBuffer->GetRegionOffset() / sizeof(HyperbolaVertex));
+        s_Data.HyperbolaVertexBuffer->EndRegion();
 
 
         s_Data.Stats.DrawCalls++;
+        s_Data.Stats.BytesUploaded += dataSize;
+        s_Data.Stats.Hyperbolas.Flushes++;
+        s_Data.Stats.Hyperbolas.Bytes += dataSize;
     }
 
 
@@ -931,24 +1827,32 @@ namespace Limnova
         LV_PROFILE_FUNCTION();
 
         s_Data.HyperbolaIndexCount = 0;
+        s_Data.HyperbolaVertexBufferBase = (HyperbolaVertex*)s_Data.HyperbolaVertexBuffer->BeginRegion();
         s_Data.HyperbolaVertexBufferPtr = s_Data.HyperbolaVertexBufferBase;
     }
 
 
     void Renderer2D::DrawOrbitalHyperbola(const Vector3& center, const Quaternion& orientation, const OrbitalComponent& component, const Vector4& color, float thickness, float fade, int entityId)
     {
-        auto& orbit = component.Object.GetOrbit();
-        auto& elems = orbit.Elements;
+        auto& orbit = component.Object.GetOrbitBudgeted();
+        DrawOrbitalHyperbola(center, orientation, orbit.Elements, orbit.TaExit, color, thickness, fade, entityId);
+    }
+
+
+    void Renderer2D::DrawOrbitalHyperbola(const Vector3& center, const Quaternion& orientation, const OrbitalPhysics::Elements& elems, float taExit, const Vector4& color, float thickness, float fade, int entityId)
+    {
+        StatisticsTimer timer(CurrentStatistics().Hyperbolas.DrawMillis);
+
         LV_CORE_ASSERT(elems.Type == OrbitalPhysics::OrbitType::Hyperbola, "Orbit must be hyperbolic!");
 
         Vector2 cutoffPoint /* the point on the orbit path above the x-axis (positive y-component) at which the orbit should stop being drawn */
-            { OrbitalPhysics::kLocalSpaceEscapeRadius * cosf(orbit.TaExit) - elems.C, /* subtract center's x-offset to convert x-component to the perifocal frame */
-                OrbitalPhysics::kLocalSpaceEscapeRadius * sinf(orbit.TaExit)};
+            { OrbitalPhysics::kLocalSpaceEscapeRadius * cosf(taExit) - elems.C, /* subtract center's x-offset to convert x-component to the perifocal frame */
+                OrbitalPhysics::kLocalSpaceEscapeRadius * sinf(taExit)};
         Vector2 cutoffNormal = { 0.f }; /* the normal to the cutoff line, equal to the unit direction vector of the orbit velocity at the cutoff point */
 
         // Compute cutoff normal from the orbit velocity at the cutoff point
-        cutoffNormal.x = -sinf(orbit.TaExit);
-        cutoffNormal.y = elems.E + cosf(orbit.TaExit);
+        cutoffNormal.x = -sinf(taExit);
+        cutoffNormal.y = elems.E + cosf(taExit);
         cutoffNormal.Normalize();
 
         // Transform
@@ -960,28 +1864,42 @@ namespace Limnova
         transform = glm::scale((glm::mat4)transform, glm::vec3{ glm::vec2{ triangleMaxX, triangleMaxY }, 0.f });
 
         // Submit to batch
-        if (s_Data.HyperbolaIndexCount >= s_Data.MaxHyperbolaIndices)
+        HyperbolaVertex* vertices;
+        if (auto* recorder = Recorder())
         {
-            FlushHyperbolas();
-            ResetHyperbolaBatch();
+            vertices = RecordPrimitive(recorder->HyperbolaVertices, 3);
+            RecordQueueEntry(*recorder, RecordType::Hyperbola, recorder->HyperbolaVertices.size() / 3 - 1, transform, color.w < 1.f || fade > 0.f);
+        }
+        else
+        {
+            if (s_Data.HyperbolaIndexCount >= s_Data.MaxHyperbolas * 3)
+            {
+                FlushHyperbolas();
+                ResetHyperbolaBatch();
+            }
+            vertices = s_Data.HyperbolaVertexBufferPtr;
+            s_Data.HyperbolaVertexBufferPtr += 3;
+            s_Data.HyperbolaIndexCount += 3;
+            s_Data.HyperbolaSceneCount++;
         }
 
+        uint32_t packedColor = PackColor(color);
         for (uint32_t i = 0; i < 3; i++)
         {
-            s_Data.HyperbolaVertexBufferPtr->WorldPosition = (transform * s_Data.HyperbolaVertexPositions[i]).XYZ();
-            s_Data.HyperbolaVertexBufferPtr->LocalPosition.x = s_Data.HyperbolaVertexPositions[i].x * triangleMaxX;
-            s_Data.HyperbolaVertexBufferPtr->LocalPosition.y = s_Data.HyperbolaVertexPositions[i].y * triangleMaxY;
-            s_Data.HyperbolaVertexBufferPtr->Color = color;
-            s_Data.HyperbolaVertexBufferPtr->SemiMajorAxis = elems.SemiMajor;
-            s_Data.HyperbolaVertexBufferPtr->SemiMinorAxis = elems.SemiMinor;
-            s_Data.HyperbolaVertexBufferPtr->CutoffPoint = cutoffPoint;
-            s_Data.HyperbolaVertexBufferPtr->CutoffNormal = cutoffNormal;
-            s_Data.HyperbolaVertexBufferPtr->Thickness = thickness;
-            s_Data.HyperbolaVertexBufferPtr->Fade = fade;
-            s_Data.HyperbolaVertexBufferPtr->EntityId = entityId;
-            s_Data.HyperbolaVertexBufferPtr++;
+            vertices[i].WorldPosition = (transform * s_Data.HyperbolaVertexPositions[i]).XYZ();
+            vertices[i].LocalPosition.x = s_Data.HyperbolaVertexPositions[i].x * triangleMaxX;
+            vertices[i].LocalPosition.y = s_Data.HyperbolaVertexPositions[i].y * triangleMaxY;
+            vertices[i].Color = packedColor;
+            vertices[i].SemiMajorAxis = elems.SemiMajor;
+            vertices[i].SemiMinorAxis = elems.SemiMinor;
+            vertices[i].CutoffPoint = cutoffPoint;
+            vertices[i].CutoffNormal = cutoffNormal;
+            vertices[i].Thickness = thickness;
+            vertices[i].Fade = fade;
+            vertices[i].EntityId = entityId;
         }
-        s_Data.HyperbolaIndexCount += 6;
+
+        CurrentStatistics().Hyperbolas.Count++;
     }
 
 
@@ -990,20 +1908,37 @@ namespace Limnova
     void Renderer2D::FlushLines()
     {
         LV_PROFILE_FUNCTION();
+        StatisticsTimer timer(s_Data.Stats.Lines.FlushMillis);
 
-        if (s_Data.LineIndexCount == 0) {
-            return;
-        }
+        if (s_Data.LineInstanceCount > 0)
+        {
+            s_Data.LineInstanceShader->Bind();
 
-        s_Data.LineShader->Bind();
+            uint32_t dataSize = (uint8_t*)s_Data.LineInstanceBufferPtr - (uint8_t*)s_Data.LineInstanceBufferBase;
 
-        uint32_t dataSize = (uint8_t*)s_Data.LineVertexBufferPtr - (uint8_t*)s_Data.LineVertexBufferBase;
-        s_Data.LineVertexBuffer->SetData(s_Data.LineVertexBufferBase, dataSize);
+            RenderCommand::DrawIndexedInstanced(s_Data.LineInstanceVertexArray, 6, s_Data.LineInstanceCount, s_Data.LineInstanceBuffer->GetRegionOffset() / sizeof(LineInstance));
+            s_Data.LineInstanceBuffer->EndRegion();
 
-        RenderCommand::DrawIndexed(s_Data.LineVertexArray, s_Data.LineIndexCount);
+            s_Data.Stats.DrawCalls++;
+            s_Data.Stats.BytesUploaded += dataSize;
+            s_Data.Stats.Lines.Flushes++;
+            s_Data.Stats.Lines.Bytes += dataSize;
+        }
+
+        if (s_Data.LineIndexCount > 0)
+        {
+            s_Data.LineShader->Bind();
 
+            uint32_t dataSize = (uint8_t*)s_Data.LineVertexBufferPtr - (uint8_t*)s_Data.LineVertexBufferBase;
 
-        s_Data.Stats.DrawCalls++;
+            RenderCommand::DrawIndexed(s_Data.LineVertexArray, s_Data.LineIndexCount, s_Data.LineVertexBuffer->GetRegionOffset() / sizeof(LineVertex));
+            s_Data.LineVertexBuffer->EndRegion();
+
+            s_Data.Stats.DrawCalls++;
+            s_Data.Stats.BytesUploaded += dataSize;
+            s_Data.Stats.Lines.Flushes++;
+            s_Data.Stats.Lines.Bytes += dataSize;
+        }
     }
 
 
@@ -1012,37 +1947,85 @@ namespace Limnova
         LV_PROFILE_FUNCTION();
 
         s_Data.LineIndexCount = 0;
+        s_Data.LineVertexBufferBase = (LineVertex*)s_Data.LineVertexBuffer->BeginRegion();
         s_Data.LineVertexBufferPtr = s_Data.LineVertexBufferBase;
+
+        s_Data.LineInstanceCount = 0;
+        s_Data.LineInstanceBufferBase = (LineInstance*)s_Data.LineInstanceBuffer->BeginRegion();
+        s_Data.LineInstanceBufferPtr = s_Data.LineInstanceBufferBase;
     }
 
 
     void Renderer2D::DrawBatchedLine(const Matrix4& transform, const Vector4& color, float length, float thickness, float dashLength, float gapLength, int entityId)
     {
         LV_PROFILE_FUNCTION();
+        StatisticsTimer timer(CurrentStatistics().Lines.DrawMillis);
+        CurrentStatistics().Lines.Count++;
 
-        if (s_Data.LineIndexCount >= s_Data.MaxLineIndices)
+        if (s_Data.UseInstancing)
         {
-            FlushLines();
-            ResetLineBatch();
+            LineInstance* instance;
+            if (auto* recorder = Recorder())
+            {
+                instance = RecordPrimitive(recorder->LineInstances, 1);
+                RecordQueueEntry(*recorder, RecordType::LineInstance, recorder->LineInstances.size() - 1, transform, color.w < 1.f);
+            }
+            else
+            {
+                if (s_Data.LineInstanceCount >= s_Data.MaxLines)
+                {
+                    FlushLines();
+                    ResetLineBatch();
+                }
+                instance = s_Data.LineInstanceBufferPtr;
+                s_Data.LineInstanceBufferPtr++;
+                s_Data.LineInstanceCount++;
+                s_Data.LineSceneCount++;
+            }
+
+            GetQuadAxes(transform, instance->Center, instance->HalfAxisX, instance->HalfAxisY);
+            instance->Color = PackColor(color);
+            instance->Length = length;
+            instance->Thickness = thickness;
+            instance->DashLength = dashLength;
+            instance->GapLength = gapLength;
+            instance->EntityId = entityId;
+            return;
         }
 
-        for (uint32_t i = 0; i < 4; i++)
+        LineVertex* vertices;
+        if (auto* recorder = Recorder())
         {
-            s_Data.LineVertexBufferPtr->WorldPosition = (transform * s_Data.QuadVertexPositions[i]).XYZ();
-            s_Data.LineVertexBufferPtr->LocalPosition.x = s_Data.QuadVertexPositions[i].x + 0.5f;   // X range: [0, 1]
-            s_Data.LineVertexBufferPtr->LocalPosition.y = s_Data.QuadVertexPositions[i].y;          // Y range: [-0.5, 0.5]
-            s_Data.LineVertexBufferPtr->Color = color;
-            s_Data.LineVertexBufferPtr->Length = length;
-            s_Data.LineVertexBufferPtr->Thickness = thickness;
-            s_Data.LineVertexBufferPtr->DashLength = dashLength;
-            s_Data.LineVertexBufferPtr->GapLength = gapLength;
-            s_Data.LineVertexBufferPtr->EntityId = entityId;
-            s_Data.LineVertexBufferPtr++;
+            vertices = RecordPrimitive(recorder->LineVertices, 4);
+            RecordQueueEntry(*recorder, RecordType::Line, recorder->LineVertices.size() / 4 - 1, transform, color.w < 1.f);
+        }
+        else
+        {
+            if (s_Data.LineIndexCount >= s_Data.MaxLines * 6)
+            {
+                FlushLines();
+                ResetLineBatch();
+            }
+            vertices = s_Data.LineVertexBufferPtr;
+            s_Data.LineVertexBufferPtr += 4;
+            s_Data.LineIndexCount += 6;
+            s_Data.LineSceneCount++;
         }
-        s_Data.LineIndexCount += 6;
-
 
-        s_Data.Stats.QuadCount++;
+        uint32_t packedColor = PackColor(color);
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            vertices[i].WorldPosition = (transform * s_Data.QuadVertexPositions[i]).XYZ();
+            vertices[i].LocalPosition = PackHalf2(
+                s_Data.QuadVertexPositions[i].x + 0.5f,     // X range: [0, 1]
+                s_Data.QuadVertexPositions[i].y);           // Y range: [-0.5, 0.5]
+            vertices[i].Color = packedColor;
+            vertices[i].Length = length;
+            vertices[i].Thickness = thickness;
+            vertices[i].DashLength = dashLength;
+            vertices[i].GapLength = gapLength;
+            vertices[i].EntityId = entityId;
+        }
     }
 
 
@@ -1355,13 +2338,52 @@ namespace Limnova
     }
 
 
+    void Renderer2D::SetBatchCapacityLimit(uint32_t maxPrimitives)
+    {
+        s_Data.BatchCapacityLimit = maxPrimitives;
+    }
+
+    uint32_t Renderer2D::GetBatchCapacityLimit()
+    {
+        return s_Data.BatchCapacityLimit;
+    }
+
+
+    void Renderer2D::SetRenderQueue(bool enabled)
+    {
+        s_Data.UseRenderQueue = enabled;
+    }
+
+    bool Renderer2D::IsRenderQueueEnabled()
+    {
+        return s_Data.UseRenderQueue;
+    }
+
+    void Renderer2D::SetLayer(uint8_t layer)
+    {
+        s_Layer = layer;
+    }
+
+
+    void Renderer2D::SetInstancing(bool enabled)
+    {
+        s_Data.UseInstancing = enabled;
+    }
+
+    bool Renderer2D::IsInstancing()
+    {
+        return s_Data.UseInstancing;
+    }
+
+
     Renderer2D::Statistics& Renderer2D::GetStatistics()
     {
-        return s_Data.Stats;
+        return CurrentStatistics();
     }
 
     void Renderer2D::ResetStatistics()
     {
         memset(&s_Data.Stats, 0, sizeof(Statistics));
+        UpdateCapacityStatistics();
     }
 }
@@ -21,8 +21,56 @@ namespace Limnova
         static void BeginScene(Camera& camera);
         static void EndScene();
 
+        /// <summary>
+        /// Circles, ellipses and lines are drawn as instances of a shared quad, with one compact record per primitive, unless
+        /// instancing is disabled - then they fall back to batches of four full vertices per primitive.
+        /// </summary>
+        static void SetInstancing(bool enabled);
+        static bool IsInstancing();
+
+        /// <summary>
+        /// Each batch starts small and grows to fit the most primitives of its type drawn in a single scene, so that crowded
+        /// scenes are not flushed mid-frame - up to this limit, in primitives per batch. Lowering the limit does not shrink
+        /// batches which have already grown.
+        /// </summary>
+        static void SetBatchCapacityLimit(uint32_t maxPrimitives);
+        static uint32_t GetBatchCapacityLimit();
+
+        /// <summary>
+        /// While the render queue is enabled, primitives are not batched as they are drawn: the scene's primitives are recorded with a
+        /// sort key (layer, opacity, shader, texture and depth), radix-sorted at EndScene(), then batched in key order. Opaque primitives
+        /// are grouped by shader and texture so each is bound as few times as possible; transparent primitives - translucent color,
+        /// faded edges or textured - are drawn after them and back-to-front, so they blend over everything behind them whatever their
+        /// type. The queue stages every primitive in CPU memory before copying it to the batches, so it is disabled by default - scenes
+        /// with translucent primitives over others (e.g, OrbitalScene) enable it around their own BeginScene()/EndScene().
+        /// Changes take effect from the next BeginScene().
+        /// </summary>
+        static void SetRenderQueue(bool enabled);
+        static bool IsRenderQueueEnabled();
+
+        /// <summary> Render queue layer of the calling thread's subsequent draws - lower layers are drawn first </summary>
+        static void SetLayer(uint8_t layer);
+
+        /// <summary>
+        /// Per-thread recording of Draw calls. Acquire one command buffer per unit of parallel work from the rendering thread, in the
+        /// order their contents should be drawn, then have worker threads call BeginRecording() before drawing and EndRecording()
+        /// after: while a thread is recording, its Draw calls (and GetStatistics()) go to its command buffer rather than the shared
+        /// batches. EndScene() merges the scene's command buffers into the batches in acquisition order - after any primitives drawn
+        /// directly - so the result does not depend on thread scheduling. All recording must have ended before EndScene().
+        /// </summary>
+        struct CommandBuffer;
+        static CommandBuffer& AcquireCommandBuffer();
+        static void BeginRecording(CommandBuffer& commandBuffer);
+        static void EndRecording();
+    private:
+        static void MergeCommandBuffer(CommandBuffer& commandBuffer);
+        static void AppendToQueue(CommandBuffer& commandBuffer);
+        static void SubmitQueue();
+    public:
+
         // Quads //
     private:
+        static float GetTextureIndex(const Ref<Texture2D>& texture);
         static void DrawBatchedQuad(const Matrix4& transform, const Vector4& color, const Vector2* textureCoords, const Vector2& textureScale, const float textureIndex, int entityId = -1);
     public:
         static void DrawQuad(const Matrix4& transform, const Vector4& color, int entityId = -1);
@@ -50,15 +98,18 @@ namespace Limnova
 
         // Ellipses //
     private:
+        static void SubmitEllipseInstance(const Matrix4& transform, const Vector2& perifocalExtent, float semiMajorAxis, float semiMinorAxis, const Vector2& cutoffPoint, const Vector2& cutoffNormal, const Vector4& color, float thickness, float fade, int entityId);
         static void DrawBatchedEllipse(const Matrix4& transform, float majorMinorAxisRatio, Vector2 cutoffPoint, Vector2 cutoffNormal, const Vector4& color, float thickness = 1.f, float fade = 0.005f, int entityId = -1);
     public:
         static void DrawEllipse(const Matrix4& transform, float majorMinorAxisRatio, const Vector4& color, float thickness = 1.f, float fade = 0.005f, int entityId = -1);
         static void DrawEllipse(const Vector3& center, const Quaternion& orientation, float semiMajorAxis, float semiMinorAxis, const Vector4& color, float thickness = 1.f, float fade = 0.005f, int entityId = -1);
 
         static void DrawOrbitalEllipse(const Vector3& center, const Quaternion& orientation, const OrbitalComponent& component, const Vector4& color, float thickness = 0.01f, float fade = 0.005f, int entityId = -1);
+        static void DrawOrbitalEllipse(const Vector3& center, const Quaternion& orientation, const OrbitalPhysics::Elements& elems, float taExit, const Vector4& color, float thickness = 0.01f, float fade = 0.005f, int entityId = -1);
 
         // Hyperbolas //
         static void DrawOrbitalHyperbola(const Vector3& center, const Quaternion& orientation, const OrbitalComponent& component, const Vector4& color, float thickness = 0.01f, float fade = 0.005f, int entityId = -1);
+        static void DrawOrbitalHyperbola(const Vector3& center, const Quaternion& orientation, const OrbitalPhysics::Elements& elems, float taExit, const Vector4& color, float thickness = 0.01f, float fade = 0.005f, int entityId = -1);
 
         // Lines //
     private:
@@ -95,13 +146,33 @@ namespace Limnova
 
         // stats
     public:
+        struct PrimitiveStatistics
+        {
+            uint32_t Count;         /* Primitives submitted */
+            uint32_t Flushes;       /* Draw calls - more than one (per drawing path) means the scene overflowed the batch */
+            uint32_t Bytes;         /* Vertex or instance data written for the GPU */
+            uint32_t Capacity;      /* Current batch capacity, in primitives */
+            float DrawMillis;       /* CPU time in the Draw functions which write this primitive, including any flushes they trigger */
+            float FlushMillis;      /* CPU time in this primitive's Flush function */
+        };
+
         struct Statistics
         {
             uint32_t DrawCalls;
-            uint32_t QuadCount;
 
-            uint32_t GetNumVertices() { return QuadCount * 4; }
-            uint32_t GetNumIndices() { return QuadCount * 6; }
+            uint32_t ItemsDrawn;    /* Scene items which passed culling and were submitted for drawing */
+            uint32_t ItemsCulled;   /* Scene items rejected by frustum or screen-size culling before submission */
+
+            uint32_t BytesUploaded; /* Vertex and instance data written to GPU buffers by batch flushes */
+
+            PrimitiveStatistics Quads;
+            PrimitiveStatistics Circles;
+            PrimitiveStatistics Ellipses;
+            PrimitiveStatistics Hyperbolas;
+            PrimitiveStatistics Lines;
+
+            uint32_t GetNumVertices() { return Quads.Count * 4; }
+            uint32_t GetNumIndices() { return Quads.Count * 6; }
         };
         static Statistics& GetStatistics();
         static void ResetStatistics();
@@ -24,7 +24,8 @@ namespace Limnova
         virtual void SetClearColor(const glm::vec4& color) = 0;
         virtual void Clear() = 0;
 
-        virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCound = 0) = 0;
+        virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCound = 0, uint32_t baseVertex = 0) = 0;
+        virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance = 0) = 0;
 
         inline static API GetAPI() { return s_Api; }
     private:
@@ -43,6 +43,18 @@ namespace Limnova
     }
 
 
+    std::vector<Ref<Shader>> Shader::Create(const std::vector<std::string>& filepaths)
+    {
+        switch (Renderer::GetAPI())
+        {
+            case RendererAPI::API::None: LV_CORE_ASSERT(false, "RendererAPI::None is not supported!"); return {};
+            case RendererAPI::API::OpenGL: return OpenGLShader::Create(filepaths);
+        }
+        LV_CORE_ASSERT(false, "Renderer::GetAPI() returned unknown RendererAPI!");
+        return {};
+    }
+
+
     void ShaderLibrary::Add(const std::string& name, const Ref<Shader>& shader)
     {
         LV_CORE_ASSERT(!Exists(name), "Shader already exists with that name!");
@@ -13,6 +13,8 @@ namespace Limnova
         static Ref<Shader> Create(const std::string& filepath);
         static Ref<Shader> Create(const std::string& name, const std::string& filepath);
         static Ref<Shader> Create(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+        /// <summary> Creates shaders from files, compiling them in parallel </summary>
+        static std::vector<Ref<Shader>> Create(const std::vector<std::string>& filepaths);
         virtual ~Shader() {}
 
         virtual const std::string& GetName() const = 0;
@@ -5,8 +5,14 @@ namespace Limnova
 {
 
     SubTexture2D::SubTexture2D(const Ref<Texture2D>& texture, const Vector2& min, const Vector2& max)
-        : m_Texture(texture)
     {
+        SetRegion(texture, min, max);
+    }
+
+
+    void SubTexture2D::SetRegion(const Ref<Texture2D>& texture, const Vector2& min, const Vector2& max)
+    {
+        m_Texture = texture;
         m_TexCoords[0] = { min.x, min.y };
         m_TexCoords[1] = { max.x, min.y };
         m_TexCoords[2] = { max.x, max.y };
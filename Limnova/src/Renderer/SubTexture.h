@@ -16,6 +16,11 @@ namespace Limnova
         const Vector2* GetTexCoords() { return m_TexCoords; }
 
         static Ref<SubTexture2D> CreateFromCoords(const Ref<Texture2D>& texture, const Vector2& coords, const Vector2& cellSize, const Vector2& spriteSize = { 1, 1 });
+    private:
+        void SetRegion(const Ref<Texture2D>& texture, const Vector2& min, const Vector2& max);
+
+        friend class TextureAtlas;
+        friend class TextureLibrary;
     private:
         Ref<Texture2D> m_Texture;
         Vector2 m_TexCoords[4];
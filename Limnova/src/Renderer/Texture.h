@@ -23,6 +23,13 @@ namespace Limnova
         virtual void SetWrapMode(const WrapMode wrap) = 0;
 
         virtual void SetData(void* data, uint32_t size) = 0;
+        /// <summary> Uploads a width*height block of pixels (in the texture's own format) with its bottom-left corner at (x, y) </summary>
+        virtual void SetSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
+        /// <summary>
+        /// Replaces the texture's storage with a width*height image of 3 (RGB8) or 4 (RGBA8) channels. The renderer ID changes,
+        /// but everything holding the texture sees the new image.
+        /// </summary>
+        virtual void SetImage(const void* data, uint32_t width, uint32_t height, uint32_t channels) = 0;
 
         virtual bool operator==(const Texture& other) const = 0;
     };
@@ -0,0 +1,338 @@
+#include "TextureAtlas.h"
+
+#include <stb_image.h>
+
+
+namespace Limnova
+{
+
+    TextureAtlas::SkylinePacker::SkylinePacker(const uint32_t size)
+        : m_Size(size)
+    {
+        m_Nodes.push_back({ 0, 0, size });
+    }
+
+
+    int64_t TextureAtlas::SkylinePacker::Fit(const size_t nodeIndex, const uint32_t width, const uint32_t height) const
+    {
+        uint32_t x = m_Nodes[nodeIndex].X;
+        if (x + width > m_Size) return -1;
+
+        /* The rectangle rests on the highest segment beneath it - the segments cover the page width, so i stays in range */
+        uint32_t y = 0;
+        int64_t widthLeft = width;
+        for (size_t i = nodeIndex; widthLeft > 0; i++)
+        {
+            y = std::max(y, m_Nodes[i].Y);
+            if (y + height > m_Size) return -1;
+            widthLeft -= m_Nodes[i].Width;
+        }
+        return y;
+    }
+
+
+    bool TextureAtlas::SkylinePacker::Insert(const uint32_t width, const uint32_t height, uint32_t& x, uint32_t& y)
+    {
+        size_t bestIndex = m_Nodes.size();
+        uint32_t bestTop = std::numeric_limits<uint32_t>::max();
+        uint32_t bestWidth = std::numeric_limits<uint32_t>::max();
+        for (size_t i = 0; i < m_Nodes.size(); i++)
+        {
+            int64_t fitY = Fit(i, width, height);
+            if (fitY < 0) continue;
+
+            /* Bottom-left rule: lowest top edge, then the narrowest segment to leave wide gaps for later rectangles */
+            uint32_t top = (uint32_t)fitY + height;
+            if (top < bestTop || (top == bestTop && m_Nodes[i].Width < bestWidth))
+            {
+                bestIndex = i;
+                bestTop = top;
+                bestWidth = m_Nodes[i].Width;
+                x = m_Nodes[i].X;
+                y = (uint32_t)fitY;
+            }
+        }
+        if (bestIndex == m_Nodes.size()) return false;
+
+        m_Nodes.insert(m_Nodes.begin() + bestIndex, { x, y + height, width });
+
+        /* Trim or remove the segments now covered by the new one */
+        for (size_t i = bestIndex + 1; i < m_Nodes.size();)
+        {
+            uint32_t previousEnd = m_Nodes[i - 1].X + m_Nodes[i - 1].Width;
+            Node& node = m_Nodes[i];
+            if (node.X >= previousEnd) break;
+
+            uint32_t overlap = previousEnd - node.X;
+            if (node.Width > overlap)
+            {
+                node.X += overlap;
+                node.Width -= overlap;
+                break;
+            }
+            m_Nodes.erase(m_Nodes.begin() + i);
+        }
+
+        /* Merge neighbouring segments of equal height */
+        for (size_t i = 0; i + 1 < m_Nodes.size();)
+        {
+            if (m_Nodes[i].Y == m_Nodes[i + 1].Y)
+            {
+                m_Nodes[i].Width += m_Nodes[i + 1].Width;
+                m_Nodes.erase(m_Nodes.begin() + i + 1);
+            }
+            else i++;
+        }
+        return true;
+    }
+
+
+    // TextureAtlas ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    TextureAtlas::TextureAtlas(const uint32_t pageSize, const uint32_t padding)
+        : m_PageSize(pageSize), m_Padding(padding)
+    {
+    }
+
+
+    Ref<SubTexture2D> TextureAtlas::Add(const std::filesystem::path& path)
+    {
+        LV_PROFILE_FUNCTION();
+
+        int width, height, channels;
+        stbi_set_flip_vertically_on_load(1);
+        stbi_uc* data;
+        {
+            LV_PROFILE_SCOPE("stbi_load - TextureAtlas::Add(const std::filesystem::path&)");
+            data = stbi_load(path.string().c_str(), &width, &height, &channels, 4);
+        }
+        LV_CORE_ASSERT(data, "Failed to load image!");
+
+        Ref<SubTexture2D> subTexture = Add(data, width, height);
+
+        stbi_image_free(data);
+        return subTexture;
+    }
+
+
+    Ref<SubTexture2D> TextureAtlas::Add(const void* data, const uint32_t width, const uint32_t height, Ref<SubTexture2D> handle)
+    {
+        LV_PROFILE_FUNCTION();
+
+        LV_CORE_ASSERT(width > 0 && height > 0, "Cannot add an empty image to a texture atlas!");
+
+        uint32_t paddedWidth = width + 2 * m_Padding, paddedHeight = height + 2 * m_Padding;
+        if (paddedWidth > m_PageSize || paddedHeight > m_PageSize)
+        {
+            LV_CORE_WARN("Image ({0}x{1}) does not fit in a {2}x{2} atlas page: it will use its own texture!", width, height, m_PageSize);
+
+            Ref<Texture2D> texture = Texture2D::Create(width, height);
+            texture->SetData(const_cast<void*>(data), 4 * width * height);
+            if (!handle) return CreateRef<SubTexture2D>(texture, Vector2{ 0.f }, Vector2{ 1.f });
+
+            handle->SetRegion(texture, Vector2{ 0.f }, Vector2{ 1.f });
+            return handle;
+        }
+
+        Image image;
+        image.Handle = handle ? handle : CreateRef<SubTexture2D>(nullptr, Vector2{ 0.f }, Vector2{ 0.f });
+        image.Pixels = CreateRef<std::vector<uint8_t>>((size_t)4 * paddedWidth * paddedHeight);
+        image.Width = paddedWidth;
+        image.Height = paddedHeight;
+
+        /* Extrude the border pixels into the padding */
+        auto source = (const uint8_t*)data;
+        for (uint32_t row = 0; row < paddedHeight; row++)
+        {
+            uint32_t sourceRow = (uint32_t)std::clamp<int64_t>((int64_t)row - m_Padding, 0, height - 1);
+            const uint8_t* sourcePixels = source + (size_t)4 * width * sourceRow;
+            uint8_t* pixels = image.Pixels->data() + (size_t)4 * paddedWidth * row;
+
+            for (uint32_t p = 0; p < m_Padding; p++)
+            {
+                std::memcpy(pixels + 4 * p, sourcePixels, 4);
+                std::memcpy(pixels + 4 * (m_Padding + width + p), sourcePixels + 4 * (width - 1), 4);
+            }
+            std::memcpy(pixels + 4 * m_Padding, sourcePixels, (size_t)4 * width);
+        }
+
+        Insert(image);
+
+        Ref<SubTexture2D> subTexture = image.Handle;
+        m_Images.emplace(subTexture.get(), std::move(image));
+        return subTexture;
+    }
+
+
+    void TextureAtlas::Remove(const Ref<SubTexture2D>& subTexture)
+    {
+        LV_PROFILE_FUNCTION();
+
+        auto it = m_Images.find(subTexture.get());
+        if (it == m_Images.end()) return; /* not in the atlas, e.g. an image which was too large for a page */
+
+        Image& image = it->second;
+        m_Pages[image.PageIndex].UsedArea -= (uint64_t)image.Width * image.Height;
+        m_Images.erase(it);
+    }
+
+
+    void TextureAtlas::Repack()
+    {
+        LV_PROFILE_FUNCTION();
+
+        if (m_Repack.valid()) return; /* already repacking */
+
+        std::vector<RepackInput> inputs;
+        inputs.reserve(m_Images.size());
+        for (auto const& [key, image] : m_Images) {
+            inputs.push_back({ key, image.Pixels, image.Width, image.Height });
+        }
+        m_Repack = std::async(std::launch::async, &TextureAtlas::PackImages, std::move(inputs), m_PageSize);
+    }
+
+
+    void TextureAtlas::Update()
+    {
+        if (!m_Repack.valid() || m_Repack.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+
+        LV_PROFILE_FUNCTION();
+
+        RepackResult result = m_Repack.get();
+
+        std::vector<Page> pages;
+        pages.reserve(result.Packers.size());
+        for (size_t p = 0; p < result.Packers.size(); p++)
+        {
+            Ref<Texture2D> texture = CreatePage();
+            texture->SetData(result.PagePixels[p].data(), (uint32_t)result.PagePixels[p].size());
+            pages.push_back({ texture, std::move(result.Packers[p]) });
+        }
+        m_Pages = std::move(pages);
+
+        std::unordered_set<const SubTexture2D*> placed;
+        for (size_t i = 0; i < result.Inputs.size(); i++)
+        {
+            auto it = m_Images.find(result.Inputs[i].Key);
+            if (it == m_Images.end() || it->second.Pixels != result.Inputs[i].Pixels) continue; /* removed during the repack */
+
+            Image& image = it->second;
+            image.PageIndex = result.PageIndex[i];
+            image.X = result.X[i];
+            image.Y = result.Y[i];
+            m_Pages[image.PageIndex].UsedArea += (uint64_t)image.Width * image.Height;
+            UpdateHandle(image);
+            placed.insert(it->first);
+        }
+
+        /* Images added during the repack are inserted into the new pages */
+        for (auto& [key, image] : m_Images) {
+            if (!placed.contains(key)) Insert(image);
+        }
+
+        LV_CORE_INFO("Texture atlas repacked {0} images into {1} pages ({2:.1f}% occupied)", m_Images.size(), m_Pages.size(), 100.f * GetOccupancy());
+    }
+
+
+    float TextureAtlas::GetOccupancy() const
+    {
+        if (m_Pages.empty()) return 0.f;
+
+        uint64_t usedArea = 0;
+        for (auto const& page : m_Pages) {
+            usedArea += page.UsedArea;
+        }
+        return (float)((double)usedArea / ((double)m_Pages.size() * m_PageSize * m_PageSize));
+    }
+
+
+    TextureAtlas::RepackResult TextureAtlas::PackImages(std::vector<RepackInput> inputs, const uint32_t pageSize)
+    {
+        /* Runs on a worker thread: touches only the inputs, whose pixels are shared and never modified */
+
+        /* Tallest first keeps the skyline flat, which wastes the least space */
+        std::sort(inputs.begin(), inputs.end(), [](const RepackInput& lhs, const RepackInput& rhs) {
+            return lhs.Height != rhs.Height ? lhs.Height > rhs.Height : lhs.Width > rhs.Width;
+        });
+
+        RepackResult result;
+        result.PageIndex.resize(inputs.size());
+        result.X.resize(inputs.size());
+        result.Y.resize(inputs.size());
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            auto const& input = inputs[i];
+
+            uint32_t p = 0;
+            for (; p < result.Packers.size(); p++) {
+                if (result.Packers[p].Insert(input.Width, input.Height, result.X[i], result.Y[i])) break;
+            }
+            if (p == result.Packers.size())
+            {
+                result.Packers.emplace_back(pageSize);
+                result.PagePixels.emplace_back((size_t)4 * pageSize * pageSize, (uint8_t)0);
+
+                bool inserted = result.Packers[p].Insert(input.Width, input.Height, result.X[i], result.Y[i]);
+                LV_CORE_ASSERT(inserted, "Image does not fit in an empty atlas page!");
+            }
+            result.PageIndex[i] = p;
+
+            BlitImage(result.PagePixels[p], pageSize, *input.Pixels, result.X[i], result.Y[i], input.Width, input.Height);
+        }
+        result.Inputs = std::move(inputs);
+        return result;
+    }
+
+
+    void TextureAtlas::BlitImage(std::vector<uint8_t>& pagePixels, const uint32_t pageSize, const std::vector<uint8_t>& pixels,
+        const uint32_t x, const uint32_t y, const uint32_t width, const uint32_t height)
+    {
+        for (uint32_t row = 0; row < height; row++)
+        {
+            std::memcpy(pagePixels.data() + (size_t)4 * ((size_t)pageSize * (y + row) + x), pixels.data() + (size_t)4 * width * row, (size_t)4 * width);
+        }
+    }
+
+
+    Ref<Texture2D> TextureAtlas::CreatePage() const
+    {
+        Ref<Texture2D> texture = Texture2D::Create(m_PageSize, m_PageSize);
+        texture->SetWrapMode(Texture::WrapMode::Clamp);
+        return texture;
+    }
+
+
+    void TextureAtlas::Insert(Image& image)
+    {
+        LV_PROFILE_FUNCTION();
+
+        uint32_t p = 0;
+        for (; p < m_Pages.size(); p++) {
+            if (m_Pages[p].Packer.Insert(image.Width, image.Height, image.X, image.Y)) break;
+        }
+        if (p == m_Pages.size())
+        {
+            m_Pages.push_back({ CreatePage(), SkylinePacker(m_PageSize) });
+
+            bool inserted = m_Pages[p].Packer.Insert(image.Width, image.Height, image.X, image.Y);
+            LV_CORE_ASSERT(inserted, "Image does not fit in an empty atlas page!");
+        }
+        image.PageIndex = p;
+
+        Page& page = m_Pages[p];
+        page.UsedArea += (uint64_t)image.Width * image.Height;
+        page.Texture->SetSubData(image.Pixels->data(), image.X, image.Y, image.Width, image.Height);
+
+        UpdateHandle(image);
+    }
+
+
+    void TextureAtlas::UpdateHandle(const Image& image)
+    {
+        float texelSize = 1.f / m_PageSize;
+        Vector2 min{ (float)(image.X + m_Padding) * texelSize, (float)(image.Y + m_Padding) * texelSize };
+        Vector2 max{ (float)(image.X + image.Width - m_Padding) * texelSize, (float)(image.Y + image.Height - m_Padding) * texelSize };
+        image.Handle->SetRegion(m_Pages[image.PageIndex].Texture, min, max);
+    }
+
+}
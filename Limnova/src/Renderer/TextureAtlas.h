@@ -0,0 +1,116 @@
+#pragma once
+
+#include "SubTexture.h"
+
+#include <future>
+
+
+namespace Limnova
+{
+
+    /// <summary>
+    /// Packs small RGBA8 images into shared atlas pages, so draws which would each have used a separate texture (and a separate
+    /// Renderer2D texture slot) instead share a handful of pages.
+    /// Images are placed incrementally with a skyline bottom-left packer as they are added. Each image is padded by extruding its
+    /// border pixels, so linear filtering never samples a neighbouring image.
+    /// The returned SubTexture2D handles remain valid while the atlas exists - repacking moves their regions in place.
+    /// All members must be called from the rendering thread; only the repack itself runs on a worker thread.
+    /// </summary>
+    class TextureAtlas
+    {
+    public:
+        TextureAtlas(const uint32_t pageSize = 2048, const uint32_t padding = 1);
+
+        /// <summary> Decodes an image file and adds it to the atlas </summary>
+        Ref<SubTexture2D> Add(const std::filesystem::path& path);
+        /// <summary>
+        /// Adds a width*height RGBA8 image, stored bottom row first (as uploaded to Texture2D).
+        /// Images too large to fit in a page are given a texture of their own.
+        /// </summary>
+        /// <param name="handle">Existing sub-texture to place the image in (e.g. one handed out before the image was loaded), or null to create one</param>
+        Ref<SubTexture2D> Add(const void* data, const uint32_t width, const uint32_t height, Ref<SubTexture2D> handle = nullptr);
+        /// <summary> Releases an image from the atlas - its space is reclaimed by the next Repack() </summary>
+        void Remove(const Ref<SubTexture2D>& subTexture);
+
+        /// <summary>
+        /// Starts packing every image into fresh pages on a worker thread, largest first. The atlas remains usable meanwhile:
+        /// the new pages are swapped in by the first Update() after the repack completes.
+        /// </summary>
+        void Repack();
+        /// <summary> Applies a completed repack, if any - call once per frame </summary>
+        void Update();
+        bool IsRepacking() const { return m_Repack.valid(); }
+
+        uint32_t GetPageSize() const { return m_PageSize; }
+        size_t GetNumPages() const { return m_Pages.size(); }
+        const Ref<Texture2D>& GetPage(const size_t index) const { return m_Pages[index].Texture; }
+        size_t GetNumImages() const { return m_Images.size(); }
+        /// <returns>Fraction of the pages' area covered by images (including their padding) - released images leave gaps until Repack()</returns>
+        float GetOccupancy() const;
+    private:
+        class SkylinePacker
+        {
+        public:
+            SkylinePacker(const uint32_t size);
+
+            /// <summary> Finds the lowest position for a width*height rectangle and reserves it </summary>
+            /// <returns>False if the rectangle does not fit</returns>
+            bool Insert(const uint32_t width, const uint32_t height, uint32_t& x, uint32_t& y);
+        private:
+            /// <returns>Height at which the rectangle rests when its left edge is at the node's start, or -1 if it does not fit</returns>
+            int64_t Fit(const size_t nodeIndex, const uint32_t width, const uint32_t height) const;
+        private:
+            struct Node
+            {
+                uint32_t X, Y, Width;
+            };
+            uint32_t m_Size;
+            std::vector<Node> m_Nodes; /* skyline segments, left to right, covering the full page width */
+        };
+
+        struct Image
+        {
+            Ref<SubTexture2D> Handle;
+            Ref<std::vector<uint8_t>> Pixels; /* padded RGBA8 - shared with an in-flight repack */
+            uint32_t Width, Height; /* padded size */
+            uint32_t PageIndex, X, Y;
+        };
+
+        struct Page
+        {
+            Ref<Texture2D> Texture;
+            SkylinePacker Packer;
+            uint64_t UsedArea = 0; /* area of the images currently placed in this page */
+        };
+
+        struct RepackInput
+        {
+            const SubTexture2D* Key;
+            Ref<std::vector<uint8_t>> Pixels;
+            uint32_t Width, Height;
+        };
+        struct RepackResult
+        {
+            std::vector<RepackInput> Inputs;
+            std::vector<uint32_t> PageIndex, X, Y; /* placement of each input */
+            std::vector<SkylinePacker> Packers;
+            std::vector<std::vector<uint8_t>> PagePixels;
+        };
+
+        static RepackResult PackImages(std::vector<RepackInput> inputs, const uint32_t pageSize);
+        static void BlitImage(std::vector<uint8_t>& pagePixels, const uint32_t pageSize, const std::vector<uint8_t>& pixels,
+            const uint32_t x, const uint32_t y, const uint32_t width, const uint32_t height);
+
+        Ref<Texture2D> CreatePage() const;
+        void Insert(Image& image);
+        void UpdateHandle(const Image& image);
+    private:
+        uint32_t m_PageSize;
+        uint32_t m_Padding;
+        std::vector<Page> m_Pages;
+        std::unordered_map<const SubTexture2D*, Image> m_Images;
+
+        std::future<RepackResult> m_Repack;
+    };
+
+}
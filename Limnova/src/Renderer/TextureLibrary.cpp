@@ -0,0 +1,335 @@
+#include "TextureLibrary.h"
+
+#include "TextureAtlas.h"
+
+#include <stb_image.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+
+namespace Limnova
+{
+
+    struct DecodeJob
+    {
+        std::string Key;
+        bool Sprite = false;
+    };
+
+
+    struct DecodedImage
+    {
+        std::string Key;
+        bool Sprite = false; /* decoded as RGBA8 for the atlas */
+        std::unique_ptr<stbi_uc, decltype(&stbi_image_free)> Pixels{ nullptr, &stbi_image_free }; /* null if decoding failed */
+        int Width = 0, Height = 0, Channels = 0;
+        std::string FailureReason; /* stbi_failure_reason() is per-thread, so it is read on the decoding worker */
+    };
+
+
+    struct TextureLibraryData
+    {
+        static constexpr size_t kDefaultUploadBudget = 16 * 1024 * 1024;
+
+        std::unordered_map<std::string, Ref<Texture2D>> Textures; /* keyed by canonical path */
+        struct Sprite
+        {
+            Ref<SubTexture2D> Handle;
+            bool InAtlas = false; /* the atlas holds a second reference to the handle */
+        };
+        std::unordered_map<std::string, Sprite> Sprites; /* keyed by canonical path */
+        Scope<TextureAtlas> Atlas;
+        Ref<Texture2D> SpritePlaceholder;
+        size_t NumPending = 0;
+        size_t UploadBudget = kDefaultUploadBudget;
+
+        /* Shared with the workers - guarded by Mutex */
+        std::mutex Mutex;
+        std::condition_variable JobAvailable;
+        std::condition_variable ImageDecoded;
+        std::deque<DecodeJob> Jobs;
+        std::deque<DecodedImage> Decoded;
+        bool Running = false;
+
+        std::vector<std::thread> Workers;
+    };
+
+    static TextureLibraryData s_Data;
+
+
+    void TextureLibrary::Init()
+    {
+        LV_PROFILE_FUNCTION();
+
+        s_Data.Running = true;
+        s_Data.Atlas = CreateScope<TextureAtlas>();
+
+        /* Leave a core for the rendering thread */
+        uint32_t numWorkers = std::clamp(std::thread::hardware_concurrency(), 2u, 5u) - 1;
+        for (uint32_t i = 0; i < numWorkers; i++) {
+            s_Data.Workers.emplace_back(&TextureLibrary::WorkerLoop);
+        }
+    }
+
+
+    void TextureLibrary::Shutdown()
+    {
+        LV_PROFILE_FUNCTION();
+
+        {
+            std::lock_guard lock(s_Data.Mutex);
+            s_Data.Running = false;
+            s_Data.Jobs.clear();
+        }
+        s_Data.JobAvailable.notify_all();
+        for (auto& worker : s_Data.Workers) {
+            worker.join();
+        }
+        s_Data.Workers.clear();
+
+        s_Data.Decoded.clear();
+        s_Data.Textures.clear();
+        s_Data.Sprites.clear();
+        s_Data.Atlas.reset();
+        s_Data.SpritePlaceholder.reset();
+        s_Data.NumPending = 0;
+    }
+
+
+    void TextureLibrary::WorkerLoop()
+    {
+        stbi_set_flip_vertically_on_load_thread(1);
+
+        while (true)
+        {
+            DecodedImage image;
+            {
+                std::unique_lock lock(s_Data.Mutex);
+                s_Data.JobAvailable.wait(lock, [] { return !s_Data.Running || !s_Data.Jobs.empty(); });
+                if (!s_Data.Running) return;
+
+                image.Key = std::move(s_Data.Jobs.front().Key);
+                image.Sprite = s_Data.Jobs.front().Sprite;
+                s_Data.Jobs.pop_front();
+            }
+
+            image.Pixels.reset(stbi_load(image.Key.c_str(), &image.Width, &image.Height, &image.Channels, image.Sprite ? 4 : 0));
+            if (image.Sprite) image.Channels = 4;
+            if (!image.Pixels) {
+                const char* reason = stbi_failure_reason();
+                image.FailureReason = reason ? reason : "unknown error";
+            }
+
+            {
+                std::lock_guard lock(s_Data.Mutex);
+                s_Data.Decoded.push_back(std::move(image));
+            }
+            s_Data.ImageDecoded.notify_all();
+        }
+    }
+
+
+    void TextureLibrary::Update()
+    {
+        s_Data.Atlas->Update(); /* applies a completed repack */
+
+        if (s_Data.NumPending == 0) return;
+
+        LV_PROFILE_FUNCTION();
+
+        UploadDecoded(s_Data.UploadBudget);
+    }
+
+
+    void TextureLibrary::UploadDecoded(const size_t budget)
+    {
+        size_t uploaded = 0;
+        while (true)
+        {
+            DecodedImage image;
+            {
+                std::lock_guard lock(s_Data.Mutex);
+                if (s_Data.Decoded.empty()) break;
+
+                DecodedImage& next = s_Data.Decoded.front();
+                size_t size = (size_t)next.Width * next.Height * next.Channels;
+                if (uploaded > 0 && uploaded + size > budget) break;
+
+                image = std::move(next);
+                s_Data.Decoded.pop_front();
+            }
+            s_Data.NumPending--;
+
+            if (!image.Pixels)
+            {
+                LV_CORE_ERROR("Failed to load image '{0}': {1}", image.Key, image.FailureReason);
+                continue;
+            }
+
+            if (image.Sprite)
+            {
+                auto it = s_Data.Sprites.find(image.Key);
+                if (it == s_Data.Sprites.end()) continue; /* collected while loading */
+
+                auto& sprite = it->second;
+                if ((uint32_t)image.Width <= kMaxAtlasImageSize && (uint32_t)image.Height <= kMaxAtlasImageSize)
+                {
+                    s_Data.Atlas->Add(image.Pixels.get(), image.Width, image.Height, sprite.Handle);
+                    sprite.InAtlas = true;
+                }
+                else
+                {
+                    Ref<Texture2D> texture = Texture2D::Create(image.Width, image.Height);
+                    texture->SetWrapMode(Texture::WrapMode::Clamp);
+                    texture->SetImage(image.Pixels.get(), image.Width, image.Height, image.Channels);
+                    sprite.Handle->SetRegion(texture, Vector2{ 0.f }, Vector2{ 1.f });
+                }
+                uploaded += (size_t)image.Width * image.Height * image.Channels;
+                continue;
+            }
+
+            auto it = s_Data.Textures.find(image.Key);
+            if (it == s_Data.Textures.end()) continue; /* collected while loading */
+
+            if (image.Channels != 3 && image.Channels != 4)
+            {
+                LV_CORE_ERROR("Failed to load image '{0}': number of channels ({1}) not supported!", image.Key, image.Channels);
+                continue;
+            }
+
+            it->second->SetImage(image.Pixels.get(), image.Width, image.Height, image.Channels);
+            uploaded += (size_t)image.Width * image.Height * image.Channels;
+        }
+    }
+
+
+    Ref<Texture2D> TextureLibrary::Load(const std::filesystem::path& path, const Texture::WrapMode wrap)
+    {
+        LV_PROFILE_FUNCTION();
+
+        std::string key = CanonicalKey(path);
+        auto it = s_Data.Textures.find(key);
+        if (it != s_Data.Textures.end()) {
+            return it->second;
+        }
+
+        Ref<Texture2D> texture = Texture2D::Create(1, 1);
+        uint32_t placeholderData = 0xffffffff;
+        texture->SetData(&placeholderData, sizeof(uint32_t));
+        texture->SetWrapMode(wrap);
+        s_Data.Textures.emplace(key, texture);
+
+        RequestDecode(std::move(key), false);
+        return texture;
+    }
+
+
+    Ref<SubTexture2D> TextureLibrary::LoadSprite(const std::filesystem::path& path)
+    {
+        LV_PROFILE_FUNCTION();
+
+        std::string key = CanonicalKey(path);
+        auto it = s_Data.Sprites.find(key);
+        if (it != s_Data.Sprites.end()) {
+            return it->second.Handle;
+        }
+
+        if (!s_Data.SpritePlaceholder)
+        {
+            s_Data.SpritePlaceholder = Texture2D::Create(1, 1);
+            uint32_t placeholderData = 0xffffffff;
+            s_Data.SpritePlaceholder->SetData(&placeholderData, sizeof(uint32_t));
+        }
+        Ref<SubTexture2D> sprite = CreateRef<SubTexture2D>(s_Data.SpritePlaceholder, Vector2{ 0.f }, Vector2{ 1.f });
+        s_Data.Sprites.emplace(key, TextureLibraryData::Sprite{ sprite });
+
+        RequestDecode(std::move(key), true);
+        return sprite;
+    }
+
+
+    std::string TextureLibrary::CanonicalKey(const std::filesystem::path& path)
+    {
+        std::error_code error;
+        std::filesystem::path canonicalPath = std::filesystem::weakly_canonical(path, error);
+        return error ? path.string() : canonicalPath.string();
+    }
+
+
+    void TextureLibrary::RequestDecode(std::string key, const bool sprite)
+    {
+        {
+            std::lock_guard lock(s_Data.Mutex);
+            s_Data.Jobs.push_back({ std::move(key), sprite });
+        }
+        s_Data.JobAvailable.notify_one();
+        s_Data.NumPending++;
+    }
+
+
+    void TextureLibrary::WaitAll()
+    {
+        LV_PROFILE_FUNCTION();
+
+        while (s_Data.NumPending > 0)
+        {
+            {
+                std::unique_lock lock(s_Data.Mutex);
+                s_Data.ImageDecoded.wait(lock, [] { return !s_Data.Decoded.empty(); });
+            }
+            UploadDecoded(std::numeric_limits<size_t>::max());
+        }
+    }
+
+
+    void TextureLibrary::CollectUnused()
+    {
+        LV_PROFILE_FUNCTION();
+
+        std::erase_if(s_Data.Textures, [](auto const& entry) { return entry.second.use_count() == 1; });
+
+        size_t numReleased = std::erase_if(s_Data.Sprites, [](auto const& entry) {
+            auto const& sprite = entry.second;
+            if (sprite.Handle.use_count() > (sprite.InAtlas ? 2 : 1)) return false;
+            if (sprite.InAtlas) s_Data.Atlas->Remove(sprite.Handle);
+            return true;
+        });
+        if (numReleased > 0) {
+            s_Data.Atlas->Repack(); /* reclaim the released sprites' space */
+        }
+    }
+
+
+    void TextureLibrary::SetUploadBudget(const size_t bytesPerFrame)
+    {
+        s_Data.UploadBudget = bytesPerFrame;
+    }
+
+
+    size_t TextureLibrary::GetUploadBudget()
+    {
+        return s_Data.UploadBudget;
+    }
+
+
+    size_t TextureLibrary::GetNumTextures()
+    {
+        return s_Data.Textures.size();
+    }
+
+
+    size_t TextureLibrary::GetNumSprites()
+    {
+        return s_Data.Sprites.size();
+    }
+
+
+    size_t TextureLibrary::GetNumPending()
+    {
+        return s_Data.NumPending;
+    }
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Texture.h"
+#include "SubTexture.h"
+
+
+namespace Limnova
+{
+
+    /// <summary>
+    /// Loads image files into textures without blocking the rendering thread.
+    /// Textures are cached by canonical path, so each file is loaded once however many times it is requested. Images are decoded
+    /// on a pool of worker threads and uploaded by Update() on the rendering thread, a limited number of bytes per frame.
+    /// Until its upload lands, a texture holds a 1x1 white placeholder image (the same as Renderer2D's white texture) - the upload
+    /// replaces the image in place, so Refs handed out earlier need not be refreshed.
+    /// </summary>
+    class TextureLibrary
+    {
+    public:
+        static constexpr uint32_t kMaxAtlasImageSize = 256; /* Sprites up to this size (in pixels, on each side) share the library's atlas */
+
+        static void Init();
+        static void Shutdown();
+
+        /// <summary> Uploads decoded images, within the upload budget - called by the application at the start of each frame </summary>
+        static void Update();
+
+        /// <summary>
+        /// Returns the texture for an image file, starting to load it if it is not already cached.
+        /// The wrap mode is applied only when the file is first requested.
+        /// </summary>
+        static Ref<Texture2D> Load(const std::filesystem::path& path, const Texture::WrapMode wrap = Texture::WrapMode::Tile);
+        /// <summary>
+        /// Returns a sprite for an image file, starting to load it if it is not already cached. Small images are packed into the
+        /// library's TextureAtlas, so their sprites share a few textures (and Renderer2D texture slots); larger images are given a
+        /// clamped texture of their own. Until its upload lands, the sprite covers the placeholder image.
+        /// </summary>
+        static Ref<SubTexture2D> LoadSprite(const std::filesystem::path& path);
+        /// <summary> Blocks until every requested image has been decoded and uploaded </summary>
+        static void WaitAll();
+        /// <summary> Releases cached textures and sprites which are not referenced outside the library, and repacks the atlas if sprites were released </summary>
+        static void CollectUnused();
+
+        /// <summary> Sets the number of image bytes uploaded per frame. At least one image is uploaded per frame regardless </summary>
+        static void SetUploadBudget(const size_t bytesPerFrame);
+        static size_t GetUploadBudget();
+
+        static size_t GetNumTextures();
+        static size_t GetNumSprites();
+        /// <returns>Number of requested images which have not yet been uploaded</returns>
+        static size_t GetNumPending();
+    private:
+        static std::string CanonicalKey(const std::filesystem::path& path);
+        static void RequestDecode(std::string key, const bool sprite);
+        static void WorkerLoop();
+        static void UploadDecoded(const size_t budget);
+    };
+
+}
@@ -39,11 +39,16 @@ namespace Limnova
     struct TransformComponent
     {
         //LV_REFLECT(TransformComponent)
+        friend class Scene;
         friend class SceneHierarchyPanel;
     private:
         Matrix4 Transform = Matrix4::Identity();
         bool NeedCompute = true;
 
+        Matrix4 WorldTransform = Matrix4::Identity(); /* Computed by Scene::UpdateWorldTransforms() */
+        bool WorldNeedCompute = true;
+        bool InheritParent = true; /* If false, the world transform is the local transform regardless of the parent's transform */
+
         Vector3 Position = { 0.f };
         Quaternion Orientation = Quaternion::Unit();
         Vector3 EulerAngles = { 0.f };
@@ -59,15 +64,15 @@ namespace Limnova
             Orientation = orientation;
             Position = position;
             Scale = scale;
-            NeedCompute = true;
+            MarkDirty();
         }
-        void SetScale(const Vector3& scale) { Scale = scale; NeedCompute = true; }
-        void SetPosition(const Vector3& position) { Position = position; NeedCompute = true; }
+        void SetScale(const Vector3& scale) { Scale = scale; MarkDirty(); }
+        void SetPosition(const Vector3& position) { Position = position; MarkDirty(); }
         void SetOrientation(const Quaternion& orientation)
         {
             Orientation = orientation;
             EulerAngles = Orientation.ToEulerAngles();
-            NeedCompute = true;
+            MarkDirty();
         }
         void SetEulerAngles(const Vector3& eulerAngles)
         {
@@ -75,7 +80,13 @@ namespace Limnova
             Orientation = Quaternion(Vector3{ 1.f,0.f,0.f }, EulerAngles.x)
                 * Quaternion(Vector3{ 0.f,1.f,0.f }, EulerAngles.y)
                 * Quaternion(Vector3{ 0.f,0.f,1.f }, EulerAngles.z);
-            NeedCompute = true;
+            MarkDirty();
+        }
+        void SetInheritParent(bool inheritParent)
+        {
+            if (InheritParent == inheritParent) return;
+            InheritParent = inheritParent;
+            WorldNeedCompute = true;
         }
 
         const Vector3& GetScale() { return Scale; }
@@ -83,9 +94,17 @@ namespace Limnova
         const Quaternion& GetOrientation() { return Orientation; }
         const Vector3& GetEulerAngles() { return EulerAngles; }
 
+        bool GetInheritParent() const { return InheritParent; }
+
         const Matrix4& GetTransform() { if (NeedCompute) Compute(); return Transform; }
         operator const Matrix4& () { if (NeedCompute) Compute(); return Transform; }
+
+        /// <summary> Transform relative to the scene, including all parent transforms - only valid after Scene::UpdateWorldTransforms() </summary>
+        const Matrix4& GetWorldTransform() const { return WorldTransform; }
+        Vector3 GetWorldPosition() const { return (WorldTransform * Vector4{ 0.f, 0.f, 0.f, 1.f }).XYZ(); }
     private:
+        void MarkDirty() { NeedCompute = true; WorldNeedCompute = true; }
+
         void Compute()
         {
             Transform = glm::translate(glm::mat4(1.f), (glm::vec3)Position);
@@ -96,6 +115,11 @@ namespace Limnova
     };
 
 
+    /// <summary>
+    /// Runtime hierarchy links, stored as entity handles so that hierarchy walks do not look up UUIDs.
+    /// Handles are only valid within the owning registry - UUIDs are used for serialization and cross-scene identity,
+    /// and links are translated once when a scene is loaded or copied.
+    /// </summary>
     struct HierarchyComponent
     {
         //LV_REFLECT(HierarchyComponent)
@@ -104,10 +128,10 @@ namespace Limnova
         friend class SceneSerializer;
         friend class SceneHierarchyPanel;
     private:
-        UUID Parent         = UUID::Null;
-        UUID NextSibling    = UUID::Null;
-        UUID PrevSibling    = UUID::Null;
-        UUID FirstChild     = UUID::Null;
+        entt::entity Parent         = entt::null;
+        entt::entity NextSibling    = entt::null;
+        entt::entity PrevSibling    = entt::null;
+        entt::entity FirstChild     = entt::null;
     public:
         HierarchyComponent() = default;
         HierarchyComponent(const HierarchyComponent&) = default;
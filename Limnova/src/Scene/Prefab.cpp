@@ -0,0 +1,66 @@
+#include "Prefab.h"
+
+#include "Entity.h"
+
+
+namespace Limnova
+{
+
+    template<typename TRenderer>
+    void Prefab::CaptureRenderer(Entity entity)
+    {
+        auto& renderer = std::get<std::optional<TRenderer>>(m_Renderers);
+        if (entity.HasComponent<TRenderer>()) {
+            renderer = entity.GetComponent<TRenderer>();
+        }
+        else if (entity.HasComponent<PrefabComponent>()) {
+            /* An instance of another prefab contributes that prefab's renderers where it has none of its own */
+            auto* sourceRenderer = entity.GetComponent<PrefabComponent>().Source->TryGetRenderer<TRenderer>();
+            if (sourceRenderer != nullptr) renderer = *sourceRenderer;
+        }
+    }
+
+
+    Ref<Prefab> Prefab::Create(Entity entity)
+    {
+        LV_CORE_ASSERT(entity, "Invalid entity!");
+
+        Ref<Prefab> prefab = CreateRef<Prefab>();
+        prefab->m_Name = entity.GetName();
+        prefab->m_Transform = entity.GetComponent<TransformComponent>();
+
+        prefab->CaptureRenderer<SpriteRendererComponent>(entity);
+        prefab->CaptureRenderer<BillboardSpriteRendererComponent>(entity);
+        prefab->CaptureRenderer<CircleRendererComponent>(entity);
+        prefab->CaptureRenderer<BillboardCircleRendererComponent>(entity);
+        prefab->CaptureRenderer<EllipseRendererComponent>(entity);
+
+        if (entity.HasComponent<ScriptComponent>()) {
+            prefab->m_ScriptClass = entity.GetComponent<ScriptComponent>().GetScriptName();
+        }
+
+        if (entity.HasComponent<OrbitalComponent>())
+        {
+            auto& oc = entity.GetComponent<OrbitalComponent>();
+            auto& orbital = prefab->m_Orbital.emplace();
+            orbital.Mass = oc.Object.GetState().Mass;
+            orbital.Dynamic = oc.Object.IsDynamic();
+            for (auto lsp : oc.LocalSpaces) {
+                if (lsp.IsSphereOfInfluence()) continue; /* influencing LSPs are handled by OrbitalPhysics */
+                orbital.LocalSpaceRadii.push_back(lsp.GetLSpace().Radius);
+            }
+            orbital.UIColor = oc.UIColor;
+            orbital.Albedo = oc.Albedo;
+            orbital.ShowMajorMinorAxes = oc.ShowMajorMinorAxes;
+            orbital.ShowNormal = oc.ShowNormal;
+        }
+        return prefab;
+    }
+
+
+    bool Prefab::HasRenderer() const
+    {
+        return std::apply([](auto const&... renderers) { return (renderers.has_value() || ...); }, m_Renderers);
+    }
+
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Components.h"
+
+#include <optional>
+#include <tuple>
+
+
+namespace Limnova
+{
+
+    class Entity;
+
+    /// <summary>
+    /// Immutable archetype of an entity, shared by every instance created from it with Scene::InstantiatePrefab().
+    /// Instances reference the prefab through a PrefabComponent instead of holding their own renderer components, and only store
+    /// per-instance state - an instance's own renderer component, if it is given one, overrides the prefab's of the same type.
+    /// Reference-counted: a prefab lives as long as any instance or other holder references it.
+    /// </summary>
+    class Prefab
+    {
+    public:
+        /// <summary> Orbital data shared by instances - each instance still has its own physics object and local spaces </summary>
+        struct OrbitalArchetype
+        {
+            double Mass = 0.0;
+            bool Dynamic = false;
+            std::vector<float> LocalSpaceRadii; /* Non-influencing local spaces only - spheres of influence are computed by OrbitalPhysics */
+            Vector3 UIColor = { 1.f };
+            float Albedo = 0.f;
+            bool ShowMajorMinorAxes = false, ShowNormal = false;
+        };
+
+        Prefab() = default;
+
+        /// <summary> Captures the shareable state of an entity - later changes to the entity do not affect the prefab </summary>
+        static Ref<Prefab> Create(Entity entity);
+
+        const std::string& GetName() const { return m_Name; }
+        const TransformComponent& GetTransform() const { return m_Transform; }
+        const std::string& GetScriptClass() const { return m_ScriptClass; }
+        const std::optional<OrbitalArchetype>& GetOrbital() const { return m_Orbital; }
+
+        template<typename TRenderer>
+        const TRenderer* TryGetRenderer() const
+        {
+            auto& renderer = std::get<std::optional<TRenderer>>(m_Renderers);
+            return renderer.has_value() ? &renderer.value() : nullptr;
+        }
+        bool HasRenderer() const;
+    private:
+        template<typename TRenderer>
+        void CaptureRenderer(Entity entity);
+    private:
+        std::string m_Name;
+        TransformComponent m_Transform;
+        std::tuple<
+            std::optional<SpriteRendererComponent>,
+            std::optional<BillboardSpriteRendererComponent>,
+            std::optional<CircleRendererComponent>,
+            std::optional<BillboardCircleRendererComponent>,
+            std::optional<EllipseRendererComponent>
+        > m_Renderers;
+        std::string m_ScriptClass;
+        std::optional<OrbitalArchetype> m_Orbital;
+    };
+
+
+    /// <summary> Marks an entity as an instance of a prefab and keeps the prefab alive </summary>
+    struct PrefabComponent
+    {
+        Ref<Prefab> Source;
+
+        PrefabComponent() = default;
+        PrefabComponent(const PrefabComponent&) = default;
+        PrefabComponent(const Ref<Prefab>& source)
+            : Source(source) {}
+    };
+
+}
@@ -5,6 +5,11 @@
 
 #include <Renderer/Renderer2D.h>
 #include <Scripting/ScriptEngine.h>
+#include <Core/Timer.h>
+
+#include <execution>
+#include <cstring>
+#include <numeric>
 
 
 namespace Limnova
@@ -14,6 +19,8 @@ namespace Limnova
 case ScriptEngine::id: { type value; field.second->GetValue(value); dstFields.at(field.first)->SetValue(value); break; }
 
     static constexpr Vector3 kDefaultAim{ 0.f, 0.f, -1.f };
+    static constexpr size_t kMinParallelTransformLevel = 512; /* Hierarchy levels smaller than this are updated on the calling thread */
+    static constexpr size_t kMinParallelRenderExtract = 1024; /* Render views with fewer entities than this are extracted on the calling thread */
 
     Scene::Scene()
     {
@@ -32,6 +39,27 @@ case ScriptEngine::id: { type value; field.second->GetValue(value); dstFields.at
 
         m_Registry.on_construct<CameraComponent>().connect<&Scene::OnCameraComponentConstruction>(this);
         m_Registry.on_destroy<CameraComponent>().connect<&Scene::OnCameraComponentDestruction>(this);
+
+        m_Registry.on_construct<SpriteRendererComponent>().connect<&Scene::OnRenderComponentChange>(this);
+        m_Registry.on_destroy<SpriteRendererComponent>().connect<&Scene::OnRenderComponentChange>(this);
+        m_Registry.on_construct<BillboardSpriteRendererComponent>().connect<&Scene::OnRenderComponentChange>(this);
+        m_Registry.on_destroy<BillboardSpriteRendererComponent>().connect<&Scene::OnRenderComponentChange>(this);
+        m_Registry.on_construct<CircleRendererComponent>().connect<&Scene::OnRenderComponentChange>(this);
+        m_Registry.on_destroy<CircleRendererComponent>().connect<&Scene::OnRenderComponentChange>(this);
+        m_Registry.on_construct<BillboardCircleRendererComponent>().connect<&Scene::OnRenderComponentChange>(this);
+        m_Registry.on_destroy<BillboardCircleRendererComponent>().connect<&Scene::OnRenderComponentChange>(this);
+        m_Registry.on_construct<EllipseRendererComponent>().connect<&Scene::OnRenderComponentChange>(this);
+        m_Registry.on_destroy<EllipseRendererComponent>().connect<&Scene::OnRenderComponentChange>(this);
+        m_Registry.on_construct<PrefabComponent>().connect<&Scene::OnRenderComponentChange>(this);
+        m_Registry.on_destroy<PrefabComponent>().connect<&Scene::OnRenderComponentChange>(this);
+        m_Registry.on_destroy<SpatialProxy>().connect<&Scene::OnSpatialProxyDestruction>(this);
+
+        // Groups
+        RendererGroup<SpriteRendererComponent>();
+        RendererGroup<BillboardSpriteRendererComponent>();
+        RendererGroup<CircleRendererComponent>();
+        RendererGroup<BillboardCircleRendererComponent>();
+        RendererGroup<EllipseRendererComponent>();
     }
 
 
@@ -43,71 +71,76 @@ case ScriptEngine::id: { type value; field.second->GetValue(value); dstFields.at
 
     Ref<Scene> Scene::Copy(Ref<Scene> scene)
     {
+        Timer timer;
+
         Ref<Scene> newScene = CreateRef<Scene>();
         Copy(scene, newScene);
+
+        LV_CORE_INFO("Scene copy ({0} entities) took {1} ms", newScene->m_Entities.size(), timer.ElapsedMillis());
         return newScene;
     }
 
 
+    /// <summary>
+    /// Clones the source scene into a newly constructed destination scene. Entities are recreated with identical entity identifiers,
+    /// so component pools are copied in bulk and hierarchy links are valid without translation.
+    /// </summary>
     void Scene::Copy(Ref<Scene> src, Ref<Scene> dst)
     {
-        dst->SetRootId(src->m_Root);
+        LV_PROFILE_FUNCTION();
+
         dst->m_ViewportAspectRatio = src->m_ViewportAspectRatio;
         dst->m_ActiveCamera = src->m_ActiveCamera;
 
+        dst->CloneEntities(*src);
+
         auto& srcRegistry = src->m_Registry;
         auto& dstRegistry = dst->m_Registry;
-        auto idView = srcRegistry.view<IDComponent>();
-        for (auto e : idView)
-        {
-            UUID uuid = srcRegistry.get<IDComponent>(e).ID;
-            if (uuid == src->m_Root) continue; /* root is already created so we skip it here */
-
-            const std::string& name = srcRegistry.get<TagComponent>(e).Tag;
-            dst->CreateEntityFromUUID(uuid, name);
+        dst->CloneAllOfComponent<IDComponent>(srcRegistry);
+        dst->CloneAllOfComponent<TagComponent>(srcRegistry);
+        dst->CloneAllOfComponent<TransformComponent>(srcRegistry);
+        dst->CloneAllOfComponent<HierarchyComponent>(srcRegistry);
+        dst->CloneAllOfComponent<CameraComponent>(srcRegistry);
+        dst->CloneAllOfComponent<NativeScriptComponent>(srcRegistry);
+        dst->CloneAllOfComponent<SpriteRendererComponent>(srcRegistry);
+        dst->CloneAllOfComponent<BillboardSpriteRendererComponent>(srcRegistry);
+        dst->CloneAllOfComponent<CircleRendererComponent>(srcRegistry);
+        dst->CloneAllOfComponent<BillboardCircleRendererComponent>(srcRegistry);
+        dst->CloneAllOfComponent<EllipseRendererComponent>(srcRegistry);
+        dst->CloneAllOfComponent<PrefabComponent>(srcRegistry); /* prefabs are immutable, so instances in both scenes share them */
+
+        // UUID map
+        dst->m_Root = src->m_Root;
+        dst->m_Entities.clear();
+        dst->m_Entities.reserve(src->m_Entities.size());
+        for (auto [entity, idc] : dstRegistry.storage<IDComponent>().each()) {
+            dst->m_Entities.emplace(idc.ID, entity);
         }
 
-        dst->CopyAllOfComponent<TransformComponent>(src->m_Registry);
-        dst->CopyAllOfComponent<HierarchyComponent>(src->m_Registry);
-        dst->CopyAllOfComponent<CameraComponent>(src->m_Registry);
-        dst->CopyAllOfComponent<NativeScriptComponent>(src->m_Registry);
-        dst->CopyAllOfComponent<SpriteRendererComponent>(src->m_Registry);
-        dst->CopyAllOfComponent<BillboardSpriteRendererComponent>(src->m_Registry);
-        dst->CopyAllOfComponent<CircleRendererComponent>(src->m_Registry);
-        dst->CopyAllOfComponent<BillboardCircleRendererComponent>(src->m_Registry);
-        dst->CopyAllOfComponent<EllipseRendererComponent>(src->m_Registry);
-
         // Copy script engine state
-        auto scriptView = srcRegistry.view<ScriptComponent>();
-        for (auto e : scriptView)
+        /* Script instances are created in the destination context, and source fields are read directly from the source context,
+         * so the script engine context is only switched once */
+        ScriptEngine::SetContext(dst.get());
+        auto& srcScriptContext = src->m_ScriptContext;
+        for (auto [e, srcScript] : srcRegistry.storage<ScriptComponent>().each())
         {
-            LV_CORE_ASSERT(srcRegistry.all_of<IDComponent>(e), "All entities must have UUID!");
             UUID uuid = srcRegistry.get<IDComponent>(e).ID;
-            const ScriptComponent &srcScript = srcRegistry.get<ScriptComponent>(e);
-            LV_CORE_ASSERT(dst->m_Entities.find(uuid) != dst->m_Entities.end(), "Could not find entity with matching ID in the destination scene!");
-            ScriptComponent &dstScript = dst->m_Registry.emplace_or_replace<ScriptComponent>(dst->m_Entities.at(uuid), srcScript);
-
-            ScriptEngine::SetContext(dst.get()); // create script instance in destination scene's context
+            ScriptComponent &dstScript = dstRegistry.emplace_or_replace<ScriptComponent>(e, srcScript);
             dstScript.SetScript(uuid, srcScript.GetScriptName());
 
-            if (srcScript.HasInstance())
+            if (!srcScript.HasInstance()) continue;
+            LV_CORE_ASSERT(dstScript.HasInstance(), "Failed to replicate script instance!");
+
+            auto &srcFields = srcScriptContext.EntityScriptInstances[srcScriptContext.EntityScriptIndices.at(uuid)]->GetFields();
+            auto &dstFields = dstScript.GetScriptInstance(uuid)->GetFields();
+            for (auto &field : srcFields)
             {
-                LV_CORE_ASSERT(dstScript.HasInstance(), "Failed to replicate script instance!");
-                auto &dstScriptInstance = dstScript.GetScriptInstance(uuid);
-                auto &dstFields = dstScriptInstance->GetFields();
-
-                ScriptEngine::SetContext(src.get()); // get source fields from source scene's context
-                auto &srcScriptInstance = srcScript.GetScriptInstance(uuid);
-                auto &srcFields = srcScriptInstance->GetFields();
-                for (auto &field : srcFields)
+                switch (field.second->GetType())
                 {
-                    switch (field.second->GetType())
-                    {
-                        LV_SCRIPT_ENGINE_FIELD_LIST(LV_SCENE_COPY_ENTITY_SCRIPT_FIELDS)
+                    LV_SCRIPT_ENGINE_FIELD_LIST(LV_SCENE_COPY_ENTITY_SCRIPT_FIELDS)
 
-                    default:
-                        LV_CORE_ERROR("Unrecognised field type!");
-                    }
+                default:
+                    LV_CORE_ERROR("Unrecognised field type!");
                 }
             }
         }
@@ -115,6 +148,35 @@ case ScriptEngine::id: { type value; field.second->GetValue(value); dstFields.at
     }
 
 
+    /// <summary>
+    /// Creates an entity for every entity in the source scene, with the same entity identifier. Must be called on a newly constructed scene:
+    /// the root is the first entity created by every scene, so it is the only entity which already exists.
+    /// </summary>
+    void Scene::CloneEntities(Scene& src)
+    {
+        LV_CORE_ASSERT(m_Entities.size() == 1 && m_Entities.at(m_Root) == src.m_Entities.at(src.m_Root), "Scene must be newly constructed!");
+
+        /* Created in ascending identifier order, so each requested identifier is either past the end of the entity pool or in its
+         * free list at a short walk from the head */
+        std::vector<entt::entity> entities;
+        entities.reserve(src.m_Entities.size());
+        for (auto entity : src.m_Registry.storage<IDComponent>()) {
+            entities.push_back(entity);
+        }
+        std::sort(entities.begin(), entities.end(), [](entt::entity a, entt::entity b) {
+            return entt::to_entity(a) < entt::to_entity(b);
+        });
+
+        m_Registry.reserve(src.m_Registry.size());
+        for (auto entity : entities)
+        {
+            if (m_Registry.valid(entity)) continue; /* root */
+            [[maybe_unused]] auto created = m_Registry.create(entity);
+            LV_CORE_ASSERT(created == entity, "Failed to clone entity identifier!");
+        }
+    }
+
+
     Entity Scene::CreateEntityFromUUID(UUID uuid, const std::string& name, UUID parent)
     {
         Entity entity{ m_Registry.create(), this };
@@ -154,36 +216,180 @@ case ScriptEngine::id: { type value; field.second->GetValue(value); dstFields.at
         CopyComponentIfExists<CircleRendererComponent>(newEntity.m_EnttId, entity.m_EnttId);
         CopyComponentIfExists<BillboardCircleRendererComponent>(newEntity.m_EnttId, entity.m_EnttId);
         CopyComponentIfExists<EllipseRendererComponent>(newEntity.m_EnttId, entity.m_EnttId);
+        CopyComponentIfExists<PrefabComponent>(newEntity.m_EnttId, entity.m_EnttId);
 
-        // Duplicate script component
-        if (entity.HasComponent<ScriptComponent>())
-        {
-            auto &dstComponent = newEntity.AddComponent<ScriptComponent>();
+        DuplicateScriptComponent(newEntity, entity);
 
-            auto &srcComponent = entity.GetComponent<ScriptComponent>();
-            if (srcComponent.HasInstance())
-            {
-                dstComponent.SetScript(newEntity.GetUUID(), srcComponent.GetScriptName());
+        return newEntity;
+    }
+
+
+    void Scene::DuplicateScriptComponent(Entity dst, Entity src)
+    {
+        if (!src.HasComponent<ScriptComponent>()) return;
+
+        auto &dstComponent = dst.AddComponent<ScriptComponent>();
+
+        auto &srcComponent = src.GetComponent<ScriptComponent>();
+        if (srcComponent.HasInstance())
+        {
+            dstComponent.SetScript(dst.GetUUID(), srcComponent.GetScriptName());
 
-                auto &dstScriptInstance = dstComponent.GetScriptInstance(newEntity.GetUUID());
-                auto &dstFields = dstScriptInstance->GetFields();
+            auto &dstScriptInstance = dstComponent.GetScriptInstance(dst.GetUUID());
+            auto &dstFields = dstScriptInstance->GetFields();
 
-                auto &srcScriptInstance = srcComponent.GetScriptInstance(entity.GetUUID());
-                auto &srcFields = srcScriptInstance->GetFields();
-                for (auto &field : srcFields)
+            auto &srcScriptInstance = srcComponent.GetScriptInstance(src.GetUUID());
+            auto &srcFields = srcScriptInstance->GetFields();
+            for (auto &field : srcFields)
+            {
+                switch (field.second->GetType())
                 {
-                    switch (field.second->GetType())
-                    {
-                        LV_SCRIPT_ENGINE_FIELD_LIST(LV_SCENE_COPY_ENTITY_SCRIPT_FIELDS)
+                    LV_SCRIPT_ENGINE_FIELD_LIST(LV_SCENE_COPY_ENTITY_SCRIPT_FIELDS)
 
-                    default:
-                        LV_CORE_ERROR("Unrecognised field type!");
-                    }
+                default:
+                    LV_CORE_ERROR("Unrecognised field type!");
                 }
             }
         }
+    }
 
-        return newEntity;
+
+    /// <summary>
+    /// Fills the given array with new entities which have only the essential components, as consecutive children of the given parent
+    /// (or the root). Essential components are inserted in bulk, and the new siblings are linked to each other in one pass and spliced
+    /// into the parent's child ring once.
+    /// </summary>
+    void Scene::CreateBareEntities(std::vector<entt::entity>& created, UUID parent, const std::string& name, const TransformComponent& transform)
+    {
+        size_t count = created.size();
+        entt::entity parentId = m_Entities.at(parent == UUID::Null ? m_Root : parent);
+        m_Registry.create(created.begin(), created.end());
+
+        // Essential components
+        {
+            std::vector<IDComponent> ids(count); /* each default-constructed UUID is random */
+            m_Entities.reserve(m_Entities.size() + count);
+            for (size_t i = 0; i < count; i++) {
+                m_Entities[ids[i].ID] = created[i];
+            }
+            m_Registry.insert<IDComponent>(created.begin(), created.end(), ids.begin());
+        }
+        m_Registry.insert<TagComponent>(created.begin(), created.end(), TagComponent{ name });
+        {
+            TransformComponent bareTransform = transform;
+            bareTransform.WorldNeedCompute = true;
+            m_Registry.insert<TransformComponent>(created.begin(), created.end(), bareTransform);
+        }
+
+        // Hierarchy
+        {
+            entt::entity head = GetComponent<HierarchyComponent>(parentId).FirstChild;
+            entt::entity tail = head == entt::null ? entt::null : GetComponent<HierarchyComponent>(head).PrevSibling;
+
+            std::vector<HierarchyComponent> hierarchies(count);
+            for (size_t i = 0; i < count; i++) {
+                hierarchies[i].Parent = parentId;
+                hierarchies[i].PrevSibling = created[i == 0 ? count - 1 : i - 1];
+                hierarchies[i].NextSibling = created[i + 1 == count ? 0 : i + 1];
+            }
+            if (head != entt::null) {
+                hierarchies.front().PrevSibling = tail;
+                hierarchies.back().NextSibling = head;
+            }
+            m_Registry.insert<HierarchyComponent>(created.begin(), created.end(), hierarchies.begin());
+
+            /* Fetched after the insertion, which may have reallocated the pool */
+            if (head == entt::null) {
+                GetComponent<HierarchyComponent>(parentId).FirstChild = created.front();
+            }
+            else {
+                GetComponent<HierarchyComponent>(head).PrevSibling = created.back();
+                GetComponent<HierarchyComponent>(tail).NextSibling = created.front();
+            }
+        }
+    }
+
+
+    /// <summary>
+    /// Creates a number of entities as consecutive children of the given parent (or the root), each with a copy of the prototype's
+    /// components if a prototype is given. Components are inserted in bulk (see CreateBareEntities()), and the spatial index is notified
+    /// of all new renderers at once.
+    /// </summary>
+    std::vector<Entity> Scene::CreateEntities(size_t count, UUID prototypeId, UUID parent)
+    {
+        LV_PROFILE_FUNCTION();
+
+        std::vector<Entity> entities;
+        if (count == 0) return entities;
+
+        Entity prototype = prototypeId == UUID::Null ? Entity::Null : Entity{ m_Entities.at(prototypeId), this };
+        std::vector<entt::entity> created(count);
+        CreateBareEntities(created, parent, prototype ? prototype.GetName() : "Unnamed Entity",
+            prototype ? prototype.GetComponent<TransformComponent>() : TransformComponent{});
+
+        // Prototype components
+        if (prototype)
+        {
+            CloneComponentToEntities<CameraComponent>(prototype.m_EnttId, created);
+            CloneComponentToEntities<NativeScriptComponent>(prototype.m_EnttId, created);
+            CloneRendererToEntities<SpriteRendererComponent>(prototype.m_EnttId, created);
+            CloneRendererToEntities<BillboardSpriteRendererComponent>(prototype.m_EnttId, created);
+            CloneRendererToEntities<CircleRendererComponent>(prototype.m_EnttId, created);
+            CloneRendererToEntities<BillboardCircleRendererComponent>(prototype.m_EnttId, created);
+            CloneRendererToEntities<EllipseRendererComponent>(prototype.m_EnttId, created);
+            CloneRendererToEntities<PrefabComponent>(prototype.m_EnttId, created);
+        }
+
+        entities.reserve(count);
+        for (auto entity : created) {
+            entities.emplace_back(entity, this);
+        }
+
+        /* Script instances are created per entity by the script engine */
+        if (prototype && prototype.HasComponent<ScriptComponent>()) {
+            for (auto& entity : entities) {
+                DuplicateScriptComponent(entity, prototype);
+            }
+        }
+        return entities;
+    }
+
+
+    /// <summary>
+    /// Creates a number of instances of a prefab as consecutive children of the given parent (or the root). Instances only store the
+    /// essential components and a reference to the prefab - renderers are read from the prefab until an instance is given its own.
+    /// </summary>
+    std::vector<Entity> Scene::InstantiatePrefab(const Ref<Prefab>& prefab, size_t count, UUID parent)
+    {
+        LV_PROFILE_FUNCTION();
+
+        std::vector<Entity> entities;
+        if (count == 0) return entities;
+
+        std::vector<entt::entity> created(count);
+        CreateBareEntities(created, parent, prefab->GetName(), prefab->GetTransform());
+        AttachPrefab(prefab, created);
+
+        entities.reserve(count);
+        for (auto entity : created) {
+            entities.emplace_back(entity, this);
+        }
+        return entities;
+    }
+
+
+    /// <summary> Makes existing entities instances of a prefab, and creates their script instances </summary>
+    void Scene::AttachPrefab(const Ref<Prefab>& prefab, const std::vector<entt::entity>& instances)
+    {
+        InsertRendererToEntities<PrefabComponent>(instances, PrefabComponent{ prefab });
+
+        /* Script instances are created per entity by the script engine */
+        if (!prefab->GetScriptClass().empty()) {
+            for (auto entity : instances) {
+                UUID uuid = GetComponent<IDComponent>(entity).ID;
+                AddComponent<ScriptComponent>(entity).SetScript(uuid, prefab->GetScriptClass());
+            }
+        }
     }
 
 
@@ -193,6 +399,51 @@ case ScriptEngine::id: { type value; field.second->GetValue(value); dstFields.at
     }
 
 
+    /// <summary>
+    /// Destroys a set of entities and all of their descendants. Each subtree root is disconnected from its surviving parent once,
+    /// then the subtrees are destroyed leaves-first without the per-entity hierarchy destruction signal.
+    /// </summary>
+    void Scene::DestroyEntities(std::span<const Entity> entities)
+    {
+        LV_PROFILE_FUNCTION();
+
+        std::unordered_set<entt::entity> requested;
+        requested.reserve(entities.size());
+        for (auto& entity : entities) {
+            LV_CORE_ASSERT(entity.m_EnttId != m_Entities.at(m_Root), "Cannot destroy the scene root!");
+            if (entity) requested.insert(entity.m_EnttId);
+        }
+
+        // Collect subtrees of the requested entities which do not have a requested ancestor
+        std::vector<Entity> doomed;
+        for (auto entityId : requested)
+        {
+            bool requestedAncestor = false;
+            for (auto ancestor = GetComponent<HierarchyComponent>(entityId).Parent; ancestor != entt::null;
+                ancestor = GetComponent<HierarchyComponent>(ancestor).Parent)
+            {
+                if (requested.contains(ancestor)) {
+                    requestedAncestor = true;
+                    break;
+                }
+            }
+            if (requestedAncestor) continue;
+
+            HierarchyDisconnect(entityId);
+            doomed.emplace_back(entityId, this);
+            GetTree(doomed.back(), doomed);
+        }
+
+        // Destroy leaves first - every parent's subtree is already gone when it is destroyed
+        m_Registry.on_destroy<HierarchyComponent>().disconnect<&Scene::OnHierarchyComponentDestruction>(this);
+        for (auto it = doomed.rbegin(); it != doomed.rend(); ++it) {
+            m_Entities.erase(GetComponent<IDComponent>(it->m_EnttId).ID);
+            m_Registry.destroy(it->m_EnttId);
+        }
+        m_Registry.on_destroy<HierarchyComponent>().connect<&Scene::OnHierarchyComponentDestruction>(this);
+    }
+
+
     bool Scene::IsEntity(UUID uuid)
     {
         return m_Entities.find(uuid) != m_Entities.end();
@@ -219,10 +470,6 @@ case ScriptEngine::id: { type value; field.second->GetValue(value); dstFields.at
         auto& idc = GetComponent<IDComponent>(m_Entities.at(m_Root));
         idc.ID = id;
 
-        for (auto child : GetChildren({ m_Entities.at(m_Root), this })) {
-            auto& hc = child.GetComponent<HierarchyComponent>();
-            hc.Parent = id;
-        }
     }
 
 
@@ -241,21 +488,14 @@ case ScriptEngine::id: { type value; field.second->GetValue(value); dstFields.at
 
     Entity Scene::GetParent(Entity entity)
     {
-        return Entity{ m_Entities.at(GetComponent<HierarchyComponent>(entity.m_EnttId).Parent), this };
+        return Entity{ GetComponent<HierarchyComponent>(entity.m_EnttId).Parent, this };
     }
 
 
     std::vector<Entity> Scene::GetChildren(Entity entity)
     {
         std::vector<Entity> children;
-        auto& hierarchy = m_Registry.get<HierarchyComponent>(entity.m_EnttId);
-        auto first = hierarchy.FirstChild;
-        auto child = first;
-        do {
-            if (child == UUID::Null) break;
-            children.push_back(Entity{ m_Entities[child], this });
-            child = GetComponent<HierarchyComponent>(m_Entities[child]).NextSibling;
-        } while (child != first);
+        GetChildren(entity, children);
         return children;
     }
 
@@ -267,19 +507,8 @@ case ScriptEngine::id: { type value; field.second->GetValue(value); dstFields.at
     /// </summary>
     std::vector<Entity> Scene::GetTree(Entity root)
     {
-        std::vector<Entity> entities = GetChildren(root);
-        size_t numAdded = entities.size();
-        do {
-            size_t end = entities.size();
-            size_t idx = end - numAdded;
-            numAdded = 0;
-            while (idx < end) {
-                auto children = GetChildren(entities[idx]);
-                entities.insert(entities.end(), children.begin(), children.end());
-                numAdded += children.size();
-                idx++;
-            }
-        } while (numAdded > 0);
+        std::vector<Entity> entities;
+        GetTree(root, entities);
         return entities;
     }
 
@@ -287,31 +516,227 @@ case ScriptEngine::id: { type value; field.second->GetValue(value); dstFields.at
     {
         size_t size = children.size();
         auto first = m_Registry.get<HierarchyComponent>(parent.m_EnttId).FirstChild;
-        if (first == UUID::Null) return 0;
+        if (first == entt::null) return 0;
         auto child = first;
         do {
-            auto enttId = m_Entities.at(child);
-            children.emplace_back(enttId, this);
-            child = GetComponent<HierarchyComponent>(enttId).NextSibling;
+            children.emplace_back(child, this);
+            child = m_Registry.get<HierarchyComponent>(child).NextSibling;
         } while (child != first);
         return children.size() - size;
     }
 
     size_t Scene::GetTree(Entity root, std::vector<Entity>& tree)
     {
-        size_t size = GetChildren(root, tree);
-        size_t numAdded = size;
-        do {
-            size_t end = tree.size();
-            size_t idx = end - numAdded;
-            numAdded = 0;
-            while (idx < end) {
-                numAdded += GetChildren(tree[idx], tree);
-                idx++;
+        /* Breadth-first: the tree array doubles as the traversal queue */
+        size_t begin = tree.size();
+        GetChildren(root, tree);
+        for (size_t idx = begin; idx < tree.size(); idx++) {
+            GetChildren(tree[idx], tree);
+        }
+        return tree.size() - begin;
+    }
+
+
+    /// <summary>
+    /// Recomputes the world transforms of all entities whose transform, or any ancestor's transform, has changed since the last call.
+    /// Dirty subtrees are processed breadth-first, one hierarchy level at a time - entities in the same level depend only on the
+    /// previous level, so large levels are updated in parallel.
+    /// </summary>
+    void Scene::UpdateWorldTransforms()
+    {
+        LV_PROFILE_FUNCTION();
+
+        auto& transforms = m_Registry.storage<TransformComponent>();
+        auto& hierarchies = m_Registry.storage<HierarchyComponent>();
+
+        // Find dirty subtree roots: dirty entities with no dirty ancestor
+        /* Each entity's path state (whether it or any ancestor is dirty) is resolved once: a walk up from an entity stops at the
+         * first ancestor already resolved, then resolves the entities it passed on the way back down - so the pass is linear */
+        enum PathState : uint8_t { Unresolved = 0, CleanPath, DirtyPath };
+        auto& pathStates = m_WorldDirtyPaths;
+        pathStates.assign(m_Registry.size(), Unresolved);
+        auto& walk = m_WorldDirtyWalk;
+
+        std::vector<entt::entity> level;
+        for (auto entity : transforms)
+        {
+            walk.clear();
+            auto top = entity;
+            while (top != entt::null && pathStates[entt::to_entity(top)] == Unresolved) {
+                walk.push_back(top);
+                top = hierarchies.get(top).Parent;
+            }
+            bool dirtyAbove = top != entt::null && pathStates[entt::to_entity(top)] == DirtyPath;
+            for (auto it = walk.rbegin(); it != walk.rend(); ++it)
+            {
+                bool dirty = transforms.get(*it).WorldNeedCompute;
+                if (dirty && !dirtyAbove) level.push_back(*it);
+                dirtyAbove = dirtyAbove || dirty;
+                pathStates[entt::to_entity(*it)] = dirtyAbove ? DirtyPath : CleanPath;
+            }
+        }
+
+        auto updateWorld = [&](entt::entity entity) {
+            auto& tc = transforms.get(entity);
+            auto parent = hierarchies.get(entity).Parent;
+            if (tc.InheritParent && parent != entt::null) {
+                tc.WorldTransform = transforms.get(parent).WorldTransform * tc.GetTransform();
+            }
+            else {
+                tc.WorldTransform = tc.GetTransform();
+            }
+            tc.WorldNeedCompute = false;
+        };
+
+        std::vector<entt::entity> nextLevel;
+        while (!level.empty())
+        {
+            if (level.size() < kMinParallelTransformLevel) {
+                std::for_each(level.begin(), level.end(), updateWorld);
+            }
+            else {
+                std::for_each(std::execution::par, level.begin(), level.end(), updateWorld);
+            }
+            m_SpatialDirty.insert(m_SpatialDirty.end(), level.begin(), level.end());
+
+            // Every child of an updated entity needs updating, whether or not its own transform changed
+            nextLevel.clear();
+            for (auto entity : level)
+            {
+                auto first = hierarchies.get(entity).FirstChild;
+                if (first == entt::null) continue;
+                auto child = first;
+                do {
+                    nextLevel.push_back(child);
+                    child = hierarchies.get(child).NextSibling;
+                } while (child != first);
+            }
+            std::swap(level, nextLevel);
+        }
+
+        UpdateSpatialIndex();
+    }
+
+
+    /// <summary>
+    /// Bounding sphere of an entity's rendered primitive, from its world transform. Every primitive is drawn within the unit quad centred
+    /// on its transform's origin, so the quad's half-diagonal bounds it - billboards are bounded in any orientation.
+    /// </summary>
+    Vector3 Scene::GetRenderBoundingSphere(entt::entity entity, float& radius)
+    {
+        auto& tc = m_Registry.get<TransformComponent>(entity);
+        if (TryGetRenderer<BillboardSpriteRendererComponent>(entity) || TryGetRenderer<BillboardCircleRendererComponent>(entity)) {
+            Vector3 scale = tc.GetScale();
+            radius = 0.5f * sqrtf(scale.x * scale.x + scale.y * scale.y);
+            return tc.GetWorldPosition();
+        }
+        glm::mat4 const& m = tc.GetWorldTransform().mat;
+        radius = 0.5f * sqrtf(glm::dot(glm::vec3{ m[0] }, glm::vec3{ m[0] }) + glm::dot(glm::vec3{ m[1] }, glm::vec3{ m[1] }));
+        return { m[3][0], m[3][1], m[3][2] };
+    }
+
+
+    /// <summary>
+    /// Inserts, moves or removes the spatial index leaves of entities whose world transform or renderer components changed.
+    /// </summary>
+    void Scene::UpdateSpatialIndex()
+    {
+        LV_PROFILE_FUNCTION();
+
+        for (auto entity : m_SpatialDirty)
+        {
+            if (!m_Registry.valid(entity)) continue; /* Destroyed - its leaf was removed with its SpatialProxy */
+
+            auto* instance = m_Registry.try_get<PrefabComponent>(entity);
+            bool renderable = m_Registry.all_of<TransformComponent>(entity) && (m_Registry.any_of<SpriteRendererComponent,
+                BillboardSpriteRendererComponent, CircleRendererComponent, BillboardCircleRendererComponent, EllipseRendererComponent>(entity) ||
+                (instance != nullptr && instance->Source->HasRenderer()));
+            auto* proxy = m_Registry.try_get<SpatialProxy>(entity);
+            if (!renderable) {
+                if (proxy != nullptr) m_Registry.erase<SpatialProxy>(entity);
+                continue;
+            }
+
+            float radius;
+            Vector3 center = GetRenderBoundingSphere(entity, radius);
+            Aabb bounds = Aabb::FromSphere(center, radius);
+            if (proxy == nullptr) {
+                m_Registry.emplace<SpatialProxy>(entity, m_SpatialIndex.Insert(bounds, entity));
+            }
+            else {
+                m_SpatialIndex.Move(proxy->Node, bounds);
+            }
+        }
+        m_SpatialDirty.clear();
+    }
+
+
+    Entity Scene::RaycastEntity(const Vector3& origin, const Vector3& direction, float maxDistance)
+    {
+        LV_PROFILE_FUNCTION();
+
+        Vector3 rayDirection = direction.Normalized();
+        entt::entity closest = entt::null;
+        m_SpatialIndex.RayCast(origin, rayDirection, maxDistance, [&](int32_t node, float maxHitDistance) {
+            entt::entity entity = m_SpatialIndex.GetUserData(node);
+
+            float distance;
+            if (m_Registry.any_of<BillboardSpriteRendererComponent, BillboardCircleRendererComponent>(entity))
+            {
+                /* Billboards face the camera, so they are hit when the ray passes within their bounding radius */
+                float radius;
+                Vector3 center = GetRenderBoundingSphere(entity, radius);
+                distance = (center - origin).Dot(rayDirection);
+                Vector3 closestPoint = origin + rayDirection * distance;
+                if (distance < 0.f || (center - closestPoint).SqrMagnitude() > radius * radius) return maxHitDistance;
+            }
+            else
+            {
+                /* Other primitives lie in their local XY plane, within the unit quad */
+                Matrix4 worldToLocal = m_Registry.get<TransformComponent>(entity).GetWorldTransform().Inverse();
+                Vector4 localOrigin = worldToLocal * Vector4{ origin, 1.f };
+                Vector4 localDirection = worldToLocal * Vector4{ rayDirection, 0.f };
+                if (abs(localDirection.z) < 1e-9f) return maxHitDistance;
+
+                distance = -localOrigin.z / localDirection.z;
+                float x = localOrigin.x + distance * localDirection.x;
+                float y = localOrigin.y + distance * localDirection.y;
+                bool hit = m_Registry.all_of<SpriteRendererComponent>(entity) ?
+                    (abs(x) <= 0.5f && abs(y) <= 0.5f) : (x * x + y * y <= 0.25f);
+                if (distance < 0.f || !hit) return maxHitDistance;
+            }
+
+            if (distance < maxHitDistance) {
+                closest = entity;
+                return distance;
+            }
+            return maxHitDistance;
+        });
+        return closest == entt::null ? Entity::Null : Entity{ closest, this };
+    }
+
+
+    void Scene::QueryBox(const Aabb& box, std::vector<Entity>& results)
+    {
+        m_SpatialIndex.QueryAabb(box, [&](int32_t node) {
+            results.emplace_back(m_SpatialIndex.GetUserData(node), this);
+            return true;
+        });
+    }
+
+
+    void Scene::QueryRadius(const Vector3& center, float radius, std::vector<Entity>& results)
+    {
+        m_SpatialIndex.QuerySphere(center, radius, [&](int32_t node) {
+            entt::entity entity = m_SpatialIndex.GetUserData(node);
+            float boundingRadius;
+            Vector3 boundingCenter = GetRenderBoundingSphere(entity, boundingRadius);
+            float maxDistance = radius + boundingRadius;
+            if ((boundingCenter - center).SqrMagnitude() <= maxDistance * maxDistance) {
+                results.emplace_back(entity, this);
             }
-            size += numAdded;
-        } while (numAdded > 0);
-        return size;
+            return true;
+        });
     }
 
 
@@ -394,9 +819,11 @@ case ScriptEngine::id: { type value; field.second->GetValue(value); dstFields.at
             LV_CORE_WARN("Scene has no active camera - no rendering!");
             return;
         }
+        UpdateWorldTransforms();
+
         auto cameraEntity = m_Entities[m_ActiveCamera];
         auto [camera, camTransform] = GetComponents<CameraComponent, TransformComponent>(cameraEntity);
-        camera.Camera.SetView(camTransform.GetTransform().Inverse());
+        camera.Camera.SetView(camTransform.GetWorldTransform().Inverse());
 
         RenderScene(camera.Camera, camTransform.GetOrientation());
     }
@@ -404,74 +831,181 @@ case ScriptEngine::id: { type value; field.second->GetValue(value); dstFields.at
 
     void Scene::OnRenderEditor(EditorCamera& camera)
     {
+        UpdateWorldTransforms();
+
         RenderScene(camera.GetCamera(), camera.GetOrientation());
     }
 
 
-    void Scene::RenderScene(Camera& camera, const Quaternion& cameraOrientation)
+    /// <summary>
+    /// Sort key layout, most significant first: layer (8 bits), primitive type (8), texture (16), depth (32).
+    /// Renderer2D batches each primitive type separately, so grouping by type matches the order in which batches are flushed;
+    /// within a type, packets are ordered back-to-front so that transparent primitives blend correctly.
+    /// </summary>
+    uint64_t Scene::RenderSortKey(uint8_t layer, RenderPacket::Primitive type, uint16_t texture, float depth)
     {
-        Renderer2D::BeginScene(camera);
+        /* Map the float's bits to an unsigned integer with the same ordering, then invert so that the furthest sorts first */
+        uint32_t depthBits;
+        std::memcpy(&depthBits, &depth, sizeof(float));
+        depthBits = (depthBits & 0x80000000u) ? ~depthBits : (depthBits | 0x80000000u);
+        depthBits = ~depthBits;
+
+        return ((uint64_t)layer << 56) | ((uint64_t)type << 48) | ((uint64_t)texture << 32) | (uint64_t)depthBits;
+    }
 
-        // Sprites
-        {
-            auto view = m_Registry.view<TransformComponent, SpriteRendererComponent>();
-            for (auto entity : view)
-            {
-                auto [transform, sprite] = view.get<TransformComponent, SpriteRendererComponent>(entity);
 
-                Renderer2D::DrawQuad(transform.GetTransform(), sprite.Color, (int)entity);
+    void Scene::ExtractRenderPackets(Camera& camera, const Quaternion& cameraOrientation)
+    {
+        LV_PROFILE_FUNCTION();
+
+        const Matrix4& view = camera.GetView();
+        Camera::Frustum frustum = camera.GetFrustum();
+
+        m_RenderPackets.clear();
+        m_RenderKeys.clear();
+
+        /* Each entity range is first flattened to an entity array on this thread, then its packets are filled in parallel:
+         * every packet depends only on its own entity's components, and the component storages are only read */
+        std::vector<size_t> extractIndices;
+        auto extract = [&](auto first, auto last, RenderPacket::Primitive type, auto&& fill) {
+            m_RenderExtractEntities.assign(first, last);
+            size_t base = m_RenderPackets.size();
+            m_RenderPackets.resize(base + m_RenderExtractEntities.size());
+            m_RenderKeys.resize(base + m_RenderExtractEntities.size());
+
+            auto fillPacket = [&](size_t i) {
+                entt::entity entity = m_RenderExtractEntities[i];
+                size_t idx = base + i;
+                auto& packet = m_RenderPackets[idx];
+                packet.Type = type;
+                packet.EntityId = (int)entity;
+                fill(entity, packet);
+
+                /* Every primitive is drawn within the unit quad centred on its transform's origin, so the quad's half-diagonal bounds it */
+                glm::mat4 const& m = packet.Transform.mat;
+                Vector3 center = { m[3][0], m[3][1], m[3][2] };
+                float boundingRadius = 0.5f * sqrtf(glm::dot(glm::vec3{ m[0] }, glm::vec3{ m[0] }) + glm::dot(glm::vec3{ m[1] }, glm::vec3{ m[1] }));
+                packet.Culled = !frustum.IntersectsSphere(center, boundingRadius);
+
+                float depth = -(view * Vector4{ center, 1.f }).z;
+                m_RenderKeys[idx] = { RenderSortKey(0, type, 0, depth), (uint32_t)idx };
+            };
+            if (m_RenderExtractEntities.size() < kMinParallelRenderExtract) {
+                for (size_t i = 0; i < m_RenderExtractEntities.size(); i++) {
+                    fillPacket(i);
+                }
             }
-        }
+            else {
+                extractIndices.resize(m_RenderExtractEntities.size());
+                std::iota(extractIndices.begin(), extractIndices.end(), 0);
+                std::for_each(std::execution::par, extractIndices.begin(), extractIndices.end(), fillPacket);
+            }
+        };
+
+        /* Each renderer type is extracted from its group, then from the prefab instances which draw their prefab's renderer of that type */
+        auto& transforms = m_Registry.storage<TransformComponent>();
+        auto& prefabInstances = m_Registry.storage<PrefabComponent>();
+        auto extractRenderer = [&](auto group, auto& renderers, RenderPacket::Primitive type, auto&& fill) {
+            using TRenderer = typename std::remove_reference_t<decltype(renderers)>::value_type;
+
+            extract(group.begin(), group.end(), type, [&](entt::entity entity, RenderPacket& packet) {
+                fill(entity, renderers.get(entity), packet);
+            });
+
+            m_RenderPrefabEntities.clear();
+            for (auto [entity, instance] : prefabInstances.each()) {
+                if (instance.Source->TryGetRenderer<TRenderer>() != nullptr && !renderers.contains(entity) && transforms.contains(entity)) {
+                    m_RenderPrefabEntities.push_back(entity);
+                }
+            }
+            extract(m_RenderPrefabEntities.begin(), m_RenderPrefabEntities.end(), type, [&](entt::entity entity, RenderPacket& packet) {
+                fill(entity, *prefabInstances.get(entity).Source->TryGetRenderer<TRenderer>(), packet);
+            });
+        };
 
-        // Billboard sprites
-        {
-            auto view = m_Registry.view<TransformComponent, BillboardSpriteRendererComponent>();
-            for (auto entity : view)
-            {
-                auto [tc, bsrc] = view.get<TransformComponent, BillboardSpriteRendererComponent>(entity);
+        auto billboard = [&](TransformComponent& tc) {
+            Matrix4 billboardTransform = glm::translate(glm::mat4(1.f), (glm::vec3)(tc.GetWorldPosition()));
+            billboardTransform = billboardTransform * Matrix4(cameraOrientation);
+            return Matrix4(glm::scale((glm::mat4)billboardTransform, (glm::vec3)(tc.GetScale())));
+        };
 
-                Matrix4 billboardTransform = glm::translate(glm::mat4(1.f), (glm::vec3)(tc.GetPosition()));
-                billboardTransform = billboardTransform * Matrix4(cameraOrientation);
-                billboardTransform = glm::scale((glm::mat4)billboardTransform, (glm::vec3)(tc.GetScale()));
-                Renderer2D::DrawQuad(billboardTransform, bsrc.Color, (int)entity);
-            }
-        }
+        // Sprites
+        extractRenderer(RendererGroup<SpriteRendererComponent>(), m_Registry.storage<SpriteRendererComponent>(), RenderPacket::Primitive::Quad,
+            [&](entt::entity entity, const SpriteRendererComponent& sprite, RenderPacket& packet) {
+                packet.Transform = transforms.get(entity).GetWorldTransform();
+                packet.Color = sprite.Color;
+            });
 
-        // Circles
-        {
-            auto view = m_Registry.view<TransformComponent, CircleRendererComponent>();
-            for (auto entity : view)
-            {
-                auto [transform, circle] = view.get<TransformComponent, CircleRendererComponent>(entity);
+        // Billboard sprites
+        extractRenderer(RendererGroup<BillboardSpriteRendererComponent>(), m_Registry.storage<BillboardSpriteRendererComponent>(), RenderPacket::Primitive::Quad,
+            [&](entt::entity entity, const BillboardSpriteRendererComponent& sprite, RenderPacket& packet) {
+                packet.Transform = billboard(transforms.get(entity));
+                packet.Color = sprite.Color;
+            });
 
-                Renderer2D::DrawCircle(transform.GetTransform(), circle.Color, circle.Thickness, circle.Fade, (int)entity);
-            }
-        }
+        // Circles
+        extractRenderer(RendererGroup<CircleRendererComponent>(), m_Registry.storage<CircleRendererComponent>(), RenderPacket::Primitive::Circle,
+            [&](entt::entity entity, const CircleRendererComponent& circle, RenderPacket& packet) {
+                packet.Transform = transforms.get(entity).GetWorldTransform();
+                packet.Color = circle.Color;
+                packet.Thickness = circle.Thickness;
+                packet.Fade = circle.Fade;
+            });
 
         // Billboard circles
-        {
-            auto view = m_Registry.view<TransformComponent, BillboardCircleRendererComponent>();
-            for (auto entity : view)
-            {
-                auto [tc, bcrc] = view.get<TransformComponent, BillboardCircleRendererComponent>(entity);
-
-                Matrix4 billboardTransform = glm::translate(glm::mat4(1.f), (glm::vec3)(tc.GetPosition()));
-                billboardTransform = billboardTransform * Matrix4(cameraOrientation);
-                billboardTransform = glm::scale((glm::mat4)billboardTransform, (glm::vec3)(tc.GetScale()));
-                Renderer2D::DrawCircle(billboardTransform, bcrc.Color, bcrc.Thickness, bcrc.Fade, (int)entity);
-            }
-        }
+        extractRenderer(RendererGroup<BillboardCircleRendererComponent>(), m_Registry.storage<BillboardCircleRendererComponent>(), RenderPacket::Primitive::Circle,
+            [&](entt::entity entity, const BillboardCircleRendererComponent& circle, RenderPacket& packet) {
+                packet.Transform = billboard(transforms.get(entity));
+                packet.Color = circle.Color;
+                packet.Thickness = circle.Thickness;
+                packet.Fade = circle.Fade;
+            });
 
         // Ellipses
+        extractRenderer(RendererGroup<EllipseRendererComponent>(), m_Registry.storage<EllipseRendererComponent>(), RenderPacket::Primitive::Ellipse,
+            [&](entt::entity entity, const EllipseRendererComponent& ellipse, RenderPacket& packet) {
+                auto& tc = transforms.get(entity);
+                float sx = abs(tc.GetScale().x);
+                float sy = abs(tc.GetScale().y);
+                packet.Transform = tc.GetWorldTransform();
+                packet.Color = ellipse.Color;
+                packet.Thickness = ellipse.Thickness;
+                packet.Fade = ellipse.Fade;
+                packet.AxisRatio = sx > sy ? sx / sy : sy / sx;
+            });
+    }
+
+
+    void Scene::RenderScene(Camera& camera, const Quaternion& cameraOrientation)
+    {
+        LV_PROFILE_FUNCTION();
+
+        ExtractRenderPackets(camera, cameraOrientation);
+
+        size_t numExtracted = m_RenderKeys.size();
+        std::erase_if(m_RenderKeys, [this](SortKeyIndex const& key) { return m_RenderPackets[key.Index].Culled; });
+        auto& stats = Renderer2D::GetStatistics();
+        stats.ItemsDrawn += (uint32_t)m_RenderKeys.size();
+        stats.ItemsCulled += (uint32_t)(numExtracted - m_RenderKeys.size());
+
+        RadixSort(m_RenderKeys, m_RenderKeysScratch);
+
+        Renderer2D::BeginScene(camera);
+
+        for (auto const& key : m_RenderKeys)
         {
-            auto view = m_Registry.view<TransformComponent, EllipseRendererComponent>();
-            for (auto entity : view)
+            auto const& packet = m_RenderPackets[key.Index];
+            switch (packet.Type)
             {
-                auto [transform, ellipse] = view.get<TransformComponent, EllipseRendererComponent>(entity);
-                float sx = abs(transform.GetScale().x);
-                float sy = abs(transform.GetScale().y);
-                float axisRatio = sx > sy ? sx / sy : sy / sx;
-                Renderer2D::DrawEllipse(transform.GetTransform(), axisRatio, ellipse.Color, ellipse.Thickness, ellipse.Fade, (int)entity);
+            case RenderPacket::Primitive::Quad:
+                Renderer2D::DrawQuad(packet.Transform, packet.Color, packet.EntityId);
+                break;
+            case RenderPacket::Primitive::Circle:
+                Renderer2D::DrawCircle(packet.Transform, packet.Color, packet.Thickness, packet.Fade, packet.EntityId);
+                break;
+            case RenderPacket::Primitive::Ellipse:
+                Renderer2D::DrawEllipse(packet.Transform, packet.AxisRatio, packet.Color, packet.Thickness, packet.Fade, packet.EntityId);
+                break;
             }
         }
 
@@ -531,9 +1065,9 @@ case ScriptEngine::id: { type value; field.second->GetValue(value); dstFields.at
         auto first = hierarchy.FirstChild;
         auto child = first;
         do {
-            if (!child) break;
-            auto next = GetComponent<HierarchyComponent>(m_Entities[child]).NextSibling;
-            Destroy(m_Entities[child]);
+            if (child == entt::null) break;
+            auto next = GetComponent<HierarchyComponent>(child).NextSibling;
+            Destroy(child);
             child = next;
         } while (child != first);
     }
@@ -576,6 +1110,18 @@ case ScriptEngine::id: { type value; field.second->GetValue(value); dstFields.at
     }
 
 
+    void Scene::OnRenderComponentChange(entt::registry&, entt::entity entity)
+    {
+        m_SpatialDirty.push_back(entity);
+    }
+
+
+    void Scene::OnSpatialProxyDestruction(entt::registry&, entt::entity entity)
+    {
+        m_SpatialIndex.Remove(m_Registry.get<SpatialProxy>(entity).Node);
+    }
+
+
     /// <summary>
     /// Attach an entity (and its children) to the hierarchy tree as a child of the specified parent.
     /// </summary>
@@ -583,28 +1129,30 @@ case ScriptEngine::id: { type value; field.second->GetValue(value); dstFields.at
     /// <param name="parent"></param>
     void Scene::HierarchyConnect(entt::entity entity, entt::entity parent)
     {
-        auto& id = GetComponent<IDComponent>(entity);
         auto& hierarchy = GetComponent<HierarchyComponent>(entity);
-        auto& parentId = GetComponent<IDComponent>(parent);
         auto& parentHierarchy = GetComponent<HierarchyComponent>(parent);
 
-        LV_CORE_ASSERT(hierarchy.Parent == UUID::Null && hierarchy.NextSibling == UUID::Null && hierarchy.PrevSibling == UUID::Null, "Hierarchy component has not been disconnected!");
+        LV_CORE_ASSERT(hierarchy.Parent == entt::null && hierarchy.NextSibling == entt::null && hierarchy.PrevSibling == entt::null, "Hierarchy component has not been disconnected!");
+
+        if (auto tc = m_Registry.try_get<TransformComponent>(entity)) {
+            tc->WorldNeedCompute = true; /* world transform now depends on the new parent */
+        }
 
         // Connect to parent
-        hierarchy.Parent = parentId;
-        if (parentHierarchy.FirstChild == UUID::Null)
+        hierarchy.Parent = parent;
+        if (parentHierarchy.FirstChild == entt::null)
         {
-            parentHierarchy.FirstChild = id;
-            hierarchy.NextSibling = hierarchy.PrevSibling = id;
+            parentHierarchy.FirstChild = entity;
+            hierarchy.NextSibling = hierarchy.PrevSibling = entity;
         }
         else
         {
             // Connect to siblings
-            auto& nextHierarchy = GetComponent<HierarchyComponent>(m_Entities[parentHierarchy.FirstChild]);
-            auto& prevHierarchy = GetComponent<HierarchyComponent>(m_Entities[nextHierarchy.PrevSibling]);
+            auto& nextHierarchy = GetComponent<HierarchyComponent>(parentHierarchy.FirstChild);
+            auto& prevHierarchy = GetComponent<HierarchyComponent>(nextHierarchy.PrevSibling);
             hierarchy.NextSibling = parentHierarchy.FirstChild;
             hierarchy.PrevSibling = nextHierarchy.PrevSibling;
-            nextHierarchy.PrevSibling = prevHierarchy.NextSibling = id;
+            nextHierarchy.PrevSibling = prevHierarchy.NextSibling = entity;
         }
     }
 
@@ -615,28 +1163,27 @@ case ScriptEngine::id: { type value; field.second->GetValue(value); dstFields.at
     /// </summary>
     void Scene::HierarchyDisconnect(entt::entity entity)
     {
-        auto& id = GetComponent<IDComponent>(entity);
         auto& hierarchy = GetComponent<HierarchyComponent>(entity);
 
-        LV_CORE_ASSERT(hierarchy.Parent != UUID::Null, "Hierarchy component has not been connected!");
+        LV_CORE_ASSERT(hierarchy.Parent != entt::null, "Hierarchy component has not been connected!");
 
         // Disconnect from parent
-        auto& parentHierarchy = GetComponent<HierarchyComponent>(m_Entities[hierarchy.Parent]);
-        if (parentHierarchy.FirstChild == id)
+        auto& parentHierarchy = GetComponent<HierarchyComponent>(hierarchy.Parent);
+        if (parentHierarchy.FirstChild == entity)
         {
-            if (hierarchy.NextSibling == id) {
-                parentHierarchy.FirstChild = UUID::Null;
+            if (hierarchy.NextSibling == entity) {
+                parentHierarchy.FirstChild = entt::null;
             }
             else {
                 parentHierarchy.FirstChild = hierarchy.NextSibling;
             }
         }
-        hierarchy.Parent = UUID::Null;
+        hierarchy.Parent = entt::null;
         // Disconnect from siblings
-        auto& nextHierarchy = GetComponent<HierarchyComponent>(m_Entities[hierarchy.NextSibling]);
-        auto& prevHierarchy = GetComponent<HierarchyComponent>(m_Entities[hierarchy.PrevSibling]);
+        auto& nextHierarchy = GetComponent<HierarchyComponent>(hierarchy.NextSibling);
+        auto& prevHierarchy = GetComponent<HierarchyComponent>(hierarchy.PrevSibling);
         nextHierarchy.PrevSibling = hierarchy.PrevSibling;
         prevHierarchy.NextSibling = hierarchy.NextSibling;
-        hierarchy.PrevSibling = hierarchy.NextSibling = UUID::Null;
+        hierarchy.PrevSibling = hierarchy.NextSibling = entt::null;
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Components.h"
+#include "Prefab.h"
 
 #include <entt.hpp>
 #include <Core/Timestep.h>
@@ -8,6 +9,11 @@
 #include <Events/Event.h>
 #include <Events/ApplicationEvent.h>
 #include <Renderer/EditorCamera.h>
+#include <Structures/RadixSort.h>
+#include <Structures/AabbTree.h>
+#include <Structures/FlatHashMap.h>
+
+#include <span>
 
 
 namespace Limnova
@@ -32,6 +38,22 @@ namespace Limnova
         virtual Entity DuplicateEntity(Entity entity);
         void DestroyEntity(Entity entity);
 
+        /* Batch creation/destruction - see definitions */
+        virtual std::vector<Entity> CreateEntities(size_t count, UUID prototype = UUID::Null, UUID parent = UUID::Null);
+        void DestroyEntities(std::span<const Entity> entities);
+
+        /* Prefab instancing - instances share the prefab's renderer components (see Prefab) */
+        virtual std::vector<Entity> InstantiatePrefab(const Ref<Prefab>& prefab, size_t count, UUID parent = UUID::Null);
+
+        /// <summary> The entity's own renderer component, or its prefab's if it is a prefab instance without one of its own - nullptr if neither </summary>
+        template<typename TRenderer>
+        const TRenderer* TryGetRenderer(entt::entity entity)
+        {
+            if (auto* renderer = m_Registry.try_get<TRenderer>(entity)) return renderer;
+            if (auto* instance = m_Registry.try_get<PrefabComponent>(entity)) return instance->Source->TryGetRenderer<TRenderer>();
+            return nullptr;
+        }
+
         bool IsEntity(UUID uuid);
         Entity GetEntity(UUID uuid);
 
@@ -63,6 +85,14 @@ namespace Limnova
         size_t GetChildren(Entity parent, std::vector<Entity>& children);
         size_t GetTree(Entity root, std::vector<Entity>& tree);
 
+        void UpdateWorldTransforms();
+
+        /* Spatial queries - answered from a bounding-volume hierarchy over the bounds of rendered entities (entities with a transform and
+         * any renderer component), which is kept up to date by UpdateWorldTransforms() */
+        Entity RaycastEntity(const Vector3& origin, const Vector3& direction, float maxDistance = std::numeric_limits<float>::max());
+        void QueryBox(const Aabb& box, std::vector<Entity>& results);
+        void QueryRadius(const Vector3& center, float radius, std::vector<Entity>& results);
+
         virtual void OnStartRuntime();
         virtual void OnUpdateRuntime(Timestep dT);
         virtual void OnUpdateEditor(Timestep dT);
@@ -77,6 +107,49 @@ namespace Limnova
         //void RenderComponent(const T& component) { /* Do nothing by default */ }
 
         void RenderScene(Camera& camera, const Quaternion& cameraOrientation);
+    private:
+        /// <summary> One primitive extracted from the registry by RenderScene(), submitted to Renderer2D in sort-key order </summary>
+        struct RenderPacket
+        {
+            enum class Primitive : uint8_t { Quad = 0, Circle, Ellipse };
+
+            Matrix4 Transform;
+            Vector4 Color;
+            float Thickness = 1.f, Fade = 0.f, AxisRatio = 1.f;
+            int EntityId = -1;
+            Primitive Type = Primitive::Quad;
+            bool Culled = false;
+        };
+
+        static uint64_t RenderSortKey(uint8_t layer, RenderPacket::Primitive type, uint16_t texture, float depth);
+        void ExtractRenderPackets(Camera& camera, const Quaternion& cameraOrientation);
+
+        /// <summary>
+        /// Cached group of a renderer component with TransformComponent. Each group owns its renderer component pool, so the renderer
+        /// components of entities which also have a transform are packed at the front of the pool, and iteration does not probe other pools.
+        /// The groups are created by the constructor and kept by the registry - later calls only look them up (EnTT group handles cannot
+        /// be reassigned, so they are not stored as members).
+        /// </summary>
+        template<typename TRenderer>
+        auto RendererGroup() { return m_Registry.group<TRenderer>(entt::get<TransformComponent>); }
+
+        std::vector<RenderPacket> m_RenderPackets;
+        std::vector<SortKeyIndex> m_RenderKeys, m_RenderKeysScratch;
+        std::vector<entt::entity> m_RenderExtractEntities, m_RenderPrefabEntities;
+    private:
+        /// <summary> Attached to entities which have a leaf in the spatial index </summary>
+        struct SpatialProxy
+        {
+            int32_t Node = AabbTree<entt::entity>::kNull;
+        };
+
+        void UpdateSpatialIndex();
+        Vector3 GetRenderBoundingSphere(entt::entity entity, float& radius);
+
+        AabbTree<entt::entity> m_SpatialIndex;
+        std::vector<entt::entity> m_SpatialDirty; /* Entities whose bounds or renderability may have changed since the last UpdateSpatialIndex() */
+        std::vector<uint8_t> m_WorldDirtyPaths; /* UpdateWorldTransforms() scratch, by entity index: whether any entity on the path from the root is dirty */
+        std::vector<entt::entity> m_WorldDirtyWalk; /* UpdateWorldTransforms() scratch */
     private:
         /* Events */
         bool OnWindowResize(WindowResizeEvent& e);
@@ -86,6 +159,8 @@ namespace Limnova
         void OnHierarchyComponentDestruction(entt::registry&, entt::entity);
         void OnCameraComponentConstruction(entt::registry&, entt::entity);
         void OnCameraComponentDestruction(entt::registry&, entt::entity);
+        void OnRenderComponentChange(entt::registry&, entt::entity);
+        void OnSpatialProxyDestruction(entt::registry&, entt::entity);
 
     protected:
         /* Helpers */
@@ -103,18 +178,33 @@ namespace Limnova
             }
         }*/
 
+        /// <summary>
+        /// Copies a whole component pool from a source registry whose entity identifiers exist unchanged in this registry (see CloneEntities()).
+        /// Runs of entities which do not have the component in this registry are inserted in bulk - components of entities which already
+        /// have it (the root's, created by the constructor) are assigned in place.
+        /// </summary>
         template<typename T>
-        void CopyAllOfComponent(entt::registry& src)
+        void CloneAllOfComponent(entt::registry& src)
         {
-            auto view = src.view<T>();
-            for (auto e : view)
+            auto& srcStorage = src.storage<T>();
+            auto& dstStorage = m_Registry.storage<T>();
+            auto& srcEntities = static_cast<const entt::sparse_set&>(srcStorage);
+            dstStorage.reserve(dstStorage.size() + srcStorage.size());
+
+            auto runFirst = srcEntities.begin();
+            auto runFrom = srcStorage.cbegin();
+            auto component = srcStorage.cbegin();
+            for (auto it = srcEntities.begin(); it != srcEntities.end(); ++it, ++component)
             {
-                LV_CORE_ASSERT(src.all_of<IDComponent>(e), "All entities must have UUID!");
-                UUID uuid = src.get<IDComponent>(e).ID;
-                const T& srcComponent = src.get<T>(e);
-                LV_CORE_ASSERT(m_Entities.find(uuid) != m_Entities.end(), "Could not find entity with matching ID in the destination scene!");
-                m_Registry.emplace_or_replace<T>(m_Entities.at(uuid), srcComponent);
+                LV_CORE_ASSERT(m_Registry.valid(*it), "Source entity does not exist in the destination scene!");
+                if (!dstStorage.contains(*it)) continue;
+
+                m_Registry.insert<T>(runFirst, it, runFrom);
+                dstStorage.get(*it) = *component;
+                runFirst = std::next(it);
+                runFrom = std::next(component);
             }
+            m_Registry.insert<T>(runFirst, srcEntities.end(), runFrom);
         }
 
         template<typename T>
@@ -125,8 +215,43 @@ namespace Limnova
             }
         }
 
+        /// <summary> Adds a copy of the source entity's component, if it has one, to each of the destination entities in one insertion </summary>
+        template<typename T>
+        void CloneComponentToEntities(entt::entity src, const std::vector<entt::entity>& dst)
+        {
+            if (!m_Registry.all_of<T>(src)) return;
+            T component = m_Registry.get<T>(src); /* copied - the insertion may reallocate the pool */
+            m_Registry.insert<T>(dst.begin(), dst.end(), component);
+        }
+
+        /// <summary>
+        /// Adds a copy of a renderer component (or PrefabComponent) to each of the destination entities in one insertion, with a single
+        /// spatial index notification for all of them
+        /// </summary>
+        template<typename TRenderer>
+        void InsertRendererToEntities(const std::vector<entt::entity>& dst, const TRenderer& component)
+        {
+            m_Registry.on_construct<TRenderer>().template disconnect<&Scene::OnRenderComponentChange>(this);
+            m_Registry.insert<TRenderer>(dst.begin(), dst.end(), component);
+            m_Registry.on_construct<TRenderer>().template connect<&Scene::OnRenderComponentChange>(this);
+            m_SpatialDirty.insert(m_SpatialDirty.end(), dst.begin(), dst.end());
+        }
+
+        template<typename TRenderer>
+        void CloneRendererToEntities(entt::entity src, const std::vector<entt::entity>& dst)
+        {
+            if (!m_Registry.all_of<TRenderer>(src)) return;
+            TRenderer component = m_Registry.get<TRenderer>(src); /* copied - the insertion may reallocate the pool */
+            InsertRendererToEntities<TRenderer>(dst, component);
+        }
+
+        void CreateBareEntities(std::vector<entt::entity>& created, UUID parent, const std::string& name, const TransformComponent& transform);
+        void AttachPrefab(const Ref<Prefab>& prefab, const std::vector<entt::entity>& instances);
+        void DuplicateScriptComponent(Entity dst, Entity src);
+
         void HierarchyConnect(entt::entity entity, entt::entity parent);
         void HierarchyDisconnect(entt::entity entity);
+        void CloneEntities(Scene& src);
 
         template<typename T>
         bool HasComponent(entt::entity entity) {
@@ -166,7 +291,7 @@ namespace Limnova
         }
     protected:
         entt::registry m_Registry;
-        std::unordered_map<UUID, entt::entity> m_Entities;
+        FlatHashMap<UUID, entt::entity, IdentityHash> m_Entities;
 
         UUID m_Root = UUID::Null; /* Scene hierarchy root entity */
         UUID m_ActiveCamera = UUID::Null;
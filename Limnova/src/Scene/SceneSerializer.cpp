@@ -353,7 +353,8 @@ case ScriptEngine::id: { type value;
             out << YAML::BeginMap; // HierarchyComponent
 
             auto& hc = entity.GetComponent<HierarchyComponent>();
-            LV_YAML_SERIALIZE_NODE(out, "Parent", (uint64_t)hc.Parent);
+            UUID parentId = hc.Parent == entt::null ? UUID::Null : Entity{ hc.Parent, scene }.GetUUID();
+            LV_YAML_SERIALIZE_NODE(out, "Parent", (uint64_t)parentId);
 
             /* Only store the parent: all other relationships (siblings/children) are implicitly serialised
              * by those entities which share this entity's parent or have this entity as their parent */
@@ -437,63 +438,58 @@ case ScriptEngine::id: { type value;
             out << YAML::EndMap; // NativeScriptComponent
         }
 
-        if (entity.HasComponent<SpriteRendererComponent>())
+        if (auto src = scene->TryGetRenderer<SpriteRendererComponent>(entity.m_EnttId))
         {
             out << YAML::Key << "SpriteRendererComponent";
             out << YAML::BeginMap; // SpriteRendererComponent
 
-            auto& src = entity.GetComponent<SpriteRendererComponent>();
-            LV_YAML_SERIALIZE_NODE(out, "Color", src.Color);
+            LV_YAML_SERIALIZE_NODE(out, "Color", src->Color);
 
             out << YAML::EndMap; // SpriteRendererComponent
         }
 
-        if (entity.HasComponent<BillboardSpriteRendererComponent>())
+        if (auto bsrc = scene->TryGetRenderer<BillboardSpriteRendererComponent>(entity.m_EnttId))
         {
             out << YAML::Key << "BillboardSpriteRendererComponent";
             out << YAML::BeginMap; // BillboardSpriteRendererComponent
 
-            auto& bsrc = entity.GetComponent<BillboardSpriteRendererComponent>();
-            LV_YAML_SERIALIZE_NODE(out, "Color", bsrc.Color);
+            LV_YAML_SERIALIZE_NODE(out, "Color", bsrc->Color);
 
             out << YAML::EndMap; // BillboardSpriteRendererComponent
         }
 
-        if (entity.HasComponent<CircleRendererComponent>())
+        if (auto crc = scene->TryGetRenderer<CircleRendererComponent>(entity.m_EnttId))
         {
             out << YAML::Key << "CircleRendererComponent";
             out << YAML::BeginMap; // CircleRendererComponent
 
-            auto& crc = entity.GetComponent<CircleRendererComponent>();
-            LV_YAML_SERIALIZE_NODE(out, "Color",        crc.Color);
-            LV_YAML_SERIALIZE_NODE(out, "Thickness",    crc.Thickness);
-            LV_YAML_SERIALIZE_NODE(out, "Fade",         crc.Fade);
+            LV_YAML_SERIALIZE_NODE(out, "Color",        crc->Color);
+            LV_YAML_SERIALIZE_NODE(out, "Thickness",    crc->Thickness);
+            LV_YAML_SERIALIZE_NODE(out, "Fade",         crc->Fade);
 
             out << YAML::EndMap; // CircleRendererComponent
         }
 
-        if (entity.HasComponent<BillboardCircleRendererComponent>())
+        if (auto bcrc = scene->TryGetRenderer<BillboardCircleRendererComponent>(entity.m_EnttId))
         {
             out << YAML::Key << "BillboardCircleRendererComponent";
             out << YAML::BeginMap; // BillboardCircleRendererComponent
 
-            auto& bcrc = entity.GetComponent<BillboardCircleRendererComponent>();
-            LV_YAML_SERIALIZE_NODE(out, "Color",        bcrc.Color);
-            LV_YAML_SERIALIZE_NODE(out, "Thickness",    bcrc.Thickness);
-            LV_YAML_SERIALIZE_NODE(out, "Fade",         bcrc.Fade);
+            LV_YAML_SERIALIZE_NODE(out, "Color",        bcrc->Color);
+            LV_YAML_SERIALIZE_NODE(out, "Thickness",    bcrc->Thickness);
+            LV_YAML_SERIALIZE_NODE(out, "Fade",         bcrc->Fade);
 
             out << YAML::EndMap; // BillboardCircleRendererComponent
         }
 
-        if (entity.HasComponent<EllipseRendererComponent>())
+        if (auto erc = scene->TryGetRenderer<EllipseRendererComponent>(entity.m_EnttId))
         {
             out << YAML::Key << "EllipseRendererComponent";
             out << YAML::BeginMap; // EllipseRendererComponent
 
-            auto& erc = entity.GetComponent<EllipseRendererComponent>();
-            LV_YAML_SERIALIZE_NODE(out, "Color",        erc.Color);
-            LV_YAML_SERIALIZE_NODE(out, "Thickness",    erc.Thickness);
-            LV_YAML_SERIALIZE_NODE(out, "Fade",         erc.Fade);
+            LV_YAML_SERIALIZE_NODE(out, "Color",        erc->Color);
+            LV_YAML_SERIALIZE_NODE(out, "Thickness",    erc->Thickness);
+            LV_YAML_SERIALIZE_NODE(out, "Fade",         erc->Fade);
 
             out << YAML::EndMap; // EllipseRendererComponent
         }
@@ -524,7 +520,7 @@ case ScriptEngine::id: { type value;
             out << YAML::Key << "Mass"                  << YAML::Value << orbital.Object.GetState().Mass;
             if (!isRootEntity)
             {
-                LV_YAML_SERIALIZE_NODE(out, "Position", orbital.Object.GetState().Position);
+                LV_YAML_SERIALIZE_NODE(out, "Position", (Vector3)orbital.Object.GetState().Position);
                 LV_YAML_SERIALIZE_NODE(out, "Velocity", orbital.Object.GetState().Velocity);
             }
             if (orbital.Object.IsDynamic())
@@ -548,7 +544,7 @@ case ScriptEngine::id: { type value;
     }
 
 
-    void SceneSerializer::DeserializeEntity(Scene* scene, YAML::Node entityNode)
+    void SceneSerializer::DeserializeEntity(Scene* scene, YAML::Node entityNode, bool isOrbitalEntityCreated)
     {
         uint64_t uuid = UUID::Null;
         LV_YAML_DESERIALIZE_NODE(entityNode, "Entity", uint64_t, uuid);
@@ -571,6 +567,9 @@ case ScriptEngine::id: { type value;
             entity = scene->GetRoot();
             scene->SetRootId(uuid);
         }
+        else if (isOrbitalEntityCreated) {
+            entity = scene->GetEntity(uuid);
+        }
         else {
             entity = scene->CreateEntityFromUUID(uuid, name, parentId);
         }
@@ -692,42 +691,47 @@ case ScriptEngine::id: { type value;
         {
             auto& ohc = entity.GetComponent<OrbitalHierarchyComponent>();
             LV_YAML_DESERIALIZE_NODE(ohcNode, "AbsoluteScale",  Vector3d,   ohc.AbsoluteScale               );
-            LV_YAML_DESERIALIZE_NODE(ohcNode, "LocalSpace",     int,        ohc.LocalSpaceRelativeToParent  );
+            if (!isOrbitalEntityCreated) { /* already set - and possibly changed by the physics objects' preparation */
+                LV_YAML_DESERIALIZE_NODE(ohcNode, "LocalSpace", int,        ohc.LocalSpaceRelativeToParent  );
+            }
         }
 
         if (auto oNode = entityNode["OrbitalComponent"])
         {
-            auto& oc = isRootEntity
+            auto& oc = isRootEntity || isOrbitalEntityCreated
                 ? entity.GetComponent<OrbitalComponent>()
                 : entity.AddComponent<OrbitalComponent>();
 
-            if (!isRootEntity)
+            if (!isOrbitalEntityCreated)
             {
-                LV_YAML_DESERIALIZE_NODE_WITH_SETTER(oNode, "Position", Vector3,    oc.Object.SetPosition);
-                LV_YAML_DESERIALIZE_NODE_WITH_SETTER(oNode, "Velocity", Vector3d,   oc.Object.SetVelocity);
-            }
-            oc.Object.SetMass(             oNode["Mass"].as<double>());
+                if (!isRootEntity)
+                {
+                    LV_YAML_DESERIALIZE_NODE_WITH_SETTER(oNode, "Position", Vector3,    oc.Object.SetPosition);
+                    LV_YAML_DESERIALIZE_NODE_WITH_SETTER(oNode, "Velocity", Vector3d,   oc.Object.SetVelocity);
+                }
+                oc.Object.SetMass(             oNode["Mass"].as<double>());
 
-            if (auto contAcceleration = oNode["ContAcceleration"])
-            {
-                oc.Object.SetDynamic(true);
-                oc.Object.SetContinuousAcceleration(contAcceleration.as<Vector3d>());
-            }
+                if (auto contAcceleration = oNode["ContAcceleration"])
+                {
+                    oc.Object.SetDynamic(true);
+                    oc.Object.SetContinuousAcceleration(contAcceleration.as<Vector3d>());
+                }
 
-            auto localSpaceRadiiNode = oNode["LocalSpaceRadii"];
-            for (size_t i = 0; i < localSpaceRadiiNode.size(); i++) {
-                oc.Object.AddLocalSpace(localSpaceRadiiNode[i].as<float>());
+                auto localSpaceRadiiNode = oNode["LocalSpaceRadii"];
+                for (size_t i = 0; i < localSpaceRadiiNode.size(); i++) {
+                    oc.Object.AddLocalSpace(localSpaceRadiiNode[i].as<float>());
+                }
+                oc.LocalSpaces.clear();
+                oc.Object.GetLocalSpaces(oc.LocalSpaces);
             }
-            oc.LocalSpaces.clear();
-            oc.Object.GetLocalSpaces(oc.LocalSpaces);
 
             LV_YAML_DESERIALIZE_NODE(oNode, "UIColor",              Vector3,   oc.UIColor);
             LV_YAML_DESERIALIZE_NODE(oNode, "Albedo",               float,     oc.Albedo);
             LV_YAML_DESERIALIZE_NODE(oNode, "ShowMajorMinorAxes",   bool,      oc.ShowMajorMinorAxes);
             LV_YAML_DESERIALIZE_NODE(oNode, "ShowNormal",           bool,      oc.ShowNormal);
 
-            if (!isRootEntity) {
-                ((OrbitalScene*)scene)->m_PhysicsToEnttIds.insert({ oc.Object.Id(), entity.m_EnttId });
+            if (!isRootEntity && !isOrbitalEntityCreated) {
+                ((OrbitalScene*)scene)->MapPhysicsToEntity(oc.Object.Id(), entity.m_EnttId);
             }
         }
 
@@ -973,6 +977,7 @@ case ScriptEngine::id: { type value;
         LV_YAML_SERIALIZE_NODE(out, "OrbitFade",                 scene->m_OrbitFade);
         LV_YAML_SERIALIZE_NODE(out, "OrbitAlpha",                scene->m_OrbitAlpha);
         LV_YAML_SERIALIZE_NODE(out, "OrbitPointRadius",          scene->m_OrbitPointRadius);
+        LV_YAML_SERIALIZE_NODE(out, "OrbitRecomputeBudget",      scene->m_OrbitRecomputeBudget);
         LV_YAML_SERIALIZE_NODE(out, "ShowReferenceAxes",         scene->m_ShowReferenceAxes);
         LV_YAML_SERIALIZE_NODE(out, "ReferenceAxisColor",        scene->m_ReferenceAxisColor);
         LV_YAML_SERIALIZE_NODE(out, "ReferenceAxisLength",       scene->m_ReferenceAxisLength);
@@ -980,6 +985,14 @@ case ScriptEngine::id: { type value;
         LV_YAML_SERIALIZE_NODE(out, "ReferenceAxisArrowSize",    scene->m_ReferenceAxisArrowSize);
         LV_YAML_SERIALIZE_NODE(out, "PerifocalAxisThickness",    scene->m_PerifocalAxisThickness);
         LV_YAML_SERIALIZE_NODE(out, "PerifocalAxisArrowSize",    scene->m_PerifocalAxisArrowSize);
+        LV_YAML_SERIALIZE_NODE(out, "SuperiorLevels",            scene->m_SuperiorLevels);
+        LV_YAML_SERIALIZE_NODE(out, "InferiorLevels",            scene->m_InferiorLevels);
+        LV_YAML_SERIALIZE_NODE(out, "ImpostorRefreshFrames",     scene->m_ImpostorRefreshFrames);
+        LV_YAML_SERIALIZE_NODE(out, "ImpostorRadius",            scene->m_ImpostorRadius);
+        LV_YAML_SERIALIZE_NODE(out, "ImpostorMaxDistance",       scene->m_ImpostorMaxDistance);
+        LV_YAML_SERIALIZE_NODE(out, "ImpostorAlpha",             scene->m_ImpostorAlpha);
+
+        LV_YAML_SERIALIZE_NODE(out, "MinScreenSize",             scene->m_MinScreenSize);
 
         LV_YAML_SERIALIZE_NODE(out, "TrackingEntity",           (uint64_t)(scene->m_TrackingEntity));
         LV_YAML_SERIALIZE_NODE(out, "RelativeViewSpace",        scene->m_RelativeViewSpace);
@@ -1041,6 +1054,7 @@ case ScriptEngine::id: { type value;
         LV_YAML_DESERIALIZE_NODE(data, "OrbitFade",                  float,      scene->m_OrbitFade);
         LV_YAML_DESERIALIZE_NODE(data, "OrbitAlpha",                 float,      scene->m_OrbitAlpha);
         LV_YAML_DESERIALIZE_NODE(data, "OrbitPointRadius",           float,      scene->m_OrbitPointRadius);
+        LV_YAML_DESERIALIZE_NODE(data, "OrbitRecomputeBudget",       int,        scene->m_OrbitRecomputeBudget);
         LV_YAML_DESERIALIZE_NODE(data, "ShowReferenceAxes",          bool,       scene->m_ShowReferenceAxes);
         LV_YAML_DESERIALIZE_NODE(data, "ReferenceAxisColor",         Vector4,    scene->m_ReferenceAxisColor);
         LV_YAML_DESERIALIZE_NODE(data, "ReferenceAxisLength",        float,      scene->m_ReferenceAxisLength);
@@ -1048,6 +1062,14 @@ case ScriptEngine::id: { type value;
         LV_YAML_DESERIALIZE_NODE(data, "ReferenceAxisArrowSize",     float,      scene->m_ReferenceAxisArrowSize);
         LV_YAML_DESERIALIZE_NODE(data, "PerifocalAxisThickness",     float,      scene->m_PerifocalAxisThickness);
         LV_YAML_DESERIALIZE_NODE(data, "PerifocalAxisArrowSize",     float,      scene->m_PerifocalAxisArrowSize);
+        LV_YAML_DESERIALIZE_NODE(data, "SuperiorLevels",             int,        scene->m_SuperiorLevels);
+        LV_YAML_DESERIALIZE_NODE(data, "InferiorLevels",             int,        scene->m_InferiorLevels);
+        LV_YAML_DESERIALIZE_NODE(data, "ImpostorRefreshFrames",      int,        scene->m_ImpostorRefreshFrames);
+        LV_YAML_DESERIALIZE_NODE(data, "ImpostorRadius",             float,      scene->m_ImpostorRadius);
+        LV_YAML_DESERIALIZE_NODE(data, "ImpostorMaxDistance",        float,      scene->m_ImpostorMaxDistance);
+        LV_YAML_DESERIALIZE_NODE(data, "ImpostorAlpha",              float,      scene->m_ImpostorAlpha);
+
+        LV_YAML_DESERIALIZE_NODE(data, "MinScreenSize",              float,      scene->m_MinScreenSize);
 
         scene->ScriptEngineUseContext();
         scene->m_PhysicsContext = OrbitalPhysics::Context(); /* reset physics context */
@@ -1057,8 +1079,81 @@ case ScriptEngine::id: { type value;
 
         // Entities
         if (auto entitiesNode = data["Entities"]) {
-            for (auto entityNode : entitiesNode) {
-                DeserializeEntity(scene, entityNode);
+            /* Non-root orbital entities are created together with OrbitalScene::CreateOrbitalEntities(), so their physics objects
+             * are prepared and queued as one batch - entities are serialised after their parents, so each orbital parent is either
+             * the root or an earlier entity in the batch. Their other components are deserialised with the remaining entities. */
+            std::vector<OrbitalScene::OrbitalEntityDesc> orbitalDescs;
+            std::unordered_map<UUID, int64_t> orbitalDescIndices;
+            UUID rootId = UUID::Null;
+            for (auto entityNode : entitiesNode)
+            {
+                UUID uuid = UUID::Null;
+                LV_YAML_DESERIALIZE_NODE(entityNode, "Entity", uint64_t, uuid);
+
+                UUID parentId = UUID::Null;
+                if (auto hcNode = entityNode["HierarchyComponent"])
+                    LV_YAML_DESERIALIZE_NODE(hcNode, "Parent", uint64_t, parentId);
+
+                if (parentId == UUID::Null) {
+                    DeserializeEntity(scene, entityNode); /* root must be complete (mass, local spaces) before the batch is created */
+                    rootId = uuid;
+                    continue;
+                }
+
+                auto oNode = entityNode["OrbitalComponent"];
+                if (!oNode) continue;
+
+                auto parentIt = orbitalDescIndices.find(parentId);
+                if (parentId != rootId && parentIt == orbitalDescIndices.end()) continue; /* non-orbital parent: created individually */
+
+                orbitalDescIndices[uuid] = orbitalDescs.size();
+                auto& desc = orbitalDescs.emplace_back();
+                desc.Id = uuid;
+                if (auto tagComponent = entityNode["TagComponent"])
+                    LV_YAML_DESERIALIZE_NODE(tagComponent, "Tag", std::string, desc.Name);
+                if (parentIt != orbitalDescIndices.end()) desc.ParentIndex = parentIt->second;
+                else desc.Parent = parentId;
+
+                if (auto ohcNode = entityNode["OrbitalHierarchyComponent"])
+                    LV_YAML_DESERIALIZE_NODE(ohcNode, "LocalSpace", int, desc.LocalSpaceRelativeToParent);
+                desc.LocalSpaceRelativeToParent = std::max(desc.LocalSpaceRelativeToParent, 0);
+
+                LV_YAML_DESERIALIZE_NODE(oNode, "Position", Vector3,    desc.Position);
+                LV_YAML_DESERIALIZE_NODE(oNode, "Velocity", Vector3d,   desc.Velocity);
+                desc.Mass = oNode["Mass"].as<double>();
+                if (auto contAcceleration = oNode["ContAcceleration"])
+                {
+                    desc.Dynamic = true;
+                    desc.ContAcceleration = contAcceleration.as<Vector3d>();
+                }
+                auto localSpaceRadiiNode = oNode["LocalSpaceRadii"];
+                for (size_t i = 0; i < localSpaceRadiiNode.size(); i++) {
+                    desc.LocalSpaceRadii.push_back(localSpaceRadiiNode[i].as<float>());
+                }
+            }
+            scene->CreateOrbitalEntities(orbitalDescs);
+
+            for (auto entityNode : entitiesNode)
+            {
+                UUID uuid = UUID::Null;
+                LV_YAML_DESERIALIZE_NODE(entityNode, "Entity", uint64_t, uuid);
+                if (uuid == rootId) continue;
+
+                DeserializeEntity(scene, entityNode, orbitalDescIndices.contains(uuid));
+            }
+
+            /* Batch creation attaches the orbital entities to their parents before the others - reattach every entity in file order
+             * so each parent's children keep the serialised sibling order */
+            for (auto entityNode : entitiesNode)
+            {
+                UUID uuid = UUID::Null;
+                LV_YAML_DESERIALIZE_NODE(entityNode, "Entity", uint64_t, uuid);
+                if (uuid == rootId) continue;
+
+                entt::entity enttId = scene->m_Entities[uuid];
+                entt::entity parentEnttId = scene->GetComponent<HierarchyComponent>(enttId).Parent;
+                scene->HierarchyDisconnect(enttId);
+                scene->HierarchyConnect(enttId, parentEnttId);
             }
         }
 
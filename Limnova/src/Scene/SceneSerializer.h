@@ -26,7 +26,7 @@ namespace Limnova
         static bool DeserializeRuntime(OrbitalScene* scene, const std::string& filepath);
     private:
         static void SerializeEntity(Scene* scene, YAML::Emitter& out, Entity entity);
-        static void DeserializeEntity(Scene* scene, YAML::Node entityNode);
+        static void DeserializeEntity(Scene* scene, YAML::Node entityNode, bool isOrbitalEntityCreated = false); /* isOrbitalEntityCreated: entity and its physics object were created by OrbitalScene::CreateOrbitalEntities() */
     };
 
 }
@@ -76,6 +76,7 @@ namespace Limnova
         // testing
         RegisterScriptClass<EntityScriptClass>("Player");
         RegisterScriptClass<EntityScriptClass>("Missile");
+        RegisterScriptClass<EntityScriptClass>("LookupBenchmark");
     }
 
     // -----------------------------------------------------------------------------------------------------------------------------
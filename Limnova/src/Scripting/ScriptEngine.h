@@ -5,6 +5,7 @@
 
 #include "Core/UUID.h"
 #include "Core/Timestep.h"
+#include "Structures/FlatHashMap.h"
 
 #include "Math/Math.h"
 
@@ -354,7 +355,7 @@ namespace Limnova
 
         struct Context
         {
-            std::unordered_map<UUID, size_t> EntityScriptIndices = {};
+            FlatHashMap<UUID, size_t, IdentityHash> EntityScriptIndices = {};
             std::unordered_set<size_t> FreeScriptIndices = {};
             std::vector<Ref<EntityScriptInstance>> EntityScriptInstances = {};
 
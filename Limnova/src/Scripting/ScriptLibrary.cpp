@@ -162,7 +162,7 @@ namespace Limnova
                     OrbitalPhysics::SolveMissileIntercept(missileObjectNode, targetObjectNode, localAcceleration, localTolerance,
                         localIntercept, *pTimeToIntercept, maxIterations);
 
-                    *pIntercept = localIntercept - missileObjectNode.GetState().Position;
+                    *pIntercept = localIntercept - (Vector3)missileObjectNode.GetState().Position;
                 }
             }
         }
@@ -0,0 +1,410 @@
+#pragma once
+
+#include <Math/Math.h>
+
+
+namespace Limnova
+{
+
+    /// <summary> Axis-aligned bounding box </summary>
+    struct Aabb
+    {
+        Vector3 Min = { 0.f }, Max = { 0.f };
+
+        static Aabb FromSphere(const Vector3& center, float radius)
+        {
+            return { { center.x - radius, center.y - radius, center.z - radius }, { center.x + radius, center.y + radius, center.z + radius } };
+        }
+        static Aabb Combine(const Aabb& a, const Aabb& b)
+        {
+            return {
+                { std::min(a.Min.x, b.Min.x), std::min(a.Min.y, b.Min.y), std::min(a.Min.z, b.Min.z) },
+                { std::max(a.Max.x, b.Max.x), std::max(a.Max.y, b.Max.y), std::max(a.Max.z, b.Max.z) }
+            };
+        }
+
+        bool Contains(const Aabb& other) const
+        {
+            return Min.x <= other.Min.x && Min.y <= other.Min.y && Min.z <= other.Min.z &&
+                other.Max.x <= Max.x && other.Max.y <= Max.y && other.Max.z <= Max.z;
+        }
+        bool Overlaps(const Aabb& other) const
+        {
+            return Min.x <= other.Max.x && Min.y <= other.Max.y && Min.z <= other.Max.z &&
+                other.Min.x <= Max.x && other.Min.y <= Max.y && other.Min.z <= Max.z;
+        }
+        bool OverlapsSphere(const Vector3& center, float radius) const
+        {
+            float dx = std::max({ Min.x - center.x, 0.f, center.x - Max.x });
+            float dy = std::max({ Min.y - center.y, 0.f, center.y - Max.y });
+            float dz = std::max({ Min.z - center.z, 0.f, center.z - Max.z });
+            return dx * dx + dy * dy + dz * dz <= radius * radius;
+        }
+
+        /// <summary> Slab test - returns the ray distance at which the ray enters the box, or a negative value if it misses within maxDistance </summary>
+        float RayEnter(const Vector3& origin, const Vector3& inverseDirection, float maxDistance) const
+        {
+            float t1 = (Min.x - origin.x) * inverseDirection.x, t2 = (Max.x - origin.x) * inverseDirection.x;
+            float tMin = std::min(t1, t2), tMax = std::max(t1, t2);
+            t1 = (Min.y - origin.y) * inverseDirection.y; t2 = (Max.y - origin.y) * inverseDirection.y;
+            tMin = std::max(tMin, std::min(t1, t2)); tMax = std::min(tMax, std::max(t1, t2));
+            t1 = (Min.z - origin.z) * inverseDirection.z; t2 = (Max.z - origin.z) * inverseDirection.z;
+            tMin = std::max(tMin, std::min(t1, t2)); tMax = std::min(tMax, std::max(t1, t2));
+
+            tMin = std::max(tMin, 0.f);
+            return (tMin <= tMax && tMin <= maxDistance) ? tMin : -1.f;
+        }
+
+        /// <summary> Half the surface area - used as the insertion cost heuristic </summary>
+        float HalfArea() const
+        {
+            float dx = Max.x - Min.x, dy = Max.y - Min.y, dz = Max.z - Min.z;
+            return dx * dy + dy * dz + dz * dx;
+        }
+    };
+
+
+    /// <summary>
+    /// Dynamic bounding-volume hierarchy of axis-aligned boxes. Each leaf (proxy) stores a user value and a "fat" box - its bounds
+    /// enlarged by a margin - so that small movements do not change the tree. Leaves are inserted next to the sibling which minimises
+    /// the increase in surface area, and the tree is kept height-balanced by rotations as leaves are inserted and removed.
+    /// </summary>
+    template<typename T>
+    class AabbTree
+    {
+    public:
+        static constexpr int32_t kNull = -1;
+
+        /// <param name="marginFactor">Fraction of a proxy's largest extent added to each side of its fat box</param>
+        /// <param name="minMargin">Smallest margin added to each side of a proxy's fat box</param>
+        AabbTree(float marginFactor = 0.1f, float minMargin = 0.001f)
+            : m_MarginFactor(marginFactor), m_MinMargin(minMargin) {}
+
+        int32_t Insert(const Aabb& bounds, T userData)
+        {
+            int32_t proxy = AllocateNode();
+            m_Nodes[proxy].Bounds = Fatten(bounds);
+            m_Nodes[proxy].UserData = userData;
+            m_Nodes[proxy].Height = 0;
+            InsertLeaf(proxy);
+            m_NumLeaves++;
+            return proxy;
+        }
+
+        void Remove(int32_t proxy)
+        {
+            LV_CORE_ASSERT(proxy >= 0 && proxy < (int32_t)m_Nodes.size() && m_Nodes[proxy].IsLeaf(), "Invalid proxy!");
+            RemoveLeaf(proxy);
+            FreeNode(proxy);
+            m_NumLeaves--;
+        }
+
+        /// <summary> Updates a proxy's bounds - the tree is only changed if the new bounds leave the proxy's fat box </summary>
+        /// <returns>True if the proxy was reinserted</returns>
+        bool Move(int32_t proxy, const Aabb& bounds)
+        {
+            LV_CORE_ASSERT(proxy >= 0 && proxy < (int32_t)m_Nodes.size() && m_Nodes[proxy].IsLeaf(), "Invalid proxy!");
+            if (m_Nodes[proxy].Bounds.Contains(bounds)) {
+                /* Also refit if the fat box has become much larger than the bounds it wraps, so shrinking objects are not over-reported by queries */
+                Aabb fat = Fatten(bounds);
+                if (4.f * fat.HalfArea() >= m_Nodes[proxy].Bounds.HalfArea()) return false;
+            }
+            RemoveLeaf(proxy);
+            m_Nodes[proxy].Bounds = Fatten(bounds);
+            InsertLeaf(proxy);
+            return true;
+        }
+
+        void Clear()
+        {
+            m_Nodes.clear();
+            m_Root = kNull;
+            m_FreeList = kNull;
+            m_NumLeaves = 0;
+        }
+
+        T const& GetUserData(int32_t proxy) const { return m_Nodes[proxy].UserData; }
+        Aabb const& GetFatBounds(int32_t proxy) const { return m_Nodes[proxy].Bounds; }
+        size_t Size() const { return m_NumLeaves; }
+        int32_t GetHeight() const { return m_Root == kNull ? 0 : m_Nodes[m_Root].Height; }
+
+        /// <summary> Calls callback(proxy) for every proxy whose fat box overlaps the box - the callback returns false to stop the query </summary>
+        template<typename Callback>
+        void QueryAabb(const Aabb& box, Callback&& callback) const
+        {
+            Traverse([&](Aabb const& bounds) { return bounds.Overlaps(box); }, callback);
+        }
+
+        /// <summary> Calls callback(proxy) for every proxy whose fat box overlaps the sphere - the callback returns false to stop the query </summary>
+        template<typename Callback>
+        void QuerySphere(const Vector3& center, float radius, Callback&& callback) const
+        {
+            Traverse([&](Aabb const& bounds) { return bounds.OverlapsSphere(center, radius); }, callback);
+        }
+
+        /// <summary>
+        /// Calls callback(proxy, maxDistance) for every proxy whose fat box the ray enters within maxDistance. The callback returns the new
+        /// maximum distance: the distance of its hit to clip the ray there (finding the closest hit), maxDistance to continue unchanged,
+        /// or zero to stop the query.
+        /// </summary>
+        template<typename Callback>
+        void RayCast(const Vector3& origin, const Vector3& direction, float maxDistance, Callback&& callback) const
+        {
+            if (m_Root == kNull) return;
+
+            Vector3 inverseDirection = { 1.f / direction.x, 1.f / direction.y, 1.f / direction.z };
+            std::vector<int32_t> stack;
+            stack.reserve(64);
+            stack.push_back(m_Root);
+            while (!stack.empty())
+            {
+                int32_t index = stack.back();
+                stack.pop_back();
+
+                auto& node = m_Nodes[index];
+                if (node.Bounds.RayEnter(origin, inverseDirection, maxDistance) < 0.f) continue;
+
+                if (node.IsLeaf()) {
+                    maxDistance = callback(index, maxDistance);
+                    if (maxDistance <= 0.f) return;
+                }
+                else {
+                    stack.push_back(node.Child1);
+                    stack.push_back(node.Child2);
+                }
+            }
+        }
+    private:
+        struct Node
+        {
+            Aabb Bounds;
+            T UserData = {};
+            int32_t Parent = kNull;     /* Next free node, while in the free list */
+            int32_t Child1 = kNull, Child2 = kNull;
+            int32_t Height = -1;        /* Leaves are height 0, free nodes are -1 */
+
+            bool IsLeaf() const { return Child1 == kNull; }
+        };
+
+        std::vector<Node> m_Nodes;
+        int32_t m_Root = kNull;
+        int32_t m_FreeList = kNull;
+        size_t m_NumLeaves = 0;
+
+        float m_MarginFactor, m_MinMargin;
+    private:
+        Aabb Fatten(const Aabb& bounds) const
+        {
+            float extent = std::max({ bounds.Max.x - bounds.Min.x, bounds.Max.y - bounds.Min.y, bounds.Max.z - bounds.Min.z });
+            float margin = std::max(m_MarginFactor * extent, m_MinMargin);
+            return {
+                { bounds.Min.x - margin, bounds.Min.y - margin, bounds.Min.z - margin },
+                { bounds.Max.x + margin, bounds.Max.y + margin, bounds.Max.z + margin }
+            };
+        }
+
+        template<typename Test, typename Callback>
+        void Traverse(Test&& test, Callback& callback) const
+        {
+            if (m_Root == kNull) return;
+
+            std::vector<int32_t> stack;
+            stack.reserve(64);
+            stack.push_back(m_Root);
+            while (!stack.empty())
+            {
+                int32_t index = stack.back();
+                stack.pop_back();
+
+                auto& node = m_Nodes[index];
+                if (!test(node.Bounds)) continue;
+
+                if (node.IsLeaf()) {
+                    if (!callback(index)) return;
+                }
+                else {
+                    stack.push_back(node.Child1);
+                    stack.push_back(node.Child2);
+                }
+            }
+        }
+
+        int32_t AllocateNode()
+        {
+            if (m_FreeList == kNull) {
+                m_Nodes.emplace_back();
+                return (int32_t)m_Nodes.size() - 1;
+            }
+            int32_t index = m_FreeList;
+            m_FreeList = m_Nodes[index].Parent;
+            m_Nodes[index] = Node{};
+            return index;
+        }
+
+        void FreeNode(int32_t index)
+        {
+            m_Nodes[index].Parent = m_FreeList;
+            m_Nodes[index].Height = -1;
+            m_FreeList = index;
+        }
+
+        void InsertLeaf(int32_t leaf)
+        {
+            if (m_Root == kNull) {
+                m_Root = leaf;
+                m_Nodes[leaf].Parent = kNull;
+                return;
+            }
+
+            // Find the best sibling: descend while the cost of pairing with a child is lower than pairing with the current node
+            Aabb leafBounds = m_Nodes[leaf].Bounds;
+            int32_t index = m_Root;
+            while (!m_Nodes[index].IsLeaf())
+            {
+                auto& node = m_Nodes[index];
+                float area = node.Bounds.HalfArea();
+                float combinedArea = Aabb::Combine(node.Bounds, leafBounds).HalfArea();
+
+                float cost = 2.f * combinedArea;
+                float inheritanceCost = 2.f * (combinedArea - area); /* Minimum cost pushed onto the ancestors by descending */
+
+                auto childCost = [&](int32_t child) {
+                    auto& childBounds = m_Nodes[child].Bounds;
+                    float newArea = Aabb::Combine(leafBounds, childBounds).HalfArea();
+                    return (m_Nodes[child].IsLeaf() ? newArea : newArea - childBounds.HalfArea()) + inheritanceCost;
+                };
+                float cost1 = childCost(node.Child1);
+                float cost2 = childCost(node.Child2);
+
+                if (cost < cost1 && cost < cost2) break;
+                index = cost1 < cost2 ? node.Child1 : node.Child2;
+            }
+            int32_t sibling = index;
+
+            // Replace the sibling with a new parent of the sibling and the leaf
+            int32_t oldParent = m_Nodes[sibling].Parent;
+            int32_t newParent = AllocateNode();
+            m_Nodes[newParent].Parent = oldParent;
+            m_Nodes[newParent].Bounds = Aabb::Combine(leafBounds, m_Nodes[sibling].Bounds);
+            m_Nodes[newParent].Height = m_Nodes[sibling].Height + 1;
+            m_Nodes[newParent].Child1 = sibling;
+            m_Nodes[newParent].Child2 = leaf;
+            m_Nodes[sibling].Parent = newParent;
+            m_Nodes[leaf].Parent = newParent;
+
+            if (oldParent == kNull) {
+                m_Root = newParent;
+            }
+            else if (m_Nodes[oldParent].Child1 == sibling) {
+                m_Nodes[oldParent].Child1 = newParent;
+            }
+            else {
+                m_Nodes[oldParent].Child2 = newParent;
+            }
+
+            Refit(m_Nodes[leaf].Parent);
+        }
+
+        void RemoveLeaf(int32_t leaf)
+        {
+            if (leaf == m_Root) {
+                m_Root = kNull;
+                return;
+            }
+
+            int32_t parent = m_Nodes[leaf].Parent;
+            int32_t grandParent = m_Nodes[parent].Parent;
+            int32_t sibling = m_Nodes[parent].Child1 == leaf ? m_Nodes[parent].Child2 : m_Nodes[parent].Child1;
+
+            // Replace the parent with the sibling
+            m_Nodes[sibling].Parent = grandParent;
+            FreeNode(parent);
+            if (grandParent == kNull) {
+                m_Root = sibling;
+                return;
+            }
+            if (m_Nodes[grandParent].Child1 == parent) {
+                m_Nodes[grandParent].Child1 = sibling;
+            }
+            else {
+                m_Nodes[grandParent].Child2 = sibling;
+            }
+            Refit(grandParent);
+        }
+
+        /// <summary> Rebalances and recomputes bounds and heights from the given node up to the root </summary>
+        void Refit(int32_t index)
+        {
+            while (index != kNull)
+            {
+                index = Balance(index);
+
+                auto& node = m_Nodes[index];
+                node.Height = 1 + std::max(m_Nodes[node.Child1].Height, m_Nodes[node.Child2].Height);
+                node.Bounds = Aabb::Combine(m_Nodes[node.Child1].Bounds, m_Nodes[node.Child2].Bounds);
+
+                index = node.Parent;
+            }
+        }
+
+        /// <summary> If the subtree at iA is imbalanced, rotates its taller child up and returns the subtree's new root </summary>
+        int32_t Balance(int32_t iA)
+        {
+            Node& A = m_Nodes[iA];
+            if (A.IsLeaf() || A.Height < 2) return iA;
+
+            int32_t iB = A.Child1;
+            int32_t iC = A.Child2;
+
+            int32_t balance = m_Nodes[iC].Height - m_Nodes[iB].Height;
+            if (balance > 1) {
+                RotateUp(iA, iC, true);
+                return iC;
+            }
+            if (balance < -1) {
+                RotateUp(iA, iB, false);
+                return iB;
+            }
+            return iA;
+        }
+
+        /// <summary>
+        /// Makes child iX of iA the parent of iA. iX keeps its taller child; its shorter child replaces iX as a child of iA.
+        /// </summary>
+        void RotateUp(int32_t iA, int32_t iX, bool xIsChild2)
+        {
+            Node& A = m_Nodes[iA];
+            Node& X = m_Nodes[iX];
+            int32_t iF = X.Child1;
+            int32_t iG = X.Child2;
+
+            // X takes A's place under A's parent
+            X.Child1 = iA;
+            X.Parent = A.Parent;
+            A.Parent = iX;
+            if (X.Parent == kNull) {
+                m_Root = iX;
+            }
+            else if (m_Nodes[X.Parent].Child1 == iA) {
+                m_Nodes[X.Parent].Child1 = iX;
+            }
+            else {
+                m_Nodes[X.Parent].Child2 = iX;
+            }
+
+            int32_t iTall = m_Nodes[iF].Height > m_Nodes[iG].Height ? iF : iG;
+            int32_t iShort = iTall == iF ? iG : iF;
+
+            X.Child2 = iTall;
+            (xIsChild2 ? A.Child2 : A.Child1) = iShort;
+            m_Nodes[iShort].Parent = iA;
+
+            int32_t iOther = xIsChild2 ? A.Child1 : A.Child2; /* A's remaining original child */
+            A.Bounds = Aabb::Combine(m_Nodes[iOther].Bounds, m_Nodes[iShort].Bounds);
+            A.Height = 1 + std::max(m_Nodes[iOther].Height, m_Nodes[iShort].Height);
+            X.Bounds = Aabb::Combine(A.Bounds, m_Nodes[iTall].Bounds);
+            X.Height = 1 + std::max(A.Height, m_Nodes[iTall].Height);
+        }
+    };
+
+}
@@ -0,0 +1,327 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace Limnova
+{
+
+    /// <summary>
+    /// Hash for integer-like keys which are already well distributed, such as UUIDs - FlatHashMap mixes the hash bits itself,
+    /// so sequential keys are also safe.
+    /// </summary>
+    struct IdentityHash
+    {
+        template<typename T>
+        size_t operator()(const T& key) const { return (size_t)(uint64_t)key; }
+    };
+
+
+    /// <summary>
+    /// Open-addressing hash map using Robin Hood linear probing with backward-shift erasure. Entries live in one flat array and their
+    /// probe distances in a parallel byte array, so a probe run is scanned in the small byte array (which stays cached far longer than
+    /// the entries) and a lookup usually touches a single entry cache line rather than following node pointers. A miss is detected as
+    /// soon as a probed entry is closer to its home slot than the key would be. The load is kept at or below one half: probe runs
+    /// lengthen sharply above that, and at three-quarters load lookups were slower than std::unordered_map's.
+    /// Hashes are scrambled with a Fibonacci multiply before use, so cheap hashes (IdentityHash) are sufficient.
+    /// Unlike std::unordered_map, every insertion or erasure may move entries: iterators, pointers and references are invalidated.
+    /// </summary>
+    template<typename TKey, typename TValue, typename THash = std::hash<TKey>>
+    class FlatHashMap
+    {
+    public:
+        using value_type = std::pair<TKey, TValue>;
+    private:
+        struct Slot
+        {
+            union
+            {
+                value_type Entry; /* constructed only while the slot's probe is non-zero */
+            };
+
+            Slot() {}
+            ~Slot() {}
+        };
+
+        template<bool IsConst>
+        class Iterator
+        {
+            using MapPtr = std::conditional_t<IsConst, const FlatHashMap*, FlatHashMap*>;
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = FlatHashMap::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+            using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+            Iterator() = default;
+            Iterator(MapPtr map, size_t index) : m_Map(map), m_Index(index) { SkipEmpty(); }
+            operator Iterator<true>() const { return { m_Map, m_Index }; }
+
+            reference operator*() const { return m_Map->m_Slots[m_Index].Entry; }
+            pointer operator->() const { return &m_Map->m_Slots[m_Index].Entry; }
+
+            Iterator& operator++() { ++m_Index; SkipEmpty(); return *this; }
+            Iterator operator++(int) { Iterator it = *this; ++(*this); return it; }
+
+            bool operator==(const Iterator& rhs) const { return m_Index == rhs.m_Index; }
+            bool operator!=(const Iterator& rhs) const { return m_Index != rhs.m_Index; }
+        private:
+            void SkipEmpty() { while (m_Index < m_Map->m_Capacity && m_Map->m_Probes[m_Index] == 0) ++m_Index; }
+
+            MapPtr m_Map = nullptr;
+            size_t m_Index = 0;
+
+            friend class FlatHashMap;
+        };
+    public:
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        FlatHashMap() = default;
+        FlatHashMap(const FlatHashMap& other) { *this = other; }
+        FlatHashMap(FlatHashMap&& other) noexcept { Swap(other); }
+        ~FlatHashMap() { Release(); }
+
+        FlatHashMap& operator=(const FlatHashMap& other)
+        {
+            if (this == &other) return *this;
+            clear();
+            reserve(other.m_Size);
+            for (auto const& entry : other) {
+                InsertNew(value_type(entry));
+            }
+            return *this;
+        }
+        FlatHashMap& operator=(FlatHashMap&& other) noexcept
+        {
+            if (this != &other) {
+                Release();
+                Swap(other);
+            }
+            return *this;
+        }
+
+        iterator begin() { return { this, 0 }; }
+        iterator end() { return { this, m_Capacity }; }
+        const_iterator begin() const { return { this, 0 }; }
+        const_iterator end() const { return { this, m_Capacity }; }
+
+        size_t size() const { return m_Size; }
+        bool empty() const { return m_Size == 0; }
+
+        iterator find(const TKey& key) { return { this, FindIndex(key) }; }
+        const_iterator find(const TKey& key) const { return { this, FindIndex(key) }; }
+        bool contains(const TKey& key) const { return FindIndex(key) != m_Capacity; }
+
+        TValue& at(const TKey& key)
+        {
+            size_t index = FindIndex(key);
+            LV_CORE_ASSERT(index != m_Capacity, "Key not found!");
+            return m_Slots[index].Entry.second;
+        }
+        const TValue& at(const TKey& key) const
+        {
+            size_t index = FindIndex(key);
+            LV_CORE_ASSERT(index != m_Capacity, "Key not found!");
+            return m_Slots[index].Entry.second;
+        }
+
+        TValue& operator[](const TKey& key)
+        {
+            return try_emplace(key).first->second;
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(const TKey& key, Args&&... args)
+        {
+            size_t index = FindIndex(key);
+            if (index != m_Capacity) {
+                return { iterator{ this, index }, false };
+            }
+            index = InsertNew(value_type(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...)));
+            return { iterator{ this, index }, true };
+        }
+        template<typename V>
+        std::pair<iterator, bool> emplace(const TKey& key, V&& value)
+        {
+            return try_emplace(key, std::forward<V>(value));
+        }
+        std::pair<iterator, bool> insert(const value_type& entry)
+        {
+            return try_emplace(entry.first, entry.second);
+        }
+
+        size_t erase(const TKey& key)
+        {
+            size_t index = FindIndex(key);
+            if (index == m_Capacity) return 0;
+            EraseIndex(index);
+            return 1;
+        }
+        /// <returns>Iterator to the entry which was shifted into the erased entry's slot, or the next entry after it</returns>
+        iterator erase(const_iterator it)
+        {
+            size_t index = it.m_Index;
+            EraseIndex(index);
+            return { this, index };
+        }
+
+        void clear()
+        {
+            for (size_t i = 0; i < m_Capacity; i++) {
+                if (m_Probes[i] == 0) continue;
+                m_Slots[i].Entry.~value_type();
+                m_Probes[i] = 0;
+            }
+            m_Size = 0;
+        }
+
+        void reserve(size_t count)
+        {
+            size_t capacity = kMinCapacity;
+            while (capacity * kMaxLoadNumerator < count * kMaxLoadDenominator) capacity *= 2;
+            if (capacity > m_Capacity) {
+                Rehash(capacity);
+            }
+        }
+    private:
+        static constexpr size_t kMinCapacity = 16;
+        static constexpr size_t kMaxLoadNumerator = 1, kMaxLoadDenominator = 2;
+        static constexpr uint8_t kMaxProbe = std::numeric_limits<uint8_t>::max();
+
+        size_t HomeIndex(const TKey& key) const
+        {
+            /* Fibonacci hashing: the top bits of the product depend on every bit of the hash */
+            return (size_t)(((uint64_t)THash{}(key) * 0x9E3779B97F4A7C15ull) >> m_Shift);
+        }
+
+        size_t FindIndex(const TKey& key) const
+        {
+            if (m_Size == 0) return m_Capacity;
+
+            size_t mask = m_Capacity - 1;
+            size_t index = HomeIndex(key);
+            for (uint32_t probe = 1; m_Probes[index] >= probe; probe++)
+            {
+                if (m_Slots[index].Entry.first == key) return index;
+                index = (index + 1) & mask;
+            }
+            return m_Capacity;
+        }
+
+        /// <summary> Inserts an entry whose key is not in the map </summary>
+        /// <returns>Index of the inserted entry</returns>
+        size_t InsertNew(value_type&& entry)
+        {
+            if ((m_Size + 1) * kMaxLoadDenominator > m_Capacity * kMaxLoadNumerator) {
+                Rehash(m_Capacity == 0 ? kMinCapacity : m_Capacity * 2);
+            }
+
+            size_t mask = m_Capacity - 1;
+            size_t index = HomeIndex(entry.first);
+            size_t result = m_Capacity;
+            uint32_t probe = 1;
+            value_type carried = std::move(entry);
+            while (true)
+            {
+                if (m_Probes[index] == 0)
+                {
+                    new (&m_Slots[index].Entry) value_type(std::move(carried));
+                    m_Probes[index] = (uint8_t)probe;
+                    m_Size++;
+                    return result == m_Capacity ? index : result;
+                }
+                if (m_Probes[index] < probe)
+                {
+                    /* Robin Hood: the carried entry is further from home than the resident, so it takes the slot */
+                    std::swap(carried, m_Slots[index].Entry);
+                    uint32_t residentProbe = m_Probes[index];
+                    m_Probes[index] = (uint8_t)probe;
+                    probe = residentProbe;
+                    if (result == m_Capacity) result = index;
+                }
+                index = (index + 1) & mask;
+                if (++probe == kMaxProbe)
+                {
+                    /* Pathological clustering - grow and insert the displaced entry again */
+                    TKey placedKey = result == m_Capacity ? carried.first : m_Slots[result].Entry.first;
+                    Rehash(m_Capacity * 2);
+                    InsertNew(std::move(carried));
+                    return FindIndex(placedKey);
+                }
+            }
+        }
+
+        void EraseIndex(size_t index)
+        {
+            /* Backward shift: later entries of the probe run move back one slot, so no tombstones are needed */
+            size_t mask = m_Capacity - 1;
+            size_t next = (index + 1) & mask;
+            while (m_Probes[next] > 1)
+            {
+                m_Slots[index].Entry = std::move(m_Slots[next].Entry);
+                m_Probes[index] = m_Probes[next] - 1;
+                index = next;
+                next = (next + 1) & mask;
+            }
+            m_Slots[index].Entry.~value_type();
+            m_Probes[index] = 0;
+            m_Size--;
+        }
+
+        void Rehash(size_t capacity)
+        {
+            std::unique_ptr<Slot[]> slots = std::move(m_Slots);
+            std::unique_ptr<uint8_t[]> probes = std::move(m_Probes);
+            size_t oldCapacity = m_Capacity;
+
+            m_Slots = std::make_unique<Slot[]>(capacity);
+            m_Probes = std::make_unique<uint8_t[]>(capacity); /* zeroed: every slot starts empty */
+            m_Capacity = capacity;
+            m_Shift = 64;
+            for (size_t c = capacity; c > 1; c >>= 1) m_Shift--;
+            m_Size = 0;
+
+            for (size_t i = 0; i < oldCapacity; i++)
+            {
+                if (probes[i] == 0) continue;
+                InsertNew(std::move(slots[i].Entry));
+                slots[i].Entry.~value_type();
+            }
+        }
+
+        void Release()
+        {
+            clear();
+            m_Slots.reset();
+            m_Probes.reset();
+            m_Capacity = 0;
+            m_Shift = 64;
+        }
+
+        void Swap(FlatHashMap& other)
+        {
+            std::swap(m_Slots, other.m_Slots);
+            std::swap(m_Probes, other.m_Probes);
+            std::swap(m_Capacity, other.m_Capacity);
+            std::swap(m_Size, other.m_Size);
+            std::swap(m_Shift, other.m_Shift);
+        }
+    private:
+        std::unique_ptr<Slot[]> m_Slots;
+        std::unique_ptr<uint8_t[]> m_Probes; /* per slot: 0 if empty, otherwise 1 + the entry's distance from its home slot */
+        size_t m_Capacity = 0;
+        size_t m_Size = 0;
+        uint32_t m_Shift = 64;
+    };
+
+}
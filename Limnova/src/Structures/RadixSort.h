@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+
+namespace Limnova
+{
+
+    /// <summary>
+    /// A sort key paired with the index of the item it was computed for - sorting these rather than the items themselves
+    /// keeps each radix pass moving 16 bytes per item regardless of the item size.
+    /// </summary>
+    struct SortKeyIndex
+    {
+        uint64_t Key;
+        uint32_t Index;
+    };
+
+
+    /// <summary>
+    /// Stable least-significant-digit radix sort of 64-bit keys, in 8 passes of 8 bits. Passes whose digit is equal for every key
+    /// are skipped, so keys which only use their upper bits (or only their lower bits) cost proportionally fewer passes.
+    /// </summary>
+    /// <param name="items">Items to sort - sorted in place</param>
+    /// <param name="scratch">Working buffer - resized to the size of items, reuse it between calls to avoid reallocation</param>
+    inline void RadixSort(std::vector<SortKeyIndex>& items, std::vector<SortKeyIndex>& scratch)
+    {
+        constexpr size_t kRadixBits = 8;
+        constexpr size_t kRadixSize = 1 << kRadixBits;
+        constexpr size_t kNumPasses = 64 / kRadixBits;
+
+        if (items.size() < 2) return;
+        scratch.resize(items.size());
+
+        // Histogram every digit in one read of the keys
+        std::array<std::array<uint32_t, kRadixSize>, kNumPasses> counts = {};
+        for (auto const& item : items) {
+            for (size_t pass = 0; pass < kNumPasses; pass++) {
+                counts[pass][(item.Key >> (pass * kRadixBits)) & (kRadixSize - 1)]++;
+            }
+        }
+
+        std::vector<SortKeyIndex>* src = &items;
+        std::vector<SortKeyIndex>* dst = &scratch;
+        for (size_t pass = 0; pass < kNumPasses; pass++)
+        {
+            auto& count = counts[pass];
+
+            /* Skip the pass if all keys share this digit */
+            size_t firstDigit = ((*src)[0].Key >> (pass * kRadixBits)) & (kRadixSize - 1);
+            if (count[firstDigit] == items.size()) continue;
+
+            // Exclusive prefix sum -> output offsets
+            uint32_t offset = 0;
+            for (auto& c : count) {
+                uint32_t n = c;
+                c = offset;
+                offset += n;
+            }
+
+            for (auto const& item : *src) {
+                (*dst)[count[(item.Key >> (pass * kRadixBits)) & (kRadixSize - 1)]++] = item;
+            }
+            std::swap(src, dst);
+        }
+
+        if (src != &items) {
+            items.swap(scratch);
+        }
+    }
+
+}
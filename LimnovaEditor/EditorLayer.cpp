@@ -4,6 +4,7 @@
 
 #include "Resources/NativeScripts/CameraScripts.h"
 
+#include <Core/Timer.h>
 #include <Scene/SceneSerializer.h>
 #include <Utils/PlatformUtils.h>
 #include <imguizmo/ImGuizmo.h>
@@ -209,9 +210,9 @@ namespace Limnova
         ScriptEngine::SetContext(m_ActiveScene.get());
         m_SceneHierarchyPanel.SetContext(m_ActiveScene.get());
 
-        m_IconPlay = Texture2D::Create(s_ResourcesDirectoryPath / "Icons\\PlayButton.png");
-        m_IconPause = Texture2D::Create(s_ResourcesDirectoryPath / "Icons\\PauseButton.png");
-        m_IconStop = Texture2D::Create(s_ResourcesDirectoryPath / "Icons\\StopButton.png");
+        m_IconPlay = TextureLibrary::Load(s_ResourcesDirectoryPath / "Icons\\PlayButton.png");
+        m_IconPause = TextureLibrary::Load(s_ResourcesDirectoryPath / "Icons\\PauseButton.png");
+        m_IconStop = TextureLibrary::Load(s_ResourcesDirectoryPath / "Icons\\StopButton.png");
     }
 
 
@@ -225,6 +226,8 @@ namespace Limnova
     {
         LV_PROFILE_FUNCTION();
 
+        Timer updateTimer;
+
         // Update
         {
             LV_PROFILE_SCOPE("EditorLayer::OnUpdate");
@@ -292,22 +295,139 @@ namespace Limnova
             }
             }
 
-            // Mouse hovering entities
+            m_Framebuffer->Unbind();
+        }
+
+        // Mouse hovering entities
+        /* Picked with a ray cast against the scene's spatial index. Visuals which are not in the index (e.g, orbit paths) are picked
+         * from the entity ID attachment, which is read back asynchronously - see UpdatePixelPicking() */
+        {
+            LV_PROFILE_SCOPE("Mouse Picking - EditorLayer::OnUpdate");
+
             int mouseX = (int)(ImGui::GetMousePos().x - m_ViewportBounds[0].x);
             int mouseY = (int)(m_ViewportBounds[1].y - ImGui::GetMousePos().y);
 
             auto viewportSize = m_ViewportBounds[1] - m_ViewportBounds[0];
-            int pixelData = -1;
+            m_HoveredEntity = Entity::Null;
+            m_HoveredPixel[0] = m_HoveredPixel[1] = -1;
             if (mouseX >= 0 && mouseY >= 0 &&
                 mouseX < viewportSize.x && mouseY < viewportSize.y)
             {
-                pixelData = m_Framebuffer->ReadPixel(mouseX, mouseY, 1);
+                m_HoveredPixel[0] = mouseX;
+                m_HoveredPixel[1] = mouseY;
+
+                Camera* camera = nullptr;
+                if (m_SceneState == SceneState::Play) {
+                    Entity cameraEntity = m_ActiveScene->GetActiveCamera();
+                    if (cameraEntity) camera = &cameraEntity.GetComponent<CameraComponent>().Camera;
+                }
+                else {
+                    camera = &m_EditorCamera.GetCamera();
+                }
+
+                if (camera != nullptr) {
+                    Vector2 ndc = { 2.f * (float)mouseX / viewportSize.x - 1.f, 2.f * (float)mouseY / viewportSize.y - 1.f };
+                    Vector3 rayOrigin, rayDirection;
+                    camera->GetRay(ndc, rayOrigin, rayDirection);
+                    m_HoveredEntity = m_ActiveScene->RaycastEntity(rayOrigin, rayDirection);
+                }
             }
-            m_HoveredEntity = (pixelData == -1) ? Entity::Null
-                : Entity{ (entt::entity)pixelData, m_ActiveScene.get() };
 
-            m_Framebuffer->Unbind();
+            UpdatePixelPicking();
         }
+
+        m_UpdateMillis = 0.95f * m_UpdateMillis + 0.05f * updateTimer.ElapsedMillis();
+    }
+
+
+    void EditorLayer::UpdatePixelPicking()
+    {
+        LV_PROFILE_FUNCTION();
+
+        /* The readback ring is small and drops its oldest readback when full - hover readbacks are paused while a box selection's
+         * readback is in flight, so that they cannot evict it. A readback which was dropped or failed is no longer waited for */
+        if (m_BoxSelectReadbackId != 0 && !m_Framebuffer->IsReadbackPending(m_BoxSelectReadbackId)) {
+            m_BoxSelectReadbackId = 0;
+        }
+        bool boxSelectPending = m_BoxSelectReadbackId != 0;
+
+        if (!m_AsyncPixelPicking)
+        {
+            /* Synchronous read, kept for comparison - glReadPixels stalls until the GPU has finished drawing the frame */
+            m_PixelHoveredEntity = Entity::Null;
+            if (m_HoveredPixel[0] >= 0) {
+                m_Framebuffer->Bind();
+                m_PixelHoveredEntity = EntityFromPixel(m_Framebuffer->ReadPixel(m_HoveredPixel[0], m_HoveredPixel[1], 1));
+                m_Framebuffer->Unbind();
+            }
+        }
+        else if (m_HoveredPixel[0] >= 0) {
+            if (!boxSelectPending) m_Framebuffer->RequestReadback(m_HoveredPixel[0], m_HoveredPixel[1], 1, 1, 1);
+        }
+        else {
+            m_PixelHoveredEntity = Entity::Null;
+        }
+
+        // Box selection
+        if (m_BoxSelectStart[0] >= 0 && !Input::IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
+        {
+            if (m_HoveredPixel[0] >= 0)
+            {
+                int minX = std::min(m_BoxSelectStart[0], m_HoveredPixel[0]), minY = std::min(m_BoxSelectStart[1], m_HoveredPixel[1]);
+                int maxX = std::max(m_BoxSelectStart[0], m_HoveredPixel[0]), maxY = std::max(m_BoxSelectStart[1], m_HoveredPixel[1]);
+                m_BoxSelectReadbackId = m_Framebuffer->RequestReadback(minX, minY, maxX - minX + 1, maxY - minY + 1, 1);
+            }
+            m_BoxSelectStart[0] = m_BoxSelectStart[1] = -1;
+        }
+
+        FramebufferReadback readback;
+        while (m_Framebuffer->PollReadback(readback))
+        {
+            if (readback.Id == m_BoxSelectReadbackId)
+            {
+                /* Entities are ordered by the number of pixels they cover in the box, most first, then by ID - the scene hierarchy
+                 * panel selects a single entity, so the one which fills most of the box is selected */
+                std::unordered_map<int, size_t> pixelCounts;
+                for (int id : readback.Pixels) {
+                    pixelCounts[id]++;
+                }
+                std::vector<std::pair<int, size_t>> boxed(pixelCounts.begin(), pixelCounts.end());
+                std::sort(boxed.begin(), boxed.end(), [](const auto& lhs, const auto& rhs) {
+                    return lhs.second != rhs.second ? lhs.second > rhs.second : lhs.first < rhs.first;
+                });
+                m_BoxSelectedEntities.clear();
+                for (auto [id, count] : boxed) {
+                    if (Entity entity = EntityFromPixel(id)) m_BoxSelectedEntities.push_back(entity);
+                }
+                m_BoxSelectReadbackId = 0;
+
+                m_SceneHierarchyPanel.SetSelectedEntity(m_BoxSelectedEntities.empty() ? Entity::Null : m_BoxSelectedEntities.front());
+            }
+            else if (m_AsyncPixelPicking && m_HoveredPixel[0] >= 0) {
+                m_PixelHoveredEntity = EntityFromPixel(readback.Pixels[0]);
+            }
+        }
+    }
+
+
+    void EditorLayer::ResetPicking()
+    {
+        /* Picked entities refer to the scene being replaced, and readbacks still in flight were drawn from it - their entity IDs
+         * would be resolved against the new scene's registry */
+        m_Framebuffer->DiscardReadbacks();
+        m_HoveredEntity = Entity::Null;
+        m_PixelHoveredEntity = Entity::Null;
+        m_BoxSelectStart[0] = m_BoxSelectStart[1] = -1;
+        m_BoxSelectReadbackId = 0;
+        m_BoxSelectedEntities.clear();
+    }
+
+
+    Entity EditorLayer::EntityFromPixel(int pixelData)
+    {
+        /* Read back entity IDs may be a frame or two old, so the entity may have been destroyed since */
+        Entity entity = pixelData == -1 ? Entity::Null : Entity{ (entt::entity)pixelData, m_ActiveScene.get() };
+        return entity ? entity : Entity::Null;
     }
 
 
@@ -427,6 +547,11 @@ namespace Limnova
             ? m_HoveredEntity.GetComponent<TagComponent>().Tag
             : "None";
         ImGui::Text("Hovered entity: %s", hoveredEntityTag.c_str());
+        std::string pixelHoveredEntityTag = m_PixelHoveredEntity
+            ? m_PixelHoveredEntity.GetComponent<TagComponent>().Tag
+            : "None";
+        ImGui::Text("Entity ID under mouse: %s", pixelHoveredEntityTag.c_str());
+        ImGui::Text("Box selected entities: %d", (int)m_BoxSelectedEntities.size());
 
 #ifdef LV_EDITOR_USE_ORBITAL
 
@@ -468,6 +593,7 @@ namespace Limnova
             ImGui::DragFloat("Thickness", &m_ActiveScene->m_OrbitThickness, 0.001f, 0.001f, 1.f, "%.3f");
             ImGui::DragFloat("Alpha", &m_ActiveScene->m_OrbitAlpha, 0.001f, 0.f, 1.f, "%.3f");
             ImGui::DragFloat("Plot Point Radius", &m_ActiveScene->m_OrbitPointRadius, 0.001f, 0.001f, 0.1f, "%.3f");
+            ImGui::DragInt("Recomputes Per Frame", &m_ActiveScene->m_OrbitRecomputeBudget, 1.f, 1, 4096);
 
             if (ImGui::TreeNodeEx("Perifocal Frame", ImGuiTreeNodeFlags_DefaultOpen))
             {
@@ -478,6 +604,20 @@ namespace Limnova
 
             ImGui::TreePop();
         }
+
+        if (ImGui::TreeNodeEx("Impostor Visuals", ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            ImGui::DragInt("Superior Levels", &m_ActiveScene->m_SuperiorLevels, 0.1f, 0, 8);
+            ImGui::DragInt("Inferior Levels", &m_ActiveScene->m_InferiorLevels, 0.1f, 0, 8);
+            ImGui::DragInt("Refresh Frames", &m_ActiveScene->m_ImpostorRefreshFrames, 1.f, 1, 600);
+            ImGui::DragFloat("Radius", &m_ActiveScene->m_ImpostorRadius, 0.001f, 0.001f, 0.1f, "%.3f");
+            ImGui::DragFloat("Max Distance", &m_ActiveScene->m_ImpostorMaxDistance, 0.1f, 1.f, 1000.f, "%.1f");
+            ImGui::DragFloat("Alpha", &m_ActiveScene->m_ImpostorAlpha, 0.001f, 0.f, 1.f, "%.3f");
+
+            ImGui::TreePop();
+        }
+
+        ImGui::DragFloat("Min Screen Size", &m_ActiveScene->m_MinScreenSize, 0.0001f, 0.f, 0.1f, "%.4f");
 #endif
 
         ImGui::End(); // Scene Properties
@@ -486,9 +626,50 @@ namespace Limnova
         ImGui::Begin("Renderer2D Statistics", NULL, ImGuiWindowFlags_NoMove);
         auto& stats = Renderer2D::GetStatistics();
         ImGui::Text("Draw Calls:    %d", stats.DrawCalls);
-        ImGui::Text("Quads:         %d", stats.QuadCount);
-        ImGui::Text("Vertices:      %d", stats.GetNumVertices());
-        ImGui::Text("Indices:       %d", stats.GetNumIndices());
+        ImGui::Text("Items drawn:   %d", stats.ItemsDrawn);
+        ImGui::Text("Items culled:  %d", stats.ItemsCulled);
+        ImGui::Text("Bytes uploaded: %d", stats.BytesUploaded);
+        bool instancing = Renderer2D::IsInstancing();
+        if (ImGui::Checkbox("Instancing", &instancing)) {
+            Renderer2D::SetInstancing(instancing);
+        }
+        ImGui::Text("Editor update: %.3f ms", m_UpdateMillis);
+        ImGui::Checkbox("Async Pixel Picking", &m_AsyncPixelPicking);
+        bool renderQueue = Renderer2D::IsRenderQueueEnabled();
+        if (ImGui::Checkbox("Sorted Render Queue", &renderQueue)) {
+            Renderer2D::SetRenderQueue(renderQueue);
+        }
+        int capacityLimit = (int)Renderer2D::GetBatchCapacityLimit();
+        if (ImGui::DragInt("Batch Capacity Limit", &capacityLimit, 1024.f, 1024, 1 << 20)) {
+            Renderer2D::SetBatchCapacityLimit((uint32_t)capacityLimit);
+        }
+        if (ImGui::BeginTable("Primitives", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+        {
+            ImGui::TableSetupColumn("Type");
+            ImGui::TableSetupColumn("Count");
+            ImGui::TableSetupColumn("Capacity");
+            ImGui::TableSetupColumn("Flushes");
+            ImGui::TableSetupColumn("Bytes");
+            ImGui::TableSetupColumn("Draw (ms)");
+            ImGui::TableSetupColumn("Flush (ms)");
+            ImGui::TableHeadersRow();
+            auto primitiveRow = [](const char* name, const Renderer2D::PrimitiveStatistics& primitive) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(name);
+                ImGui::TableNextColumn(); ImGui::Text("%d", primitive.Count);
+                ImGui::TableNextColumn(); ImGui::Text("%d", primitive.Capacity);
+                ImGui::TableNextColumn(); ImGui::Text("%d", primitive.Flushes);
+                ImGui::TableNextColumn(); ImGui::Text("%d", primitive.Bytes);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", primitive.DrawMillis);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", primitive.FlushMillis);
+            };
+            primitiveRow("Quads", stats.Quads);
+            primitiveRow("Circles", stats.Circles);
+            primitiveRow("Ellipses", stats.Ellipses);
+            primitiveRow("Hyperbolas", stats.Hyperbolas);
+            primitiveRow("Lines", stats.Lines);
+            ImGui::EndTable();
+        }
         ImGui::End(); // Renderer2D Statistics
 
 
@@ -595,6 +776,12 @@ namespace Limnova
         uint32_t viewportRendererId = m_Framebuffer->GetColorAttachmentRendererId();
         ImGui::Image((void*)viewportRendererId, viewportPanelSize, { 0, 1 }, { 1, 0 });
 
+        if (m_BoxSelectStart[0] >= 0)
+        {
+            ImVec2 boxStart{ m_ViewportBounds[0].x + m_BoxSelectStart[0], m_ViewportBounds[1].y - m_BoxSelectStart[1] };
+            ImGui::GetWindowDrawList()->AddRect(boxStart, ImGui::GetMousePos(), IM_COL32(255, 255, 255, 192));
+        }
+
         // Scene drag & drop
         if (ImGui::BeginDragDropTarget())
         {
@@ -829,8 +1016,21 @@ namespace Limnova
     {
         if (e.GetMouseButton() == MOUSE_BUTTON_LEFT)
         {
-            if (CanMousePick()) {
-                m_SceneHierarchyPanel.SetSelectedEntity(m_HoveredEntity);
+            if (CanMousePick())
+            {
+                bool shift = Input::IsKeyPressed(KEY_LEFT_SHIFT) || Input::IsKeyPressed(KEY_RIGHT_SHIFT);
+                if (shift && m_HoveredPixel[0] >= 0)
+                {
+                    /* Selection box is read back from the entity ID attachment when the button is released */
+                    m_BoxSelectStart[0] = m_HoveredPixel[0];
+                    m_BoxSelectStart[1] = m_HoveredPixel[1];
+                }
+                else
+                {
+                    /* Visuals which are not in the spatial index (e.g, orbit paths) are picked from the entity ID attachment */
+                    Entity picked = m_HoveredEntity ? m_HoveredEntity : m_PixelHoveredEntity;
+                    m_SceneHierarchyPanel.SetSelectedEntity(picked);
+                }
             }
         }
         return false;
@@ -858,6 +1058,7 @@ namespace Limnova
         m_SceneHierarchyPanel.SetContext(m_EditorScene.get());
         m_ActiveScene = m_EditorScene;
         m_EditorScenePath.clear();
+        ResetPicking();
     }
 
 
@@ -913,6 +1114,7 @@ namespace Limnova
         m_ActiveScene->ScriptEngineUseContext();
         m_ActiveScene->PhysicsUseContext();
         m_SceneHierarchyPanel.SetContext(m_ActiveScene.get());
+        ResetPicking();
 
         m_ActiveScene->OnStartRuntime();
     }
@@ -941,6 +1143,7 @@ namespace Limnova
         m_ActiveScene->ScriptEngineUseContext();
         m_ActiveScene->PhysicsUseContext();
         m_SceneHierarchyPanel.SetContext(m_ActiveScene.get());
+        ResetPicking();
 
         m_ActiveScene->OnStartRuntime();
     }
@@ -957,6 +1160,7 @@ namespace Limnova
         m_EditorScene->ScriptEngineUseContext();
         m_EditorScene->PhysicsUseContext();
         m_SceneHierarchyPanel.SetContext(m_EditorScene.get());
+        ResetPicking();
     }
 
 
@@ -36,6 +36,9 @@ namespace Limnova
         bool OnMouseButtonPressed(MouseButtonPressedEvent& e);
 
         bool CanMousePick();
+        void UpdatePixelPicking();
+        void ResetPicking();
+        Entity EntityFromPixel(int pixelData);
 
         void NewScene();
         void OpenScene();
@@ -77,6 +80,15 @@ namespace Limnova
         float m_SceneDTMultiplier = 1.f;
 
         Entity m_HoveredEntity = Entity::Null;
+        int m_HoveredPixel[2] = { -1, -1 }; /* Viewport pixel under the mouse, or -1 if the mouse is outside the viewport */
+
+        /* Entity ID attachment readback - asynchronous unless disabled for comparison */
+        bool m_AsyncPixelPicking = true;
+        Entity m_PixelHoveredEntity = Entity::Null; /* entity ID under the mouse, one or two frames old */
+        int m_BoxSelectStart[2] = { -1, -1 }; /* Viewport pixel where the box selection began, or -1 if not box selecting */
+        uint32_t m_BoxSelectReadbackId = 0;
+        std::vector<Entity> m_BoxSelectedEntities; /* ordered by pixels covered in the box, most first - the first is selected */
+        float m_UpdateMillis = 0.f; /* smoothed duration of OnUpdate */
 
         int m_ActiveGizmo = -1; /* from ImGuizmo::OPERATION */
         float m_SnapTranslate = 0.5f, m_SnapRotate = 45.f, m_SnapScale = 0.5f;
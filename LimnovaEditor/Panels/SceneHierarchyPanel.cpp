@@ -382,7 +382,7 @@ namespace Limnova
                 config.Precision = 2;
                 if (LimnGui::DragVec3("Position", transform.Position, config))
                 {
-                    transform.NeedCompute = true;
+                    transform.MarkDirty();
 
                     if (entity.HasComponent<OrbitalComponent>()) {
                         auto& oc = entity.GetComponent<OrbitalComponent>();
@@ -421,7 +421,7 @@ namespace Limnova
                 config.Precision = 2;
                 if (LimnGui::DragVec3("Scale", transform.Scale, config))
                 {
-                    transform.NeedCompute = true;
+                    transform.MarkDirty();
 
 #ifdef LV_EDITOR_USE_ORBITAL
                     entity.GetComponent<OrbitalHierarchyComponent>().AbsoluteScale =
@@ -435,24 +435,28 @@ namespace Limnova
         ComponentInspector<HierarchyComponent>(entity, "Hierarchy", false, [&]() {
             auto& hierarchy = entity.GetComponent<HierarchyComponent>();
 
-            if (hierarchy.Parent != UUID::Null) {
-                ImGui::Text("Parent: %s", m_Scene->GetEntity(hierarchy.Parent).GetComponent<TagComponent>().Tag.c_str());
-                std::ostringstream oss; oss << (uint64_t)hierarchy.Parent;
+            if (hierarchy.Parent != entt::null) {
+                Entity linked = { hierarchy.Parent, m_Scene };
+                ImGui::Text("Parent: %s", linked.GetComponent<TagComponent>().Tag.c_str());
+                std::ostringstream oss; oss << (uint64_t)linked.GetUUID();
                 LimnGui::HelpMarker(oss.str());
             }
-            if (hierarchy.NextSibling != UUID::Null) {
-                ImGui::Text("Next sib: %s", m_Scene->GetEntity(hierarchy.NextSibling).GetComponent<TagComponent>().Tag.c_str());
-                std::ostringstream oss; oss << (uint64_t)hierarchy.NextSibling;
+            if (hierarchy.NextSibling != entt::null) {
+                Entity linked = { hierarchy.NextSibling, m_Scene };
+                ImGui::Text("Next sib: %s", linked.GetComponent<TagComponent>().Tag.c_str());
+                std::ostringstream oss; oss << (uint64_t)linked.GetUUID();
                 LimnGui::HelpMarker(oss.str());
             }
-            if (hierarchy.PrevSibling != UUID::Null) {
-                ImGui::Text("Prev sib: %s", m_Scene->GetEntity(hierarchy.PrevSibling).GetComponent<TagComponent>().Tag.c_str());
-                std::ostringstream oss; oss << (uint64_t)hierarchy.PrevSibling;
+            if (hierarchy.PrevSibling != entt::null) {
+                Entity linked = { hierarchy.PrevSibling, m_Scene };
+                ImGui::Text("Prev sib: %s", linked.GetComponent<TagComponent>().Tag.c_str());
+                std::ostringstream oss; oss << (uint64_t)linked.GetUUID();
                 LimnGui::HelpMarker(oss.str());
             }
-            if (hierarchy.FirstChild != UUID::Null) {
-                ImGui::Text("First child: %s", m_Scene->GetEntity(hierarchy.FirstChild).GetComponent<TagComponent>().Tag.c_str());
-                std::ostringstream oss; oss << (uint64_t)hierarchy.FirstChild;
+            if (hierarchy.FirstChild != entt::null) {
+                Entity linked = { hierarchy.FirstChild, m_Scene };
+                ImGui::Text("First child: %s", linked.GetComponent<TagComponent>().Tag.c_str());
+                std::ostringstream oss; oss << (uint64_t)linked.GetUUID();
                 LimnGui::HelpMarker(oss.str());
             }
         });
@@ -973,7 +977,7 @@ namespace Limnova
                 }
                 else
                 {
-                    Vector3 position = orbital.Object.GetState().Position;
+                    Vector3 position = (Vector3)orbital.Object.GetState().Position;
                     LimnGui::InputConfig<float> config;
                     config.Speed = 0.0001f;
                     config.Precision = 4;
@@ -0,0 +1,33 @@
+using System;
+using System.Runtime.CompilerServices;
+
+namespace Limnova
+{
+
+    /* Script-call workload of TestLayer::Benchmark_EntityLookup - every internal call looks up its entities by UUID */
+    public class LookupBenchmark : Entity
+    {
+        public EntityReference  Target;
+        public int              CallsPerUpdate = 16;
+
+        public override void OnCreate(ulong entityId)
+        {
+            m_Id = entityId; /* without Entity.OnCreate()'s log line - the benchmark creates many instances */
+        }
+
+        public override void OnUpdate(float dT)
+        {
+            TransformComponent transform = Transform;
+            for (int i = 0; i < CallsPerUpdate; i++)
+            {
+                Vec3 position = transform.Position;
+                if (Target.IsReferenceValid())
+                {
+                    position.X += dT;
+                }
+                transform.Position = position;
+            }
+        }
+    }
+
+}
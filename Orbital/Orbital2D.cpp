@@ -151,11 +151,11 @@ void Orbital2D::OnAttach()
     }
 
     // Textures
-    m_CheckerboardTexture = LV::Texture2D::Create(ASSET_DIR"\\textures\\testtex.png", LV::Texture::WrapMode::MirroredTile);
-    m_CircleFillTexture = LV::Texture2D::Create(ASSET_DIR"\\textures\\orbiter-0.png", LV::Texture::WrapMode::Clamp);
-    m_CircleTexture = LV::Texture2D::Create(ASSET_DIR"\\textures\\orbit-a1270.png", LV::Texture::WrapMode::Clamp);
-    m_CircleThickTexture = LV::Texture2D::Create(ASSET_DIR"\\textures\\circleThick.png", LV::Texture::WrapMode::Clamp);
-    m_CircleLargeFillTexture = LV::Texture2D::Create(ASSET_DIR"\\textures\\circleFill_d1270.png", LV::Texture::WrapMode::Clamp);
+    m_CheckerboardTexture = LV::TextureLibrary::Load(ASSET_DIR"\\textures\\testtex.png", LV::Texture::WrapMode::MirroredTile);
+    m_CircleFillTexture = LV::TextureLibrary::Load(ASSET_DIR"\\textures\\orbiter-0.png", LV::Texture::WrapMode::Clamp);
+    m_CircleTexture = LV::TextureLibrary::Load(ASSET_DIR"\\textures\\orbit-a1270.png", LV::Texture::WrapMode::Clamp);
+    m_CircleThickTexture = LV::TextureLibrary::Load(ASSET_DIR"\\textures\\circleThick.png", LV::Texture::WrapMode::Clamp);
+    m_CircleLargeFillTexture = LV::TextureLibrary::Load(ASSET_DIR"\\textures\\circleFill_d1270.png", LV::Texture::WrapMode::Clamp);
 }
 
 
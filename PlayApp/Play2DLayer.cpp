@@ -40,9 +40,10 @@ namespace Limnova
         );*/
 
         // Textures
-        m_TurretTexture = Texture2D::Create(ASSET_DIR"\\textures\\turret.png", Texture::WrapMode::Clamp);
-        m_CheckerboardTexture = Texture2D::Create(ASSET_DIR"\\textures\\testtex.png", Texture::WrapMode::MirroredTile);
-        m_SpriteSheet = Texture2D::Create(ASSET_DIR"\\textures\\kenney-sheet\\Spritesheet\\RPGpack_sheet_2X.png", Texture::WrapMode::Clamp);
+        m_TurretSprite = TextureLibrary::LoadSprite(ASSET_DIR"\\textures\\turret.png");
+        m_CheckerboardTexture = TextureLibrary::Load(ASSET_DIR"\\textures\\testtex.png", Texture::WrapMode::MirroredTile);
+        m_SpriteSheet = TextureLibrary::Load(ASSET_DIR"\\textures\\kenney-sheet\\Spritesheet\\RPGpack_sheet_2X.png", Texture::WrapMode::Clamp);
+        TextureLibrary::WaitAll(); /* sprite coordinates are computed from the sheet's size, which is only known once it is loaded */
         m_SpriteStairs = SubTexture2D::CreateFromCoords(m_SpriteSheet, { 7, 6 }, { 128, 128 });
         m_SpriteTree = SubTexture2D::CreateFromCoords(m_SpriteSheet, { 2, 1 }, { 128, 128 }, { 1, 2 });
 
@@ -207,7 +208,7 @@ namespace Limnova
         ImGui::Begin("Renderer2D Statistics");
         auto& stats = Renderer2D::GetStatistics();
         ImGui::Text("Draw Calls:    %d", stats.DrawCalls);
-        ImGui::Text("Quads:         %d", stats.QuadCount);
+        ImGui::Text("Quads:         %d", stats.Quads.Count);
         ImGui::Text("Vertices:      %d", stats.GetNumVertices());
         ImGui::Text("Indices:       %d", stats.GetNumIndices());
         ImGui::End(); // Renderer2D Statistics
@@ -29,7 +29,7 @@ namespace Limnova
         Entity m_Camera0, m_Camera1;
 
         ShaderLibrary m_ShaderLibrary;
-        Ref<Texture2D> m_TurretTexture;
+        Ref<SubTexture2D> m_TurretSprite;
         Ref<Texture2D> m_CheckerboardTexture;
         Ref<VertexArray> m_SquareVA;
         Ref<Texture2D> m_SpriteSheet;
@@ -17,8 +17,9 @@ namespace Limnova
     public:
         PlayApp()
         {
-            //PushLayer(new TestLayer());
-            //
+#ifdef LV_RUN_BENCHMARKS
+            PushLayer(new TestLayer()); /* tests and benchmarks run in TestLayer::OnAttach() */
+#endif
             PushLayer(new Play2DLayer());
         }
 
@@ -1,5 +1,13 @@
 #include "TestLayer.h"
 
+#include <src/Core/Timer.h>
+#include <src/Scene/SceneSerializer.h>
+
+#include <entt.hpp>
+
+#include <filesystem>
+#include <random>
+
 namespace LV = Limnova;
 
 
@@ -12,6 +20,19 @@ TestLayer::TestLayer()
 void TestLayer::OnAttach()
 {
     if (Test_BigFloatComparisonOperators()) LV_INFO("Test set passed: BigFloat Comparison Operators!");
+    if (Test_OrbitAfterThrustStops()) LV_INFO("Test set passed: Orbit After Thrust Stops!");
+    if (Test_LoadedThrustIsDynamic()) LV_INFO("Test set passed: Loaded Thrust Is Dynamic!");
+    if (Test_BudgetedOrbitAfterLocalSpaceChange()) LV_INFO("Test set passed: Budgeted Orbit After Local Space Change!");
+    if (Test_LoadedSiblingOrder()) LV_INFO("Test set passed: Loaded Sibling Order!");
+
+    Benchmark_OrbitalPrecision();
+    Benchmark_SceneGetTree();
+    Benchmark_ViewVsGroup();
+    Benchmark_PrefabInstancing();
+    Benchmark_EntityLookup();
+    Benchmark_RenderQueue();
+    Benchmark_TextureAtlas();
+    Benchmark_VertexFormats();
 }
 
 
@@ -82,3 +103,656 @@ bool TestLayer::Test_BigFloatVsStd()
 
     return true;
 }
+
+
+bool TestLayer::Test_OrbitAfterThrustStops()
+{
+    using Physics = LV::OrbitalPhysics;
+
+    Physics::Context context;
+    Physics::SetContext(&context);
+    Physics::SetRootSpaceScaling(1e7);
+    Physics::GetRootObjectNode().SetMass(5.97e24);
+
+    auto object = Physics::Create(Physics::GetRootLSpaceNode(), 1e3, { 0.5f, 0.f, 0.f }, true);
+    object.SetContinuousAcceleration({ 0.0, 0.0, -5.0 });
+    Physics::OnUpdate(1.f);
+    object.GetOrbit(); /* orbit is now up to date with the thrusting state */
+
+    /* The first step without thrust still averages in the previous step's thrust, so it must invalidate the orbit */
+    object.SetContinuousAcceleration({ 0.0 });
+    Physics::OnUpdate(1.f);
+    Physics::Elements elements = object.GetOrbit().Elements;
+
+    auto const& state = object.GetState();
+    auto fresh = Physics::Create(Physics::GetRootLSpaceNode(), 1e3, (LV::Vector3)state.Position, state.Velocity);
+    Physics::Elements const& freshElements = fresh.GetOrbit().Elements;
+    LV_ASSERT(abs(elements.H - freshElements.H) <= 1e-9 * abs(freshElements.H), "Orbit is stale after thrust stopped!");
+    LV_ASSERT(abs(elements.E - freshElements.E) <= 1e-6f, "Orbit is stale after thrust stopped!");
+
+    Physics::SetContext(nullptr);
+    return true;
+}
+
+
+bool TestLayer::Test_LoadedThrustIsDynamic()
+{
+    using Physics = LV::OrbitalPhysics;
+
+    /* Scene loading creates orbital entities in one batch - thrusting objects must still be integrated dynamically */
+    std::string filepath = (std::filesystem::temp_directory_path() / "TestLayer_LoadedThrust.orbital").string();
+    LV::UUID shipId;
+    {
+        LV::OrbitalScene scene;
+        scene.SetRootScaling(1e7);
+        scene.GetRoot().GetComponent<LV::OrbitalComponent>().Object.SetMass(5.97e24);
+
+        LV::OrbitalScene::OrbitalEntityDesc desc;
+        desc.Name = "Ship";
+        desc.Mass = 1e3;
+        desc.Position = { 0.5f, 0.f, 0.f };
+        desc.CircularOrbit = true;
+        desc.Dynamic = true;
+        desc.ContAcceleration = { 0.0, 0.0, -5.0 };
+        LV::Entity ship = scene.CreateOrbitalEntities({ &desc, 1 }).front();
+        shipId = ship.GetUUID();
+        LV_ASSERT(ship.GetComponent<LV::OrbitalComponent>().Object.GetMotion().Integration == Physics::Motion::Integration::Dynamic,
+            "Batch-created thrusting object is not integrated dynamically!");
+
+        LV::SceneSerializer::Serialize(&scene, filepath);
+    }
+
+    LV::OrbitalScene loaded;
+    LV_ASSERT(LV::SceneSerializer::Deserialize(&loaded, filepath), "Failed to load the scene!");
+    auto const& object = loaded.GetEntity(shipId).GetComponent<LV::OrbitalComponent>().Object;
+    LV_ASSERT(!object.GetDynamics().ContAcceleration.IsZero(), "Loaded object lost its thrust!");
+    LV_ASSERT(object.GetMotion().Integration == Physics::Motion::Integration::Dynamic, "Loaded thrusting object is not integrated dynamically!");
+
+    std::filesystem::remove(filepath);
+    Physics::SetContext(nullptr);
+    return true;
+}
+
+
+bool TestLayer::Test_LoadedSiblingOrder()
+{
+    /* Orbital entities are created in a batch ahead of the others on load - the saved sibling order must still be kept */
+    std::string filepath = (std::filesystem::temp_directory_path() / "TestLayer_SiblingOrder.orbital").string();
+    std::vector<uint64_t> savedOrder;
+    {
+        LV::OrbitalScene scene;
+        scene.SetRootScaling(1e7);
+        scene.GetRoot().GetComponent<LV::OrbitalComponent>().Object.SetMass(5.97e24);
+
+        LV::OrbitalScene::OrbitalEntityDesc desc;
+        desc.Mass = 1e3;
+        desc.CircularOrbit = true;
+        desc.Name = "Orbital A";
+        desc.Position = { 0.4f, 0.f, 0.f };
+        scene.CreateOrbitalEntities({ &desc, 1 });
+        scene.CreateEntity("Non-orbital B");
+        desc.Name = "Orbital C";
+        desc.Position = { 0.6f, 0.f, 0.f };
+        scene.CreateOrbitalEntities({ &desc, 1 });
+
+        for (auto child : scene.GetChildren(scene.GetRoot())) savedOrder.push_back(child.GetUUID());
+        LV::SceneSerializer::Serialize(&scene, filepath);
+    }
+
+    LV::OrbitalScene loaded;
+    LV_ASSERT(LV::SceneSerializer::Deserialize(&loaded, filepath), "Failed to load the scene!");
+    std::vector<uint64_t> loadedOrder;
+    for (auto child : loaded.GetChildren(loaded.GetRoot())) loadedOrder.push_back(child.GetUUID());
+    LV_ASSERT(loadedOrder == savedOrder, "Loading changed the order of the root's children!");
+
+    std::filesystem::remove(filepath);
+    LV::OrbitalPhysics::SetContext(nullptr);
+    return true;
+}
+
+
+bool TestLayer::Test_BudgetedOrbitAfterLocalSpaceChange()
+{
+    using Physics = LV::OrbitalPhysics;
+
+    Physics::Context context;
+    Physics::SetContext(&context);
+    Physics::SetRootSpaceScaling(1e7);
+    Physics::GetRootObjectNode().SetMass(5.97e24);
+
+    auto object = Physics::Create(Physics::GetRootLSpaceNode(), 1e3, { 0.5f, 0.f, 0.f }, true); /* dynamic, so it may leave the new local space */
+    auto innerLsp = Physics::GetRootObjectNode().AddLocalSpace(0.75f);
+    object.GetOrbitBudgeted();
+
+    /* With no budget left, an orbit from the object's previous local space must still not be returned */
+    Physics::ResetOrbitRecomputeBudget(0);
+    object.SetLocalSpace(innerLsp);
+    auto const& orbit = object.GetOrbitBudgeted();
+    LV_ASSERT(orbit.LocalSpace == object.ParentLsp(), "Budgeted orbit belongs to the object's previous local space!");
+    LV_ASSERT(orbit.StateVersion == object.GetState().Version, "Budgeted orbit is stale after a local space change!");
+
+    Physics::SetContext(nullptr);
+    return true;
+}
+
+
+void TestLayer::Benchmark_OrbitalPrecision(size_t numObjects, size_t numFrames)
+{
+    LV_PROFILE_FUNCTION();
+
+    using Physics = LV::OrbitalPhysics;
+
+    /* Position precision is selected at compile time (LV_ORBITAL_DOUBLE_PRECISION), so compare by running this in a build of each */
+    Physics::Context context;
+    Physics::SetContext(&context);
+    Physics::SetRootSpaceScaling(1e9);
+    Physics::GetRootObjectNode().SetMass(1.99e30);
+
+    /* Dynamic objects in circular orbits: the thrusting half exercises Dynamic integration, and the coasting half should keep
+     * its orbital radius, so its drift measures integration error */
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    std::vector<Physics::ObjectDesc> descs(numObjects);
+    for (auto& desc : descs) {
+        float radius = 0.05f + 0.9f * unit(rng), angle = LV::PI2f * unit(rng);
+        desc.LocalSpace = Physics::GetRootLSpaceNode();
+        desc.Mass = 1e3;
+        desc.Position = { radius * cosf(angle), 0.f, radius * sinf(angle) };
+        desc.CircularOrbit = true;
+        desc.Dynamic = true;
+    }
+    std::vector<Physics::ObjectNode> objects;
+    Physics::CreateMany(descs, objects);
+    for (size_t i = 0; i < objects.size(); i += 2) {
+        objects[i].SetContinuousAcceleration({ 0.0, 0.0, 1e-3 });
+    }
+
+    float updateMillis;
+    {
+        LV_PROFILE_SCOPE("Benchmark_OrbitalPrecision - update");
+        LV::Timer timer;
+        for (size_t frame = 0; frame < numFrames; frame++) {
+            Physics::OnUpdate(1.f / 60.f);
+        }
+        updateMillis = timer.ElapsedMillis();
+    }
+
+    double radiusDrift = 0.0;
+    for (size_t i = 1; i < objects.size(); i += 2) {
+        double radius = sqrt((double)objects[i].LocalPositionFromPrimary().SqrMagnitude());
+        double initialRadius = sqrt((double)descs[i].Position.SqrMagnitude());
+        radiusDrift += abs(radius - initialRadius) / initialRadius;
+    }
+    radiusDrift /= objects.size() / 2;
+
+    Physics::SetContext(nullptr);
+
+    LV_INFO("Benchmark: OrbitalPhysics {0}-precision positions - {1} objects, {2} frames in {3} ms ({4} ms per frame), mean radius drift {5}",
+        Physics::kDoublePrecisionPosition ? "double" : "single", numObjects, numFrames, updateMillis, updateMillis / numFrames, radiusDrift);
+}
+
+
+void TestLayer::Benchmark_SceneGetTree(size_t numEntities, size_t numRuns)
+{
+    LV_PROFILE_FUNCTION();
+
+    /* Each entity is a child of an earlier entity, with a branching factor of 8 */
+    LV::Scene scene;
+    std::vector<LV::Entity> entities;
+    entities.reserve(numEntities);
+    entities.push_back(scene.GetRoot());
+    {
+        LV_PROFILE_SCOPE("Benchmark_SceneGetTree - build hierarchy");
+        for (size_t i = 1; i < numEntities; i++) {
+            entities.push_back(scene.CreateEntityAsChild(entities[(i - 1) / 8]));
+        }
+    }
+
+    std::vector<LV::Entity> tree;
+    tree.reserve(numEntities);
+    float totalMillis = 0.f;
+    for (size_t run = 0; run < numRuns; run++)
+    {
+        LV_PROFILE_SCOPE("Benchmark_SceneGetTree - GetTree");
+        tree.clear();
+        LV::Timer timer;
+        scene.GetTree(scene.GetRoot(), tree);
+        totalMillis += timer.ElapsedMillis();
+    }
+    LV_ASSERT(tree.size() == numEntities - 1, "GetTree did not return the whole hierarchy!");
+
+    LV_INFO("Benchmark: Scene::GetTree() on {0} entities - {1} ms average over {2} runs", numEntities, totalMillis / (float)numRuns, numRuns);
+}
+
+
+void TestLayer::Benchmark_ViewVsGroup(size_t numEntities, size_t numRuns)
+{
+    LV_PROFILE_FUNCTION();
+
+    /* Every entity has a transform, every second entity has a sprite and every third has a circle - so the sprite pool
+     * is interleaved with entities which are not iterated by a transform-sprite view */
+    auto build = [numEntities](entt::registry& registry) {
+        LV_PROFILE_SCOPE("Benchmark_ViewVsGroup - build registry");
+        for (size_t i = 0; i < numEntities; i++) {
+            auto entity = registry.create();
+            registry.emplace<LV::TransformComponent>(entity).SetPosition({ (float)i, 0.f, 0.f });
+            if (i % 2 == 0) registry.emplace<LV::SpriteRendererComponent>(entity);
+            if (i % 3 == 0) registry.emplace<LV::CircleRendererComponent>(entity);
+        }
+    };
+
+    entt::registry viewRegistry, groupRegistry;
+    auto group = groupRegistry.group<LV::SpriteRendererComponent>(entt::get<LV::TransformComponent>);
+    build(viewRegistry);
+    build(groupRegistry);
+
+    float viewMillis = 0.f, groupMillis = 0.f;
+    float viewSum = 0.f, groupSum = 0.f; /* Accumulated so the iteration is not optimized out */
+    size_t viewCount = 0, groupCount = 0;
+    for (size_t run = 0; run < numRuns; run++)
+    {
+        {
+            LV_PROFILE_SCOPE("Benchmark_ViewVsGroup - view");
+            LV::Timer timer;
+            auto view = viewRegistry.view<LV::TransformComponent, LV::SpriteRendererComponent>();
+            for (auto [entity, transform, sprite] : view.each()) {
+                viewSum += transform.GetPosition().x * sprite.Color.x;
+                viewCount++;
+            }
+            viewMillis += timer.ElapsedMillis();
+        }
+        {
+            LV_PROFILE_SCOPE("Benchmark_ViewVsGroup - group");
+            LV::Timer timer;
+            for (auto [entity, sprite, transform] : group.each()) {
+                groupSum += transform.GetPosition().x * sprite.Color.x;
+                groupCount++;
+            }
+            groupMillis += timer.ElapsedMillis();
+        }
+    }
+    LV_ASSERT(viewCount == groupCount, "View and group iterated different entities!");
+
+    LV_INFO("Benchmark: transform-sprite iteration on {0} entities - view {1} ms, group {2} ms average over {3} runs (checksums {4}, {5})",
+        numEntities, viewMillis / (float)numRuns, groupMillis / (float)numRuns, numRuns, viewSum, groupSum);
+}
+
+
+void TestLayer::Benchmark_PrefabInstancing(size_t numInstances)
+{
+    LV_PROFILE_FUNCTION();
+
+    /* Renderer data stored by the scene - essential components are the same for every creation path */
+    auto rendererBytes = [](LV::Scene& scene) {
+        return scene.GetEntitiesByComponents<LV::SpriteRendererComponent>().size() * sizeof(LV::SpriteRendererComponent)
+            + scene.GetEntitiesByComponents<LV::CircleRendererComponent>().size() * sizeof(LV::CircleRendererComponent)
+            + scene.GetEntitiesByComponents<LV::PrefabComponent>().size() * sizeof(LV::PrefabComponent);
+    };
+    auto makeTemplate = [](LV::Scene& scene) {
+        LV::Entity entity = scene.CreateEntity("Ship");
+        entity.AddComponent<LV::SpriteRendererComponent>(LV::Vector4{ 0.8f, 0.8f, 0.9f, 1.f });
+        entity.AddComponent<LV::CircleRendererComponent>();
+        return entity;
+    };
+
+    float duplicateMillis, batchMillis, prefabMillis;
+    size_t duplicateBytes, batchBytes, prefabBytes;
+    {
+        LV_PROFILE_SCOPE("Benchmark_PrefabInstancing - DuplicateEntity");
+        LV::Scene scene;
+        LV::Entity ship = makeTemplate(scene);
+        size_t baseBytes = rendererBytes(scene);
+        LV::Timer timer;
+        for (size_t i = 0; i < numInstances; i++) {
+            scene.DuplicateEntity(ship);
+        }
+        duplicateMillis = timer.ElapsedMillis();
+        duplicateBytes = rendererBytes(scene) - baseBytes;
+    }
+    {
+        LV_PROFILE_SCOPE("Benchmark_PrefabInstancing - CreateEntities");
+        LV::Scene scene;
+        LV::Entity ship = makeTemplate(scene);
+        size_t baseBytes = rendererBytes(scene);
+        LV::Timer timer;
+        scene.CreateEntities(numInstances, ship.GetUUID());
+        batchMillis = timer.ElapsedMillis();
+        batchBytes = rendererBytes(scene) - baseBytes;
+    }
+    {
+        LV_PROFILE_SCOPE("Benchmark_PrefabInstancing - InstantiatePrefab");
+        LV::Scene scene;
+        auto prefab = LV::Prefab::Create(makeTemplate(scene));
+        size_t baseBytes = rendererBytes(scene);
+        LV::Timer timer;
+        scene.InstantiatePrefab(prefab, numInstances);
+        prefabMillis = timer.ElapsedMillis();
+        prefabBytes = rendererBytes(scene) - baseBytes + sizeof(LV::Prefab);
+    }
+
+    LV_INFO("Benchmark: {0} instances - DuplicateEntity {1} ms ({2} renderer bytes/instance), CreateEntities {3} ms ({4} bytes/instance), "
+        "InstantiatePrefab {5} ms ({6} bytes/instance)", numInstances,
+        duplicateMillis, duplicateBytes / (float)numInstances,
+        batchMillis, batchBytes / (float)numInstances,
+        prefabMillis, prefabBytes / (float)numInstances);
+}
+
+
+void TestLayer::Benchmark_EntityLookup(size_t numEntities, size_t numLookups)
+{
+    LV_PROFILE_FUNCTION();
+
+    /* Scripts look up their entity by UUID on every engine call, in no particular order */
+    std::vector<LV::UUID> ids(numEntities);
+    std::vector<LV::UUID> lookups;
+    lookups.reserve(numLookups);
+    for (size_t i = 0; i < numLookups; i++) {
+        lookups.push_back(ids[((uint64_t)LV::UUID() % numEntities)]);
+    }
+
+    std::unordered_map<LV::UUID, entt::entity> stdMap;
+    LV::FlatHashMap<LV::UUID, entt::entity, LV::IdentityHash> flatMap;
+    for (size_t i = 0; i < numEntities; i++) {
+        stdMap.emplace(ids[i], (entt::entity)i);
+        flatMap.emplace(ids[i], (entt::entity)i);
+    }
+
+    uint64_t stdSum = 0, flatSum = 0; /* Accumulated so the lookups are not optimized out */
+    float stdMillis, flatMillis;
+    {
+        LV_PROFILE_SCOPE("Benchmark_EntityLookup - std::unordered_map");
+        LV::Timer timer;
+        for (auto id : lookups) {
+            stdSum += (uint64_t)stdMap.find(id)->second;
+        }
+        stdMillis = timer.ElapsedMillis();
+    }
+    {
+        LV_PROFILE_SCOPE("Benchmark_EntityLookup - FlatHashMap");
+        LV::Timer timer;
+        for (auto id : lookups) {
+            flatSum += (uint64_t)flatMap.find(id)->second;
+        }
+        flatMillis = timer.ElapsedMillis();
+    }
+    LV_ASSERT(stdSum == flatSum, "Maps returned different entities!");
+
+    /* The workload the scene's map serves: entity scripts calling into the engine, where every internal call looks up its entities
+     * by UUID. Each LookupBenchmark script reads and writes its position and tests a reference to a random other entity, per call */
+    static constexpr int32_t kCallsPerUpdate = 16;
+    static constexpr size_t kInternalCallsPerCall = 3;
+    LV::Scene scene;
+    scene.ScriptEngineUseContext();
+    auto entities = scene.CreateEntities(numEntities);
+    for (auto entity : entities)
+    {
+        LV::UUID uuid = entity.GetUUID();
+        auto& sc = entity.AddComponent<LV::ScriptComponent>();
+        if (!sc.SetScript(uuid, "LookupBenchmark")) {
+            LV_ERROR("Benchmark_EntityLookup: could not create the LookupBenchmark script!");
+            return;
+        }
+        auto const& fields = sc.GetScriptInstance(uuid)->GetFields();
+        LV::UUID target = entities[(uint64_t)LV::UUID() % numEntities].GetUUID();
+        int32_t callsPerUpdate = kCallsPerUpdate;
+        fields.at("Target")->SetValue(target);
+        fields.at("CallsPerUpdate")->SetValue(callsPerUpdate);
+    }
+
+    scene.OnStartRuntime();
+    float scriptMillis;
+    {
+        LV_PROFILE_SCOPE("Benchmark_EntityLookup - script internal calls");
+        LV::Timer timer;
+        for (size_t frame = 0; frame < numScriptFrames; frame++) {
+            scene.OnUpdateRuntime(1.f / 60.f);
+        }
+        scriptMillis = timer.ElapsedMillis();
+    }
+    scene.OnStopRuntime();
+    size_t numInternalCalls = numScriptFrames * numEntities * kCallsPerUpdate * kInternalCallsPerCall;
+
+    LV_INFO("Benchmark: {0} UUID lookups among {1} entities - std::unordered_map {2} ms, FlatHashMap {3} ms; "
+        "{4} script internal calls through the scene's map in {5} ms ({6} ns per call)",
+        numLookups, numEntities, stdMillis, flatMillis, numInternalCalls, scriptMillis, 1e6f * scriptMillis / numInternalCalls);
+}
+
+
+void TestLayer::Benchmark_RenderQueue(size_t numPrimitives, size_t numTextures)
+{
+    LV_PROFILE_FUNCTION();
+
+    /* A generated scene mixing every primitive type, opaque and translucent, with more textures than there are texture slots */
+    std::vector<LV::Ref<LV::Texture2D>> textures;
+    for (size_t i = 0; i < numTextures; i++) {
+        textures.push_back(LV::Texture2D::Create(1, 1));
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    struct Primitive
+    {
+        LV::Vector3 Position;
+        LV::Matrix4 Transform;
+        LV::Vector4 Color;
+        size_t Type, Texture;
+    };
+    std::vector<Primitive> primitives(numPrimitives);
+    for (auto& primitive : primitives) {
+        primitive.Position = { 20.f * unit(rng) - 10.f, 20.f * unit(rng) - 10.f, -10.f * unit(rng) };
+        primitive.Transform = glm::translate(glm::mat4(1.f), (glm::vec3)primitive.Position);
+        primitive.Color = { unit(rng), unit(rng), unit(rng), unit(rng) < 0.5f ? 1.f : 0.4f };
+        primitive.Type = (size_t)(unit(rng) * 5.f) % 5;
+        primitive.Texture = (size_t)(unit(rng) * numTextures) % numTextures;
+    }
+
+    LV::Camera camera({ 0.f, 0.f, 10.f }, { 0.f, 0.f, -1.f }, { 0.f, 1.f, 0.f });
+    camera.SetPerspectiveProjection(glm::radians(60.f), 16.f / 9.f, 0.1f, 100.f);
+
+    auto render = [&](bool useQueue, uint32_t& drawCalls) {
+        LV::Renderer2D::SetRenderQueue(useQueue);
+        LV::Renderer2D::ResetStatistics();
+        LV::Timer timer;
+        LV::Renderer2D::BeginScene(camera);
+        for (auto const& primitive : primitives) {
+            switch (primitive.Type)
+            {
+            case 0: LV::Renderer2D::DrawQuad(primitive.Transform, primitive.Color); break;
+            case 1: LV::Renderer2D::DrawQuad(primitive.Transform, textures[primitive.Texture], primitive.Color); break;
+            case 2: LV::Renderer2D::DrawCircle(primitive.Transform, primitive.Color, 0.2f, 0.f); break;
+            case 3: LV::Renderer2D::DrawEllipse(primitive.Transform, 2.f, primitive.Color, 0.1f, 0.f); break;
+            case 4: LV::Renderer2D::DrawLine(primitive.Position, primitive.Position + LV::Vector3{ 1.f, 0.5f, 0.f }, primitive.Color, 0.05f); break;
+            }
+        }
+        LV::Renderer2D::EndScene();
+        drawCalls = LV::Renderer2D::GetStatistics().DrawCalls;
+        return timer.ElapsedMillis();
+    };
+
+    bool wasQueued = LV::Renderer2D::IsRenderQueueEnabled();
+    uint32_t directDrawCalls, queuedDrawCalls;
+    float directMillis, queuedMillis;
+    {
+        LV_PROFILE_SCOPE("Benchmark_RenderQueue - direct batching");
+        directMillis = render(false, directDrawCalls);
+    }
+    {
+        LV_PROFILE_SCOPE("Benchmark_RenderQueue - sorted queue");
+        queuedMillis = render(true, queuedDrawCalls);
+    }
+    LV::Renderer2D::SetRenderQueue(wasQueued);
+    LV::Renderer2D::ResetStatistics();
+
+    LV_INFO("Benchmark: {0} primitives, {1} textures - direct batching {2} draw calls ({3} ms), sorted queue {4} draw calls ({5} ms)",
+        numPrimitives, numTextures, directDrawCalls, directMillis, queuedDrawCalls, queuedMillis);
+}
+
+
+void TestLayer::Benchmark_TextureAtlas(size_t numSprites, size_t numTextures)
+{
+    LV_PROFILE_FUNCTION();
+
+    /* Small sprite images of assorted sizes, each drawn either from its own texture or from the atlas */
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<uint32_t> size(8, 64);
+    std::vector<LV::Ref<LV::Texture2D>> textures;
+    std::vector<LV::Ref<LV::SubTexture2D>> subTextures;
+    LV::TextureAtlas atlas(1024);
+    float packMillis = 0.f;
+    for (size_t i = 0; i < numTextures; i++) {
+        uint32_t width = size(rng), height = size(rng);
+        std::vector<uint32_t> pixels(width * height, (uint32_t)rng() | 0xff000000);
+
+        LV::Ref<LV::Texture2D> texture = LV::Texture2D::Create(width, height);
+        texture->SetData(pixels.data(), 4 * width * height);
+        textures.push_back(texture);
+
+        LV::Timer timer;
+        subTextures.push_back(atlas.Add(pixels.data(), width, height));
+        packMillis += timer.ElapsedMillis();
+    }
+    size_t packedPages = atlas.GetNumPages();
+    float packedOccupancy = atlas.GetOccupancy();
+
+    /* Release half the images and repack the rest in the background */
+    for (size_t i = 0; i < numTextures; i += 2) {
+        atlas.Remove(subTextures[i]);
+    }
+    float repackMillis;
+    {
+        LV_PROFILE_SCOPE("Benchmark_TextureAtlas - repack");
+        LV::Timer timer;
+        atlas.Repack();
+        while (atlas.IsRepacking()) atlas.Update();
+        repackMillis = timer.ElapsedMillis();
+    }
+
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    std::vector<std::pair<LV::Vector3, size_t>> sprites(numSprites);
+    for (auto& [position, texture] : sprites) {
+        position = { 20.f * unit(rng) - 10.f, 20.f * unit(rng) - 10.f, 0.f };
+        texture = 1 + 2 * ((size_t)(unit(rng) * numTextures / 2) % (numTextures / 2));
+    }
+
+    LV::Camera camera({ 0.f, 0.f, 10.f }, { 0.f, 0.f, -1.f }, { 0.f, 1.f, 0.f });
+    camera.SetPerspectiveProjection(glm::radians(60.f), 16.f / 9.f, 0.1f, 100.f);
+
+    auto render = [&](bool useAtlas, uint32_t& drawCalls) {
+        LV::Renderer2D::ResetStatistics();
+        LV::Timer timer;
+        LV::Renderer2D::BeginScene(camera);
+        for (auto const& [position, texture] : sprites) {
+            if (useAtlas) LV::Renderer2D::DrawQuad(position, { 0.5f }, subTextures[texture]);
+            else LV::Renderer2D::DrawQuad(position, { 0.5f }, textures[texture]);
+        }
+        LV::Renderer2D::EndScene();
+        drawCalls = LV::Renderer2D::GetStatistics().DrawCalls;
+        return timer.ElapsedMillis();
+    };
+
+    uint32_t textureDrawCalls, atlasDrawCalls;
+    float textureMillis, atlasMillis;
+    {
+        LV_PROFILE_SCOPE("Benchmark_TextureAtlas - separate textures");
+        textureMillis = render(false, textureDrawCalls);
+    }
+    {
+        LV_PROFILE_SCOPE("Benchmark_TextureAtlas - atlas");
+        atlasMillis = render(true, atlasDrawCalls);
+    }
+    LV::Renderer2D::ResetStatistics();
+
+    LV_INFO("Benchmark: {0} textures packed in {1} ms into {2} pages ({3}% occupied), half repacked in {4} ms into {5} pages ({6}% occupied)",
+        numTextures, packMillis, packedPages, 100.f * packedOccupancy, repackMillis, atlas.GetNumPages(), 100.f * atlas.GetOccupancy());
+    LV_INFO("Benchmark: {0} sprites - separate textures {1} draw calls ({2} ms), atlas {3} draw calls ({4} ms)",
+        numSprites, textureDrawCalls, textureMillis, atlasDrawCalls, atlasMillis);
+}
+
+
+void TestLayer::Benchmark_VertexFormats(size_t numPrimitives, size_t numRuns)
+{
+    LV_PROFILE_FUNCTION();
+
+    /* Bytes per primitive of the full-float formats which the packed formats replaced (vertices * stride, or instance stride) */
+    struct FullFloatSize
+    {
+        uint32_t Batched, Instanced;
+    };
+    constexpr FullFloatSize kQuadSize = { 4 * 52, 0 }; /* quads are never instanced */
+    constexpr FullFloatSize kCircleSize = { 4 * 48, 64 };
+    constexpr FullFloatSize kEllipseSize = { 4 * 72, 96 };
+    constexpr FullFloatSize kLineSize = { 4 * 56, 72 };
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    std::vector<std::pair<LV::Vector3, LV::Vector4>> primitives(numPrimitives);
+    for (auto& [position, color] : primitives) {
+        position = { 20.f * unit(rng) - 10.f, 20.f * unit(rng) - 10.f, -10.f * unit(rng) };
+        color = { unit(rng), unit(rng), unit(rng), 1.f };
+    }
+
+    LV::Camera camera({ 0.f, 0.f, 10.f }, { 0.f, 0.f, -1.f }, { 0.f, 1.f, 0.f });
+    camera.SetPerspectiveProjection(glm::radians(60.f), 16.f / 9.f, 0.1f, 100.f);
+
+    auto render = [&](bool instancing) {
+        LV::Renderer2D::SetInstancing(instancing);
+
+        /* Statistics are per-scene, so accumulate each run's */
+        LV::Renderer2D::Statistics total{};
+        for (size_t run = 0; run < numRuns; run++) {
+            LV::Renderer2D::ResetStatistics();
+            LV::Renderer2D::BeginScene(camera);
+            for (size_t i = 0; i < primitives.size(); i++) {
+                auto const& [position, color] = primitives[i];
+                LV::Matrix4 transform = glm::translate(glm::mat4(1.f), (glm::vec3)position);
+                switch (i % 4)
+                {
+                case 0: LV::Renderer2D::DrawQuad(transform, color); break;
+                case 1: LV::Renderer2D::DrawCircle(transform, color, 0.2f, 0.01f); break;
+                case 2: LV::Renderer2D::DrawEllipse(transform, 2.f, color, 0.1f, 0.01f); break;
+                case 3: LV::Renderer2D::DrawLine(position, position + LV::Vector3{ 1.f, 0.5f, 0.f }, color, 0.05f); break;
+                }
+            }
+            LV::Renderer2D::EndScene();
+
+            auto accumulate = [numRuns](LV::Renderer2D::PrimitiveStatistics& sum, const LV::Renderer2D::PrimitiveStatistics& scene) {
+                sum.Count = scene.Count;
+                sum.Bytes = scene.Bytes;
+                sum.FlushMillis += scene.FlushMillis / numRuns;
+            };
+            auto& stats = LV::Renderer2D::GetStatistics();
+            accumulate(total.Quads, stats.Quads);
+            accumulate(total.Circles, stats.Circles);
+            accumulate(total.Ellipses, stats.Ellipses);
+            accumulate(total.Lines, stats.Lines);
+        }
+        return total;
+    };
+
+    auto report = [](const char* path, const char* name, const LV::Renderer2D::PrimitiveStatistics& stats, uint32_t fullFloatSize) {
+        LV_INFO("Benchmark: {0} {1} {2} - {3} bytes per frame (full-float {4}), flush {5} ms",
+            stats.Count, path, name, stats.Bytes, stats.Count * fullFloatSize, stats.FlushMillis);
+    };
+
+    bool wasInstancing = LV::Renderer2D::IsInstancing();
+    LV::Renderer2D::Statistics batched, instanced;
+    {
+        LV_PROFILE_SCOPE("Benchmark_VertexFormats - batched");
+        batched = render(false);
+    }
+    {
+        LV_PROFILE_SCOPE("Benchmark_VertexFormats - instanced");
+        instanced = render(true);
+    }
+    LV::Renderer2D::SetInstancing(wasInstancing);
+    LV::Renderer2D::ResetStatistics();
+
+    LV_INFO("Benchmark: packed vertex formats, {0} primitives averaged over {1} runs", numPrimitives, numRuns);
+    report("batched", "quads", batched.Quads, kQuadSize.Batched);
+    report("batched", "circles", batched.Circles, kCircleSize.Batched);
+    report("batched", "ellipses", batched.Ellipses, kEllipseSize.Batched);
+    report("batched", "lines", batched.Lines, kLineSize.Batched);
+    report("instanced", "circles", instanced.Circles, kCircleSize.Instanced);
+    report("instanced", "ellipses", instanced.Ellipses, kEllipseSize.Instanced);
+    report("instanced", "lines", instanced.Lines, kLineSize.Instanced);
+}
@@ -18,4 +18,17 @@ public:
 public:
     bool Test_BigFloatComparisonOperators();
     bool Test_BigFloatVsStd();
+    bool Test_OrbitAfterThrustStops();
+    bool Test_LoadedThrustIsDynamic();
+    bool Test_BudgetedOrbitAfterLocalSpaceChange();
+    bool Test_LoadedSiblingOrder();
+
+    void Benchmark_OrbitalPrecision(size_t numObjects = 1000, size_t numFrames = 600);
+    void Benchmark_SceneGetTree(size_t numEntities = 100000, size_t numRuns = 20);
+    void Benchmark_ViewVsGroup(size_t numEntities = 100000, size_t numRuns = 20);
+    void Benchmark_PrefabInstancing(size_t numInstances = 10000);
+    void Benchmark_EntityLookup(size_t numEntities = 100000, size_t numLookups = 2000000, size_t numScriptFrames = 4);
+    void Benchmark_RenderQueue(size_t numPrimitives = 10000, size_t numTextures = 48);
+    void Benchmark_TextureAtlas(size_t numSprites = 10000, size_t numTextures = 256);
+    void Benchmark_VertexFormats(size_t numPrimitives = 40000, size_t numRuns = 20);
 };